@@ -166,6 +166,9 @@ private:
 	
 	ScopedPointer<UndoManager> viewUndoManager;
 
+	/** Keeps the waveform cache alive while HISE is running, so the prefetched pyramids survive closing the sample editor. */
+	SharedResourcePointer<PeakCache> peakCache;
+
 	var editorInformation;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackendProcessor)
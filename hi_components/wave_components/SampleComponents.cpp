@@ -369,7 +369,11 @@ void SamplerSoundWaveform::setSoundToDisplay(const ModulatorSamplerSound *s, int
 				numSamplesInCurrentSample = currentSound->getReferenceToSound()->getSampleLength();
 			}
 
+#if USE_BACKEND
+			preview->setReader(afr.release(), numSamplesInCurrentSample, getPeakCacheKey(sound.get()));
+#else
 			preview->setReader(afr.release(), numSamplesInCurrentSample);
+#endif
 
 			updateRanges();
 		}
@@ -391,6 +395,47 @@ void SamplerSoundWaveform::setSoundToDisplay(const ModulatorSamplerSound *s, int
 
 
 
+void SamplerSoundWaveform::prefetchPeakCache(const ModulatorSampler* sampler)
+{
+	Array<PeakCache::Request> requests;
+
+	ModulatorSampler::SoundIterator iter(sampler);
+
+	while (auto s = iter.getNextSound())
+	{
+		if (s->isMissing() || s->isPurged())
+			continue;
+
+		StreamingSamplerSound::Ptr sound = s->getReferenceToSound(0);
+
+		if (sound == nullptr || sound->getLengthInSamples() < HiseAudioThumbnail::MinNumSamplesForPeakCache)
+			continue;
+
+		PeakCache::Request r;
+
+		r.key = getPeakCacheKey(sound.get());
+		r.createReader = [sound]()
+		{
+			if (sound->isMonolithic())
+				return sound->createReaderForPreview();
+			else
+				return PresetHandler::getReaderForFile(sound->getFileName(true));
+		};
+
+		requests.add(r);
+	}
+
+	peakCache->prefetch(requests);
+}
+
+String SamplerSoundWaveform::getPeakCacheKey(StreamingSamplerSound* sound)
+{
+	if (sound->isMonolithic())
+		return PeakCache::getKeyForMonolith(sound->getMonolithFile(), sound->getMonolithOffset(), sound->getMonolithLength());
+
+	return PeakCache::getKeyForFile(File(sound->getFileName(true)));
+}
+
 float SamplerSoundWaveform::getNormalizedPeak()
 {
 	const ModulatorSamplerSound *s = getCurrentSound();
@@ -108,6 +108,11 @@ public:
 
 	const ModulatorSamplerSound *getCurrentSound() const { return currentSound.get(); }
 
+	/** Calculates the waveform peaks of all samples in the background so that browsing through the samples doesn't have to read them again. */
+	void prefetchPeakCache(const ModulatorSampler* sampler);
+
+	/** Returns the key that identifies the sample in the PeakCache. */
+	static String getPeakCacheKey(StreamingSamplerSound* sound);
 
 	float getNormalizedPeak() override;
 
@@ -121,6 +126,8 @@ private:
 
 	double sampleStartPosition;
 
+	SharedResourcePointer<PeakCache> peakCache;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplerSoundWaveform)
 };
 
@@ -43,10 +43,11 @@
 #elif defined (AUDIOFFT_FFTW3)
   #define AUDIOFFT_FFTW3_USED
   #include <fftw3.h>
+#elif defined (AUDIOFFT_OOURA)
+  #define AUDIOFFT_OOURA_USED
+  #include <vector>
 #else
-  #if !defined(AUDIOFFT_OOURA)
-    #define AUDIOFFT_OOURA
-  #endif
+  #define AUDIOFFT_SIMD_USED
   #define AUDIOFFT_OOURA_USED
   #include <vector>
 #endif
@@ -774,7 +775,9 @@ namespace audiofft
    * @internal
    * @brief Concrete FFT implementation
    */
+#ifndef AUDIOFFT_SIMD_USED
   typedef OouraFFT AudioFFTImplementation;
+#endif
 
 #endif
 #endif // AUDIOFFT_OOURA_USED
@@ -783,6 +786,83 @@ namespace audiofft
   // ================================================================
 
 
+#if defined(AUDIOFFT_SIMD_USED) && !USE_IPP
+
+  /**
+   * @internal
+   * @class SimdAudioFFT
+   * @brief FFT implementation based on the vectorised hise::SimdFFT (define AUDIOFFT_OOURA to use the Ooura FFT instead)
+   *
+   * Sizes below hise::SimdFFT::MinSizeForVectorisation use the Ooura FFT, which is as fast or faster there.
+   */
+  class SimdAudioFFT : public detail::AudioFFTImpl
+  {
+  public:
+    SimdAudioFFT() :
+      detail::AudioFFTImpl(),
+      _size(0)
+    {
+    }
+
+    SimdAudioFFT(const SimdAudioFFT&) = delete;
+    SimdAudioFFT& operator=(const SimdAudioFFT&) = delete;
+
+    virtual void init(size_t size) override
+    {
+      if (_size != size)
+      {
+        assert(size != 1);
+
+        _size = size;
+        _fft = nullptr;
+
+        if (_size < static_cast<size_t>(hise::SimdFFT::MinSizeForVectorisation))
+        {
+          _smallFFT.init(_size);
+        }
+        else
+        {
+          const int order = static_cast<int>(std::log2(static_cast<double>(_size)) + 0.5);
+          _fft = new hise::SimdFFT(hise::SimdFFT::DataType::RealFloat, order + 1, hise::SimdFFT::DivideInverseByN);
+        }
+      }
+    }
+
+    virtual void fft(const float* data, float* re, float* im) override
+    {
+      if (_fft == nullptr)
+        _smallFFT.fft(data, re, im);
+      else
+        _fft->realFFTSplit(data, re, im, static_cast<int>(_size));
+    }
+
+    virtual void ifft(float* data, const float* re, const float* im) override
+    {
+      if (_fft == nullptr)
+        _smallFFT.ifft(data, re, im);
+      else
+        _fft->realFFTInverseSplit(re, im, data, static_cast<int>(_size));
+    }
+
+  private:
+    size_t _size;
+    juce::ScopedPointer<hise::SimdFFT> _fft;
+    OouraFFT _smallFFT;
+  };
+
+
+  /**
+   * @internal
+   * @brief Concrete FFT implementation
+   */
+  typedef SimdAudioFFT AudioFFTImplementation;
+
+#endif // AUDIOFFT_SIMD_USED
+
+
+  // ================================================================
+
+
 #ifdef AUDIOFFT_APPLE_ACCELERATE_USED
 
 
@@ -107,6 +107,11 @@ protected:
   */
   void doBackgroundProcessing();
 
+  /**
+  * @brief Returns the number of samples between two calls to startBackgroundProcessing()
+  */
+  size_t getTailBlockSize() const { return _tailBlockSize; }
+
 private:
   size_t _headBlockSize;
   size_t _tailBlockSize;
@@ -29,20 +29,18 @@ FFTProcessor::FFTProcessor(int fftDataType)
 #if USE_IPP
 	fftData = new hise::IppFFT((hise::IppFFT::DataType)fftDataType);
 #else
-	ignoreUnused(fftDataType);
-	jassertfalse;
+	auto dataType = (hise::SimdFFT::DataType)fftDataType;
+
+	// The SIMD FFT only supports floats, the double FFTs use the Ooura routines
+	if (dataType == hise::SimdFFT::DataType::RealFloat || dataType == hise::SimdFFT::DataType::ComplexFloat)
+		fftData = new hise::SimdFFT(dataType, SIMD_FFT_MAX_POWER_OF_TWO, hise::SimdFFT::DivideInverseByN);
 #endif
 }
 
 
-hise::IppFFT * FFTProcessor::getFFTObject()
+hise::FFTImplementation * FFTProcessor::getFFTObject()
 {
-#if USE_IPP
 	return fftData.get();
-#else
-	jassertfalse;
-	return nullptr;
-#endif
 }
 
 //******************************************************************************
@@ -69,7 +67,10 @@ void FFTProcessor::fft(float* d, int size)
 #endif
 
 #else
-	cdft(2*size, -1, d);
+	if (fftData != nullptr && size >= hise::SimdFFT::MinSizeForVectorisation)
+		fftData->complexFFTInplace(d, size);
+	else
+		cdft(2*size, -1, d);
 #endif
 }
 
@@ -116,6 +117,12 @@ void FFTProcessor::ifft(float* d, int size)
 	}
 #endif
 #else
+	if (fftData != nullptr && size >= hise::SimdFFT::MinSizeForVectorisation)
+	{
+		fftData->complexFFTInverseInplace(d, size);
+		return;
+	}
+
 	cdft(2*size, 1, d);
 	VectorFunctions::mul(d, 1.0f / static_cast<float>(size), 2 * size);
 #endif
@@ -166,6 +173,12 @@ void FFTProcessor::realfft(float* d, int size)
 	}
 #endif
 #else
+	if (fftData != nullptr && size >= hise::SimdFFT::MinSizeForVectorisation)
+	{
+		fftData->realFFTInplace(d, size);
+		return;
+	}
+
 	rdft(size, 1, d);		
 	VectorFunctions::cpxconj(d, size>>1);	// preserve aligned processing if d aligned
 	d[1] = -d[1];			//
@@ -216,6 +229,12 @@ void FFTProcessor::realifft(float* d, int size)
 	}
 #endif
 #else
+	if (fftData != nullptr && size >= hise::SimdFFT::MinSizeForVectorisation)
+	{
+		fftData->realFFTInverseInplace(d, size);
+		return;
+	}
+
 	VectorFunctions::mul(d, 2.0f/static_cast<float>(size), size);
 	VectorFunctions::cpxconj(d, size >> 1);	// preserve aligned processing if d aligned
 	d[1] = -d[1];			//
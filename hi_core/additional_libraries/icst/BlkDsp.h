@@ -23,7 +23,8 @@ public:
 
 	FFTProcessor(int dataType);
 
-	hise::IppFFT *getFFTObject();
+	/** Returns the FFT object or nullptr if the Ooura routines are used for this data type. */
+	hise::FFTImplementation *getFFTObject();
 
 	// Direct FFT functions
 
@@ -57,9 +58,7 @@ public:
 
 private:
 
-#if USE_IPP
-	juce::ScopedPointer<hise::IppFFT> fftData;
-#endif
+	juce::ScopedPointer<hise::FFTImplementation> fftData;
 
 };
 
@@ -221,6 +221,15 @@ If this is set to 1, the application will crash instantly if there is a drop out
 #define ENABLE_SCRIPTING_BREAKPOINTS 0
 #endif
 
+/** Config: HISE_DIFFERENTIAL_PRESET_LOADING
+
+If enabled, a user preset that only changes values of controls connected to module parameters is applied
+without killing the voices. Everything else still uses the full reload.
+*/
+#ifndef HISE_DIFFERENTIAL_PRESET_LOADING
+#define HISE_DIFFERENTIAL_PRESET_LOADING 1
+#endif
+
 /** Config: ENABLE_ALL_PEAK_METERS
 
 Set this to 0 to deactivate peak collection for any other processor than the main synth chain
@@ -0,0 +1,126 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class AudioRenderingThreadPoolUnitTests : public UnitTest
+{
+public:
+
+	AudioRenderingThreadPoolUnitTests() :
+		UnitTest("Testing audio rendering thread pool")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testAllSlotsRenderedOnce();
+		testBackToBackTasks();
+	}
+
+private:
+
+	struct CountingTask : public AudioRenderingThreadPool::Task
+	{
+		CountingTask()
+		{
+			for (auto& c : counters)
+				c.store(0);
+		}
+
+		void renderSlot(int slotIndex) override
+		{
+			counters[slotIndex].fetch_add(1);
+		}
+
+		std::atomic<int> counters[64];
+	};
+
+	void testAllSlotsRenderedOnce()
+	{
+		beginTest("Testing that every slot is rendered exactly once");
+
+		AudioRenderingThreadPool pool(3);
+
+		for (int numSlots = 1; numSlots <= 64; numSlots++)
+		{
+			CountingTask t;
+			pool.process(t, numSlots);
+
+			for (int i = 0; i < 64; i++)
+				expectEquals(t.counters[i].load(), i < numSlots ? 1 : 0, "Slot " + String(i) + " with " + String(numSlots) + " slots");
+		}
+	}
+
+	void testBackToBackTasks()
+	{
+		beginTest("Testing back to back tasks");
+
+		// Late workers from the previous task must not pick up or count a slot of the next task
+		AudioRenderingThreadPool pool(3);
+
+		CountingTask tasks[2];
+		Random r(12345);
+
+		const int numIterations = 100000;
+		int numErrors = 0;
+
+		for (int i = 0; i < numIterations; i++)
+		{
+			auto& t = tasks[i % 2];
+			const int numSlots = r.nextInt({ 2, 9 });
+
+			for (auto& c : t.counters)
+				c.store(0);
+
+			pool.process(t, numSlots);
+
+			for (int s = 0; s < 64; s++)
+			{
+				if (t.counters[s].load() != (s < numSlots ? 1 : 0))
+					numErrors++;
+			}
+		}
+
+		expectEquals(numErrors, 0, "Wrong slot counts");
+	}
+};
+
+static AudioRenderingThreadPoolUnitTests audioRenderingThreadPoolUnitTests;
+
+#endif
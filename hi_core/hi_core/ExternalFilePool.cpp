@@ -546,6 +546,12 @@ juce::Result PoolBase::DataProvider::restorePool(InputStream* ownedInputStream)
 {
 	pool->clearData();
 
+	hashCodes.clear();
+	itemIndexes.clear();
+	poolData = nullptr;
+	poolDataSize = 0;
+	mappedFile = nullptr;
+
 	input = ownedInputStream;
 	int64 metadataSize = input->readInt64();
 
@@ -565,28 +571,66 @@ juce::Result PoolBase::DataProvider::restorePool(InputStream* ownedInputStream)
 	jassert(metadata.getType() == Identifier("PoolData"));
 
 	static const Identifier hc("HashCode");
+	static const Identifier id("ID");
 
-	for (const auto& item : metadata)
+	for (int i = 0; i < metadata.getNumChildren(); i++)
 	{
+		auto item = metadata.getChild(i);
+
 		hashCodes.add(item.getProperty(hc));
+		itemIndexes.set(item.getProperty(id).toString(), i);
 	}
 
 	metadataOffset = input->getPosition();
 
+	// Refer to the item data directly so that it doesn't need to be copied (and can be read from multiple threads)
+	if (auto mis = dynamic_cast<MemoryInputStream*>(input.get()))
+	{
+		poolData = static_cast<const uint8*>(mis->getData()) + metadataOffset;
+		poolDataSize = (int64)mis->getDataSize() - metadataOffset;
+	}
+	else if (auto fis = dynamic_cast<FileInputStream*>(input.get()))
+	{
+		mappedFile = new MemoryMappedFile(fis->getFile(), MemoryMappedFile::readOnly);
+
+		if (mappedFile->getData() != nullptr && (int64)mappedFile->getSize() == fis->getTotalLength())
+		{
+			poolData = static_cast<const uint8*>(mappedFile->getData()) + metadataOffset;
+			poolDataSize = (int64)mappedFile->getSize() - metadataOffset;
+		}
+		else
+		{
+			mappedFile = nullptr;
+		}
+	}
+
 	return Result::ok();
 }
 
+juce::ValueTree PoolBase::DataProvider::getItem(const String& referenceString) const
+{
+	if (itemIndexes.contains(referenceString))
+		return metadata.getChild(itemIndexes[referenceString]);
+
+	return {};
+}
+
 juce::MemoryInputStream* PoolBase::DataProvider::createInputStream(const String& referenceString)
 {
 	if (metadata.isValid())
 	{
-		auto item = metadata.getChildWithProperty("ID", referenceString);
+		auto item = getItem(referenceString);
 
 		if (item.isValid())
 		{
 			auto offset = (int64)item.getProperty("ChunkStart");
 			auto end = (int64)item.getProperty("ChunkEnd");
 
+			if (poolData != nullptr && end <= poolDataSize)
+			{
+				return new MemoryInputStream(poolData + offset, (size_t)(end - offset), false);
+			}
+
 			if (input != nullptr && (input->getTotalLength() > offset + metadataOffset))
 			{
 				input->setPosition(offset + metadataOffset);
@@ -615,6 +659,7 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 	MemoryOutputStream dataOutputStream;
 
 	metadata = ValueTree("PoolData");
+	itemIndexes.clear();
 
 	for (int i = 0; i < pool->getNumLoadedFiles(); i++)
 	{
@@ -650,6 +695,7 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 		dataOutputStream.write(itemData.getData(), itemData.getDataSize());
 		child.setProperty("ChunkEnd", dataOutputStream.getPosition(), nullptr);
 
+		itemIndexes.set(ref.getReferenceString(), metadata.getNumChildren());
 		metadata.addChild(child, -1, nullptr);
 	}
 
@@ -680,7 +726,7 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 
 var PoolBase::DataProvider::createAdditionalData(PoolReference r)
 {
-	auto item = metadata.getChildWithProperty("ID", r.getReferenceString());
+	auto item = getItem(r.getReferenceString());
 
 	if (item.isValid())
 	{
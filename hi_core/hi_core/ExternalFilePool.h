@@ -35,6 +35,14 @@
 
 namespace hise { using namespace juce;
 
+/** Set this to 1 to decode all embedded images on multiple threads when a compiled plugin is loaded.
+*
+*	By default, the embedded items are decoded when they are used for the first time.
+*/
+#ifndef HISE_DECODE_EMBEDDED_IMAGES_IN_PARALLEL
+#define HISE_DECODE_EMBEDDED_IMAGES_IN_PARALLEL 0
+#endif
+
 namespace MetadataIDs
 {
 const Identifier SampleRate("SampleRate");
@@ -302,6 +310,11 @@ public:
 
 		PoolReference getEmbeddedReference(PoolReference other);
 
+		/** Reads the metadata of the pool data. 
+		*
+		*	The items are not decoded here, but when they are requested. If the stream is a MemoryInputStream or a
+		*	FileInputStream (which will be memory mapped), the items are read directly from the memory without copying.
+		*/
 		virtual Result restorePool(InputStream* ownedInputStream);
 
 		MemoryInputStream* createInputStream(const String& referenceString);
@@ -316,8 +329,13 @@ public:
 
 		Array<PoolReference> getListOfAllEmbeddedReferences() const;
 
+		/** Returns true if the item data can be read from multiple threads (which is the case if it's mapped into memory). */
+		bool canDecodeInParallel() const noexcept { return poolData != nullptr; }
+
 	private:
 
+		ValueTree getItem(const String& referenceString) const;
+
 		ValueTree metadata;
 		int64 metadataOffset;
 
@@ -325,6 +343,12 @@ public:
 		ScopedPointer<InputStream> input;
 		Array<int64> hashCodes;
 
+		HashMap<String, int> itemIndexes;
+
+		ScopedPointer<MemoryMappedFile> mappedFile;
+		const uint8* poolData = nullptr;
+		int64 poolDataSize = 0;
+
 		ScopedPointer<Compressor> compressor;
 	};
 
@@ -527,35 +551,31 @@ public:
 		ignoreUnused(unused);
 	}
 
-	bool contains(int64 hashCode)
+	bool contains(int64 hashCode) const
 	{
-		for (const auto& i : sharedItems)
-		{
-			if (i->ref.getHashCode() == hashCode)
-				return true;
-		}
-
-		return false;
+		ScopedLock sl(lock);
+		return sharedItems.contains(hashCode);
 	}
 
-	PoolEntry<DataType>* getSharedData(int64 hashCode)
+	/** Returns the shared entry with the given hash code or nullptr if it wasn't stored yet. */
+	PoolEntry<DataType>* getSharedData(int64 hashCode) const
 	{
-		for (const auto& i: sharedItems)
-		{
-			if (i->ref.getHashCode() == hashCode)
-				return i;
-		}
-
-		jassertfalse;
-		return {};
+		ScopedLock sl(lock);
+		return sharedItems[hashCode].get();
 	}
 
-	void store(PoolEntry<DataType>* newEntry)
+	/** Stores the entry and returns it. If another instance stored an entry with the same hash code in the meantime, it returns this one instead. */
+	PoolEntry<DataType>* store(PoolEntry<DataType>* newEntry)
 	{
-		if (contains(newEntry->ref.getHashCode()))
-			return;
+		const auto hashCode = newEntry->ref.getHashCode();
+
+		ScopedLock sl(lock);
 
-		sharedItems.add(newEntry);
+		if (auto existingEntry = sharedItems[hashCode].get())
+			return existingEntry;
+
+		sharedItems.set(hashCode, newEntry);
+		return newEntry;
 	}
 
 	~SharedCache()
@@ -567,7 +587,8 @@ public:
 
 private:
 
-	ReferenceCountedArray<PoolEntry<DataType>> sharedItems;
+	CriticalSection lock;
+	HashMap<int64, ReferenceCountedObjectPtr<PoolEntry<DataType>>> sharedItems;
 };
 
 
@@ -820,12 +841,19 @@ public:
 		return {};
 	}
 
-	void loadAllFilesFromDataProvider()
+	/** Loads all embedded items. 
+	*
+	*	If decodeInParallel is true and the data provider allows it, the items will be decoded on multiple threads first.
+	*/
+	void loadAllFilesFromDataProvider(bool decodeInParallel=false)
 	{
 		ScopedNotificationDelayer snd(*this, EventType::Added);
 
 		auto refList = getDataProvider()->getListOfAllEmbeddedReferences();
 
+		if (decodeInParallel && getDataProvider()->canDecodeInParallel())
+			decodeEmbeddedItemsInParallel(refList);
+
 		for (auto r : refList)
 			loadFromReference(r, PoolHelpers::LoadAndCacheStrong);
 	}
@@ -941,9 +969,10 @@ public:
 		if (getDataProvider()->isEmbeddedResource(r))
 			r = getDataProvider()->getEmbeddedReference(r);
 
-		if (useSharedCache && sharedCache->contains(r.getHashCode()))
+		if (useSharedCache)
 		{
-			return ManagedPtr(this, sharedCache->getSharedData(r.getHashCode()), true);
+			if (auto sharedEntry = sharedCache->getSharedData(r.getHashCode()))
+				return ManagedPtr(this, sharedEntry, true);
 		}
 
 		if (PoolHelpers::shouldSearchInPool(loadingType))
@@ -1004,7 +1033,7 @@ public:
 
 				if (useSharedCache)
 				{
-					sharedCache->store(ne);
+					ne = sharedCache->store(ne);
 				}
 				else
 				{
@@ -1035,7 +1064,7 @@ public:
 
 				if (useSharedCache)
 				{
-					sharedCache->store(ne);
+					ne = sharedCache->store(ne);
 				}
 				else
 				{
@@ -1061,6 +1090,73 @@ public:
 
 private:
 
+	/** Decodes the embedded items that are not loaded yet on multiple threads and adds them to the pool. */
+	void decodeEmbeddedItemsInParallel(const Array<PoolReference>& refList)
+	{
+		ReferenceCountedArray<PoolItem> decodedItems;
+
+		for (auto r : refList)
+		{
+			const bool isLoaded = useSharedCache ? sharedCache->contains(r.getHashCode()) : contains(r.getHashCode());
+
+			if (!isLoaded)
+				decodedItems.add(new PoolItem(r));
+		}
+
+		if (decodedItems.isEmpty())
+			return;
+
+		auto dp = getDataProvider();
+		std::atomic<int> nextIndex(0);
+
+		auto decodeItems = [&]()
+		{
+			for (int i = nextIndex++; i < decodedItems.size(); i = nextIndex++)
+			{
+				auto item = decodedItems.getUnchecked(i);
+
+				if (auto mis = dp->createInputStream(item->ref.getReferenceString()))
+					dp->getCompressor()->create(mis, &item->data);
+			}
+		};
+
+		const int numThreads = jmin<int>(SystemStats::getNumCpus(), decodedItems.size()) - 1;
+
+		if (numThreads > 0)
+		{
+			ThreadPool threadPool(numThreads);
+
+			for (int i = 0; i < numThreads; i++)
+				threadPool.addJob(decodeItems);
+
+			// The calling thread decodes too, so the jobs that haven't started yet have nothing left to do
+			decodeItems();
+			threadPool.removeAllJobs(false, -1);
+		}
+		else
+		{
+			decodeItems();
+		}
+
+		for (auto item : decodedItems)
+		{
+			if (!PoolHelpers::isValid(&item->data))
+				continue;
+
+			item->additionalData = dp->createAdditionalData(item->ref);
+
+			if (useSharedCache)
+			{
+				sharedCache->store(item);
+			}
+			else
+			{
+				weakPool.add(ManagedPtr(this, item, false));
+				refCountedPool.add(ManagedPtr(this, item, true));
+			}
+		}
+	}
+
 	SharedResourcePointer<SharedCache<DataType>> sharedCache;
 
 	DataType empty;
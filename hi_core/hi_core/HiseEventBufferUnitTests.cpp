@@ -56,6 +56,8 @@ public:
 		testProperties();
 		testPitchWheel();
 		testEventBuffer();
+		testEventBufferInsertOrder();
+		testEventBufferOverflow();
 		testFadeEvent();
 		testEventBufferCopyMethods();
 		testMidiBufferCopyMethods();
@@ -379,6 +381,71 @@ private:
 
 	}
 
+	void testEventBufferInsertOrder()
+	{
+		beginTest("Testing HiseEventBuffer insert order");
+
+		HiseEventBuffer b;
+
+		const int numToFill = r.nextInt(Range<int>(1, HISE_EVENT_BUFFER_SIZE));
+
+		for (int i = 0; i < numToFill; i++)
+		{
+			HiseEvent e(HiseEvent::Type::NoteOn, (uint8)(i % 128), 64, 1);
+
+			e.setTimeStamp((uint16)r.nextInt(16));
+			e.setEventId((uint16)i);
+
+			b.addEvent(e);
+		}
+
+		expectEquals<int>(b.getNumUsed(), numToFill, "All events added");
+		expect(b.timeStampsAreSorted(), "Sorted timestamps");
+
+		const HiseEvent* previous = nullptr;
+
+		for (const auto& e : b)
+		{
+			if (previous != nullptr && previous->getTimeStamp() == e.getTimeStamp())
+				expect(previous->getEventId() < e.getEventId(), "Events with the same timestamp keep their order");
+
+			previous = &e;
+		}
+	}
+
+	void testEventBufferOverflow()
+	{
+		beginTest("Testing HiseEventBuffer overflow");
+
+		HiseEventBuffer b;
+
+		const int numToFill = HISE_EVENT_BUFFER_SIZE * 3 + r.nextInt(100);
+
+		for (int i = 0; i < numToFill; i++)
+			b.addEvent(generateRandomHiseEvent());
+
+		expectEquals<int>(b.getNumUsed(), numToFill, "No events dropped");
+		expect(b.getNumAllocated() >= numToFill, "Storage grows");
+		expect(b.timeStampsAreSorted(), "Sorted timestamps after growing");
+
+		HiseEventBuffer copy;
+		copy.copyFrom(b);
+
+		expect(copy == b, "Copying a grown buffer");
+
+		HiseEventBuffer lower;
+
+		b.moveEventsBelow(lower, 512);
+
+		expectEquals<int>(lower.getNumUsed() + b.getNumUsed(), numToFill, "Moving events of a grown buffer");
+		expect(lower.timeStampsAreSorted() && b.timeStampsAreSorted(), "Sorted timestamps after moving");
+
+		b.clear();
+
+		expect(b.isEmpty(), "Clearing a grown buffer");
+		expect(b.getNumAllocated() >= numToFill, "Clearing keeps the storage");
+	}
+
 	void testFadeEvent()
 	{
 		beginTest("Testing Fade events");
@@ -563,6 +563,13 @@ void MainController::KillStateHandler::initAudioThreadId()
 		{
 			currentState = State::Clear;
 		}
+
+		// The audio worker threads render parts of the audio callback, so they count as audio threads
+		if (auto pool = mc->getAudioRenderingThreadPool())
+		{
+			for (auto id : pool->getThreadIds())
+				audioThreads.addIfNotAlreadyThere(id);
+		}
 		
 		init = true;
 
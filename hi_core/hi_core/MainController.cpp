@@ -97,6 +97,17 @@ MainController::MainController() :
 	globalVariableObject = new DynamicObject();
 
 	hostInfo = new DynamicObject();
+
+	int numAudioWorkerThreads = HISE_NUM_AUDIO_WORKER_THREADS;
+
+#if HI_RUN_UNIT_TESTS
+	// The parallel rendering tests need worker threads even if the build doesn't use them
+	if (unitTestMode)
+		numAudioWorkerThreads = jmax(numAudioWorkerThreads, 2);
+#endif
+
+	if (numAudioWorkerThreads > 0)
+		audioRenderingThreadPool = new AudioRenderingThreadPool(numAudioWorkerThreads);
     
 };
 
@@ -116,6 +127,7 @@ MainController::~MainController()
 
 	sampleManager = nullptr;
 	javascriptThreadPool = nullptr;
+	audioRenderingThreadPool = nullptr;
 }
 
 
@@ -164,6 +164,9 @@ public:
 		/** returns a pointer to the thread pool that streams the samples from disk. */
 		SampleThreadPool *getGlobalSampleThreadPool() { return samplerLoaderThreadPool; }
 
+		/** returns the threads that help the sample loading thread with preloading (nullptr if HISE_NUM_PRELOAD_THREADS is 1). */
+		ThreadPool* getPreloadThreadPool() { return preloadThreadPool; }
+
 		/** returns a pointer to the global sample pool */
 		ModulatorSamplerSoundPool *getModulatorSamplerSoundPool() const { return globalSamplerSoundPool; }
 
@@ -300,6 +303,7 @@ public:
 
 		ScopedPointer<ModulatorSamplerSoundPool> globalSamplerSoundPool;
 		ScopedPointer<SampleThreadPool> samplerLoaderThreadPool;
+		ScopedPointer<ThreadPool> preloadThreadPool;
 
 		bool hddMode = false;
 		bool skipPreloading = false;
@@ -611,6 +615,12 @@ public:
 
 		TagDataBase& getTagDataBase() const	{ return tagDataBase.get();}
 
+		/** Returns the time in milliseconds between the last loadUserPreset() call and the moment the new values were applied. */
+		double getLastPresetLoadingTime() const noexcept { return lastPresetLoadingTime.load(); }
+
+		/** Returns true if the last preset only changed module parameters and was applied without reloading. */
+		bool wasLastPresetAppliedDifferentially() const noexcept { return lastPresetWasDifferential; }
+
 	private:
 
 		SharedResourcePointer<TagDataBase> tagDataBase;
@@ -618,11 +628,22 @@ public:
 		void loadUserPresetInternal();
 		void saveUserPresetInternal(const String& name=String());
 
+		/** Compares the preset with the current control values and applies it without killing the voices if
+		*	only values connected to module parameters differ. Returns false if the preset needs the full reload.
+		*/
+		bool applyPresetDifferentially(const ValueTree& v);
+
+		void sendPresetChangeMessage();
+
 		Array<WeakReference<Listener>, CriticalSection> listeners;
 
 		File currentlyLoadedFile;
 		ValueTree pendingPreset;
 
+		double presetLoadStartTime = 0.0;
+		std::atomic<double> lastPresetLoadingTime { 0.0 };
+		bool lastPresetWasDifferential = false;
+
 		MainController* mc;
 
 		JUCE_DECLARE_WEAK_REFERENCEABLE(UserPresetHandler);
@@ -1030,6 +1051,18 @@ public:
 	JavascriptThreadPool& getJavascriptThreadPool() noexcept { return *javascriptThreadPool.get(); }
 	const JavascriptThreadPool& getJavascriptThreadPool() const noexcept { return *javascriptThreadPool.get(); }
 
+	/** Returns the worker thread pool for the audio rendering or nullptr if HISE_NUM_AUDIO_WORKER_THREADS is zero. */
+	AudioRenderingThreadPool* getAudioRenderingThreadPool() noexcept { return audioRenderingThreadPool.get(); }
+
+	/** Returns a number that changes whenever a processor is added to or removed from the module tree. 
+	*
+	*	Use this on the audio thread to update data that is derived from the module tree.
+	*/
+	uint32 getModuleTreeVersion() const noexcept { return moduleTreeVersion.load(); }
+
+	/** This is called when a processor is added to a chain (before and after the insertion) and by the Processor destructor. */
+	void moduleTreeChanged() noexcept { ++moduleTreeVersion; }
+
 	PooledUIUpdater* getGlobalUIUpdater() { return &globalUIUpdater; }
 	const PooledUIUpdater* getGlobalUIUpdater() const { return &globalUIUpdater; }
 
@@ -1405,6 +1438,10 @@ private:
 
 	ScopedPointer<JavascriptThreadPool> javascriptThreadPool;
 
+	ScopedPointer<AudioRenderingThreadPool> audioRenderingThreadPool;
+
+	std::atomic<uint32> moduleTreeVersion = { 0 };
+
 	friend class UserPresetHandler;
     friend class PresetLoadingThread;
 	friend class DelayedRenderer;
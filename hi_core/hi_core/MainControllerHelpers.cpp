@@ -860,6 +860,155 @@ public:
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Pimpl)
 };
 
+class AudioRenderingThreadPool::Worker : public Thread
+{
+public:
+
+	Worker(AudioRenderingThreadPool& parent_, int index) :
+		Thread("Audio Worker " + String(index + 1)),
+		parent(parent_)
+	{
+		startThread(10);
+	}
+
+	~Worker()
+	{
+		stopThread(1000);
+	}
+
+	void run() override
+	{
+		while (!threadShouldExit())
+		{
+			while (parent.renderNextSlot(true))
+				;
+
+			wait(100);
+		}
+	}
+
+private:
+
+	AudioRenderingThreadPool& parent;
+};
+
+AudioRenderingThreadPool::AudioRenderingThreadPool(int numWorkerThreads)
+{
+	for (int i = 0; i < numWorkerThreads; i++)
+		workers.add(new Worker(*this, i));
+}
+
+AudioRenderingThreadPool::~AudioRenderingThreadPool()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	workers.clear();
+}
+
+Array<Thread::ThreadID> AudioRenderingThreadPool::getThreadIds() const
+{
+	Array<Thread::ThreadID> ids;
+
+	for (auto w : workers)
+		ids.add(w->getThreadId());
+
+	return ids;
+}
+
+void AudioRenderingThreadPool::process(Task& t, int numSlots)
+{
+	if (numSlots <= 0)
+		return;
+
+	bool expected = false;
+
+	if (numSlots == 1 || numSlots > MaxNumSlots || workers.isEmpty() || !busy.compare_exchange_strong(expected, true))
+	{
+		for (int i = 0; i < numSlots; i++)
+			t.renderSlot(i);
+
+		return;
+	}
+
+	if (numSerialCallsLeft > 0)
+	{
+		numSerialCallsLeft--;
+
+		for (int i = 0; i < numSlots; i++)
+			t.renderSlot(i);
+
+		busy.store(false);
+		return;
+	}
+
+	currentTask.store(&t);
+	numSlotsFinished.store(0);
+	lastSlotFinished.reset();
+
+	// This publishes the task to the workers
+	slotState.store(createSlotState(++generation, numSlots, 0));
+
+	for (int i = 0; i < jmin(numSlots - 1, workers.size()); i++)
+		workers.getUnchecked(i)->notify();
+
+	while (renderNextSlot(false))
+		;
+
+	// Every slot is picked up at this point, so we only need to wait for the workers that are still busy
+	if (waitForWorkers(numSlots) > MaxWaitMilliseconds)
+		numSerialCallsLeft = NumSerialCallsAfterStall;
+
+	slotState.store(createSlotState(generation, 0, 0));
+	busy.store(false);
+}
+
+double AudioRenderingThreadPool::waitForWorkers(int numSlots)
+{
+	if (numSlotsFinished.load() == numSlots)
+		return 0.0;
+
+	const int64 start = Time::getHighResolutionTicks();
+	const int64 maxSpinTicks = Time::secondsToHighResolutionTicks(MaxSpinMilliseconds * 0.001);
+
+	while (numSlotsFinished.load() != numSlots)
+	{
+		if (Time::getHighResolutionTicks() - start > maxSpinTicks)
+		{
+			// The worker might be waiting for this core, so stop spinning. The loop
+			// checks the counter again, so a stale signal of the last task is harmless.
+			lastSlotFinished.wait(1);
+		}
+	}
+
+	return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0;
+}
+
+bool AudioRenderingThreadPool::renderNextSlot(bool isWorker)
+{
+	uint64 state = slotState.load();
+	int slotIndex;
+
+	do
+	{
+		slotIndex = (int)(state & 0xFFFF);
+
+		if (slotIndex >= (int)((state >> 16) & 0xFFFF))
+			return false;
+	}
+	while (!slotState.compare_exchange_weak(state, state + 1));
+
+	// The task can't finish before this slot is counted, so the task pointer belongs to the generation of the slot
+	currentTask.load()->renderSlot(slotIndex);
+
+	const int numSlots = (int)((state >> 16) & 0xFFFF);
+
+	if (++numSlotsFinished == numSlots && isWorker)
+		lastSlotFinished.signal();
+
+	return true;
+}
+
 DelayedRenderer::DelayedRenderer(MainController* mc_) :
 	pimpl(new Pimpl()),
 	mc(mc_)
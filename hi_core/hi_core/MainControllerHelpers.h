@@ -435,6 +435,107 @@ private:
 };
 
 
+/** The number of worker threads that are used to spread the audio rendering across multiple cores.
+*
+*	If this is zero, everything will be rendered on the audio thread. 
+*/
+#ifndef HISE_NUM_AUDIO_WORKER_THREADS
+#define HISE_NUM_AUDIO_WORKER_THREADS 0
+#endif
+
+/** A pool of high priority threads that can be used to split up the audio rendering into multiple tasks.
+*
+*	The audio thread calls process() with a Task and the amount of slots, and the slots will be 
+*	rendered by the worker threads as well as the audio thread itself. The audio thread never waits for 
+*	a worker that hasn't picked up a slot yet (it will just render it itself), it only waits for the slots
+*	that are currently rendered by a worker.
+*
+*	A slot that a worker has started can't be taken away from it, so if a worker gets descheduled in the
+*	middle of a slot, the audio thread has to wait for it. It spins for a short time and then sleeps until the
+*	worker signals the last slot, so it doesn't steal the CPU from the worker it is waiting for. If a wait 
+*	takes longer than MaxWaitMilliseconds, the pool renders the next NumSerialCallsAfterStall tasks on the 
+*	calling thread, so a system that can't schedule the workers in time falls back to the serial rendering.
+*
+*	The slots must not depend on each other, so every slot has to write into its own data.
+*/
+class AudioRenderingThreadPool
+{
+public:
+
+	/** A task that can be split up into independent slots. */
+	struct Task
+	{
+		virtual ~Task() {};
+
+		/** Renders the given slot. This will be called from the audio thread or one of the worker threads. */
+		virtual void renderSlot(int slotIndex) = 0;
+	};
+
+	AudioRenderingThreadPool(int numWorkerThreads);
+
+	~AudioRenderingThreadPool();
+
+	/** Returns the number of worker threads (not including the audio thread). */
+	int getNumWorkerThreads() const noexcept { return workers.size(); }
+
+	/** Returns the thread IDs of the worker threads. */
+	Array<Thread::ThreadID> getThreadIds() const;
+
+	/** Calls Task::renderSlot() for every slot and returns when all slots are rendered. 
+	*
+	*	If the pool is already busy (eg. because a slot of another task calls this method), 
+	*	the slots will be rendered on the calling thread.
+	*/
+	void process(Task& t, int numSlots);
+
+	/** The maximum number of slots that can be spread across the worker threads. Tasks with more slots are rendered serially. */
+	static constexpr int MaxNumSlots = 0xFFFF;
+
+	/** The time that the audio thread busy-waits for the workers before it sleeps until they are done. */
+	static constexpr double MaxSpinMilliseconds = 0.05;
+
+	/** If the audio thread had to wait longer than this for a worker, the next tasks will be rendered serially. */
+	static constexpr double MaxWaitMilliseconds = 1.0;
+
+	/** The number of process() calls that are rendered serially after a worker stalled the audio thread. */
+	static constexpr int NumSerialCallsAfterStall = 1024;
+
+private:
+
+	class Worker;
+
+	/** Picks the next slot and renders it. Returns false if there was no slot left. 
+	*
+	*	If a worker renders the last slot of a task, it signals the audio thread.
+	*/
+	bool renderNextSlot(bool isWorker);
+
+	/** Waits until all slots that were picked up by the workers are finished. Returns the waiting time in milliseconds. */
+	double waitForWorkers(int numSlots);
+
+	/** Packs the task generation (upper 32 bits), the number of slots and the next slot index (16 bits each) into one word.
+	*
+	*	A worker only owns a slot if its compare-exchange succeeds, so a worker that is late for a task that has
+	*	already finished can't pick up (and count) a slot of the next task.
+	*/
+	static uint64 createSlotState(uint32 generation, int numSlots, int nextSlot) noexcept
+	{
+		return ((uint64)generation << 32) | ((uint64)numSlots << 16) | (uint64)nextSlot;
+	}
+
+	std::atomic<Task*> currentTask = { nullptr };
+	std::atomic<uint64> slotState = { 0 };
+	std::atomic<int> numSlotsFinished = { 0 };
+	uint32 generation = 0;
+	std::atomic<bool> busy = { false };
+
+	WaitableEvent lastSlotFinished;
+	int numSerialCallsLeft = 0;
+
+	OwnedArray<Worker> workers;
+
+	JUCE_DECLARE_NON_COPYABLE(AudioRenderingThreadPool);
+};
 
 /** This introduces an artificial delay of max 256 samples and calls the internal processing loop with a fixed number of samples.
 *
@@ -528,6 +528,74 @@ void MouseCallbackComponent::sendToListeners(var clickInformation)
 	}
 }
 
+void DrawActions::Handler::flush()
+{
+	auto changedArea = getChangedArea();
+
+	nextActions.swapWith(currentActions);
+	currentActions.clear();
+
+	if (changedArea.isEmpty())
+		return;
+
+	{
+		SpinLock::ScopedLockType sl(dirtyAreaLock);
+		pendingDirtyArea = pendingDirtyArea.getUnion(changedArea);
+	}
+
+	triggerAsyncUpdate();
+}
+
+Rectangle<int> DrawActions::Handler::getChangedArea() const
+{
+	// At this point currentActions contains the new list and nextActions the last one
+	const int numActions = jmax(currentActions.size(), nextActions.size());
+
+	bool hasCachedImageAction = false;
+
+	for (auto a : currentActions)
+		hasCachedImageAction |= a->wantsCachedImage();
+
+	Rectangle<float> changedArea;
+	bool coordinatesChanged = false;
+
+	for (int i = 0; i < numActions; i++)
+	{
+		auto newAction = currentActions[i];
+		auto oldAction = nextActions[i];
+
+		if (newAction != nullptr && oldAction != nullptr && newAction->isEquivalent(oldAction.get()))
+		{
+			coordinatesChanged |= newAction->changesCoordinates();
+			continue;
+		}
+
+		// The areas are stored in component coordinates so everything after a transform
+		// or an action that works on the whole image must be repainted completely.
+		if (coordinatesChanged || hasCachedImageAction)
+			return getFullRepaintArea();
+
+		for (auto a : { newAction.get(), oldAction.get() })
+		{
+			if (a == nullptr)
+				continue;
+
+			auto area = a->getDirtyArea();
+
+			if (area.isEmpty() || a->changesCoordinates() || a->wantsCachedImage())
+				return getFullRepaintArea();
+
+			changedArea = changedArea.getUnion(area);
+		}
+	}
+
+	if (changedArea.isEmpty())
+		return {};
+
+	// Add a pixel for the antialiased edges
+	return changedArea.expanded(1.0f).getSmallestIntegerContainer();
+}
+
 BorderPanel::BorderPanel(DrawActions::Handler* handler_) :
 borderColour(Colours::black),
 drawHandler(handler_),
@@ -616,11 +684,69 @@ void BorderPanel::changeListenerCallback(SafeChangeBroadcaster* )
 {
 }
 
-void BorderPanel::paint(Graphics &g)
+void BorderPanel::newPaintActionsAvailable(Rectangle<int> dirtyArea)
 {
-	
+	auto area = dirtyArea.getIntersection(getLocalBounds());
 
-	
+	if (area.isEmpty())
+		return;
+
+	invalidLayerArea = invalidLayerArea.getUnion(area);
+	repaint(area);
+}
+
+void BorderPanel::renderDrawActionsToLayer(float scaleFactor)
+{
+	DrawActions::Handler::Iterator it(drawHandler.get());
+
+	const bool useCachedImage = it.wantsCachedImage();
+
+	// The actions that need the cached image expect it to have the component size
+	if (useCachedImage)
+		scaleFactor = 1.0f;
+
+	const int w = roundToInt((float)getWidth() * scaleFactor);
+	const int h = roundToInt((float)getHeight() * scaleFactor);
+
+	if (w <= 0 || h <= 0)
+	{
+		cachedLayer = Image();
+		return;
+	}
+
+	if (cachedLayer.getWidth() != w || cachedLayer.getHeight() != h)
+	{
+		cachedLayer = Image(Image::ARGB, w, h, true);
+		invalidLayerArea = getLocalBounds();
+	}
+
+	if (invalidLayerArea.isEmpty())
+		return;
+
+	auto pixelArea = (invalidLayerArea.toFloat() * scaleFactor).getSmallestIntegerContainer().getIntersection(cachedLayer.getBounds());
+
+	invalidLayerArea = {};
+
+	if (pixelArea.isEmpty())
+		return;
+
+	cachedLayer.clear(pixelArea);
+
+	Graphics g2(cachedLayer);
+	g2.reduceClipRegion(pixelArea);
+	g2.addTransform(AffineTransform::scale(scaleFactor));
+
+	while (auto action = it.getNextAction())
+	{
+		if (useCachedImage)
+			action->setCachedImage(cachedLayer);
+
+		action->perform(g2);
+	}
+}
+
+void BorderPanel::paint(Graphics &g)
+{
 	if (isUsingCustomImage)
 	{
         SET_IMAGE_RESAMPLING_QUALITY();
@@ -628,28 +754,17 @@ void BorderPanel::paint(Graphics &g)
 		if (isOpaque())
 			g.fillAll(Colours::black);
 
-		DrawActions::Handler::Iterator it(drawHandler.get());
+		// Only the region that was invalidated by a changed draw list is rendered again,
+		// every other repaint just draws the cached layer.
+		const float scaleFactor = jmax(1.0f, g.getInternalContext().getPhysicalPixelScaleFactor());
 
-		if (it.wantsCachedImage())
-		{
-			Image cachedImg = Image(Image::ARGB, getWidth(), getHeight(), true);
-			Graphics g2(cachedImg);
+		renderDrawActionsToLayer(scaleFactor);
 
-			while (auto action = it.getNextAction())
-			{
-				action->setCachedImage(cachedImg);
-				action->perform(g2);
-			}
-
-			g.drawImageAt(cachedImg, 0, 0);
-		}
-		else
+		if (cachedLayer.isValid())
 		{
-			while (auto action = it.getNextAction())
-				action->perform(g);
+			const float layerScale = (float)cachedLayer.getWidth() / (float)getWidth();
+			g.drawImageTransformed(cachedLayer, AffineTransform::scale(1.0f / layerScale));
 		}
-
-		
 	}
 	else
 	{
@@ -239,6 +239,24 @@ struct DrawActions
 		virtual void perform(Graphics& g) = 0;
 		virtual bool wantsCachedImage() const { return false; };
 
+		/** Returns true if this action will draw exactly the same as the other action.
+		*
+		*	This is used to compare successive draw lists so that an unchanged panel
+		*	doesn't get repainted. The default returns false which is always safe.
+		*/
+		virtual bool isEquivalent(const ActionBase* /*other*/) const { return false; }
+
+		/** Returns the area this action draws into.
+		*
+		*	If it returns an empty rectangle, the action either affects the whole component
+		*	or changes the graphics state for all subsequent actions, so a change will cause
+		*	a full repaint.
+		*/
+		virtual Rectangle<float> getDirtyArea() const { return {}; }
+
+		/** Return true if this action changes the coordinate system for all subsequent actions. */
+		virtual bool changesCoordinates() const { return false; }
+
 		void setCachedImage(Image& img) { cachedImage = img; }
 
 	protected:
@@ -285,7 +303,11 @@ struct DrawActions
 		struct Listener
 		{
 			virtual ~Listener() {};
-			virtual void newPaintActionsAvailable() = 0;
+
+			/** Called when the draw list has changed. The area contains the region
+			*	that needs to be repainted (in component coordinates).
+			*/
+			virtual void newPaintActionsAvailable(Rectangle<int> dirtyArea) = 0;
 
 			JUCE_DECLARE_WEAK_REFERENCEABLE(Listener);
 		};
@@ -300,12 +322,15 @@ struct DrawActions
 			currentActions.add(newDrawAction);
 		}
 
-		void flush()
-		{
-			nextActions.swapWith(currentActions);
-			currentActions.clear();
-			triggerAsyncUpdate();
-		}
+		/** Swaps the recorded actions with the last list and notifies the listeners.
+		*
+		*	If the new list draws exactly the same as the last one, it will not cause a
+		*	repaint. Otherwise the listeners get the area covered by the changed actions.
+		*/
+		void flush();
+
+		/** A area that can be passed to the listeners to repaint the entire component. */
+		static Rectangle<int> getFullRepaintArea() { return { 0, 0, 0x3FFFFFFF, 0x3FFFFFFF }; }
 
 		void addDrawActionListener(Listener* l) { listeners.addIfNotAlreadyThere(l); }
 		void removeDrawActionListener(Listener* l) { listeners.removeAllInstancesOf(l); }
@@ -314,15 +339,28 @@ struct DrawActions
 
 		void handleAsyncUpdate() override
 		{
+			Rectangle<int> areaToRepaint;
+
+			{
+				SpinLock::ScopedLockType sl(dirtyAreaLock);
+				std::swap(areaToRepaint, pendingDirtyArea);
+			}
+
 			for (auto l : listeners)
 			{
 				if (l != nullptr)
-					l->newPaintActionsAvailable();
+					l->newPaintActionsAvailable(areaToRepaint);
 			}
 		}
 
+		/** Compares the new list against the last one and returns the area that needs a repaint. */
+		Rectangle<int> getChangedArea() const;
+
 		Array<WeakReference<Listener>> listeners;
 
+		SpinLock dirtyAreaLock;
+		Rectangle<int> pendingDirtyArea;
+
 		ReferenceCountedArray<ActionBase> nextActions;
 		ReferenceCountedArray<ActionBase> currentActions;
 
@@ -344,7 +382,7 @@ public:
 	BorderPanel(DrawActions::Handler* drawHandler);
 	~BorderPanel();
 
-	void newPaintActionsAvailable() override { repaint(); }
+	void newPaintActionsAvailable(Rectangle<int> dirtyArea) override;
 
 	void paint(Graphics &g);
 	Colour c1, c2, borderColour;
@@ -377,6 +415,14 @@ public:
 
 	WeakReference<DrawActions::Handler> drawHandler;
 
+private:
+
+	/** Renders the invalid region of the draw list into the layer cache. */
+	void renderDrawActionsToLayer(float scaleFactor);
+
+	Image cachedLayer;
+	Rectangle<int> invalidLayerArea;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BorderPanel);
 	
 	// ================================================================================================================
@@ -53,7 +53,11 @@ MainController::SampleManager::SampleManager(MainController *mc_) :
 	preloadFlag(false),
 	pendingFunctions(8192)
 {
-	
+	// The sample loading thread preloads samples too, so it needs one thread less
+	const int numPreloadThreads = jmin(HISE_NUM_PRELOAD_THREADS, SystemStats::getNumCpus()) - 1;
+
+	if (numPreloadThreads > 0)
+		preloadThreadPool = new ThreadPool(numPreloadThreads);
 }
 
 
@@ -64,6 +68,7 @@ MainController::SampleManager::~SampleManager()
 
 	internalPreloadJob.signalJobShouldExit();
 	samplerLoaderThreadPool->stopThread(2000);
+	preloadThreadPool = nullptr;
 
 	pendingFunctions.clear();
 
@@ -41,6 +41,14 @@ MainController::UserPresetHandler::UserPresetHandler(MainController* mc_) :
 
 void MainController::UserPresetHandler::loadUserPreset(const ValueTree& v)
 {
+	presetLoadStartTime = Time::getMillisecondCounterHiRes();
+
+#if HISE_DIFFERENTIAL_PRESET_LOADING && !USE_RAW_FRONTEND
+	if (applyPresetDifferentially(v))
+		return;
+#endif
+
+	lastPresetWasDifferential = false;
 	pendingPreset = v;
 
 	auto f = [](Processor*p) 
@@ -201,32 +209,138 @@ void MainController::UserPresetHandler::loadUserPresetInternal()
 
 
 
-		auto f = [](Dispatchable* obj)
+		lastPresetLoadingTime = Time::getMillisecondCounterHiRes() - presetLoadStartTime;
+
+		sendPresetChangeMessage();
+	}
+
+	
+
+	mc->getSampleManager().preloadEverything();
+}
+
+bool MainController::UserPresetHandler::applyPresetDifferentially(const ValueTree& userPresetToLoad)
+{
+#if USE_RAW_FRONTEND
+	ignoreUnused(userPresetToLoad);
+	return false;
+#else
+
+#if USE_BACKEND
+	if (!GET_PROJECT_HANDLER(mc->getMainSynthChain()).isActive())
+		return false;
+#endif
+
+	// Changes to the MIDI automation or the MPE setup need the full reload
+	auto automationHandler = mc->getMacroManager().getMidiControlAutomationHandler();
+
+	auto autoData = userPresetToLoad.getChildWithName("MidiAutomation");
+
+	if (autoData.isValid() && !autoData.isEquivalentTo(automationHandler->exportAsValueTree()))
+		return false;
+
+	auto mpeData = userPresetToLoad.getChildWithName("MPEData");
+	auto& currentMpeData = automationHandler->getMPEData();
+
+	if (mpeData.isValid() ? !mpeData.isEquivalentTo(currentMpeData.exportAsValueTree()) : (currentMpeData.isMpeEnabled() || currentMpeData.size() != 0))
+		return false;
+
+	struct ParameterChange
+	{
+		JavascriptMidiProcessor* sp;
+		int componentIndex;
+		float newValue;
+	};
+
+	Array<ParameterChange> changes;
+
+	static const Identifier id_("id");
+	static const Identifier value_("value");
+	static const Identifier processor_("Processor");
+
+	Processor::Iterator<JavascriptMidiProcessor> iter(mc->getMainSynthChain());
+
+	while (JavascriptMidiProcessor *sp = iter.getNextProcessor())
+	{
+		if (!sp->isFront()) continue;
+
+		auto v = userPresetToLoad.getChildWithProperty(processor_, sp->getId());
+
+		if (!v.isValid())
+			continue;
+
+		auto content = sp->getScriptingContent();
+
+		for (int i = 0; i < content->getNumComponents(); i++)
 		{
-			auto uph = static_cast<UserPresetHandler*>(obj);
-			auto mc_ = uph->mc;
-			ignoreUnused(mc_);
-			jassert_dispatched_message_thread(mc_);
+			auto c = content->getComponent(i);
 
-			ScopedLock sl(uph->listeners.getLock());
+			if (!c->getScriptObjectProperty(ScriptingApi::Content::ScriptComponent::Properties::saveInPreset)) continue;
 
-			for (auto l : uph->listeners)
-			{
-				uph->mc->checkAndAbortMessageThreadOperation();
+			auto presetChild = v.getChildWithProperty(id_, c->getName().toString());
 
-				if (l != nullptr)
-					l->presetChanged(uph->currentlyLoadedFile);
-			}
+			// The component would be reset to its default value
+			if (!presetChild.isValid())
+				return false;
 
-			return Status::OK;
-		};
+			const auto newValue = presetChild.getProperty(value_);
+
+			if (newValue.toString() == c->exportAsValueTree().getProperty(value_).toString())
+				continue;
+
+			// Only values that go straight to a module parameter can be applied without reloading,
+			// everything else might run a script callback that changes the module structure or loads sample maps
+			const bool isSimpleValue = dynamic_cast<ScriptingApi::Content::ScriptLabel*>(c) == nullptr &&
+									   dynamic_cast<ScriptingApi::Content::ScriptSliderPack*>(c) == nullptr &&
+									   !newValue.toString().startsWith("JSON");
+
+			const auto parameterIndex = c->getConnectedParameterIndex();
+			const bool isParameter = c->isConnectedToProcessor() && (parameterIndex >= 0 || parameterIndex == -2);
+			const bool isMacro = c->getScriptObjectProperty(ScriptingApi::Content::ScriptComponent::macroControl).toString().startsWith("Macro ");
+
+			if (!isSimpleValue || !isParameter || isMacro)
+				return false;
 
-		mc->getLockFreeDispatcher().callOnMessageThreadAfterSuspension(this, f);
+			changes.add({ sp, i, (float)ScriptingApi::Content::Helpers::getCleanedComponentValue(newValue) });
+		}
 	}
 
-	
+	// The modules smooth their parameters, so the new values can be set without killing the voices
+	for (const auto& c : changes)
+		c.sp->setAttribute(c.componentIndex, c.newValue, sendNotification);
 
-	mc->getSampleManager().preloadEverything();
+	lastPresetWasDifferential = true;
+	lastPresetLoadingTime = Time::getMillisecondCounterHiRes() - presetLoadStartTime;
+
+	sendPresetChangeMessage();
+
+	return true;
+#endif
+}
+
+void MainController::UserPresetHandler::sendPresetChangeMessage()
+{
+	auto f = [](Dispatchable* obj)
+	{
+		auto uph = static_cast<UserPresetHandler*>(obj);
+		auto mc_ = uph->mc;
+		ignoreUnused(mc_);
+		jassert_dispatched_message_thread(mc_);
+
+		ScopedLock sl(uph->listeners.getLock());
+
+		for (auto l : uph->listeners)
+		{
+			uph->mc->checkAndAbortMessageThreadOperation();
+
+			if (l != nullptr)
+				l->presetChanged(uph->currentlyLoadedFile);
+		}
+
+		return Status::OK;
+	};
+
+	mc->getLockFreeDispatcher().callOnMessageThreadAfterSuspension(this, f);
 }
 
 
@@ -83,6 +83,8 @@ Processor::~Processor()
 
 	getMainController()->getMacroManager().removeMacroControlsFor(this);
 
+	getMainController()->moduleTreeChanged();
+
 	removeAllChangeListeners();
 
 	masterReference.clear();
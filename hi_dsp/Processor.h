@@ -826,6 +826,8 @@ public:
 
 		parentProcessor = newParent;
 
+		getMainController()->moduleTreeChanged();
+
 		for (int i = 0; i < getNumChildProcessors(); i++)
 			getChildProcessor(i)->setParentProcessor(this);
 	}
@@ -501,6 +501,10 @@ public:
 
 		void notifyListeners(Listener::EventType t, Processor* p)
 		{
+			// The audio thread might have checked the module tree between setParentProcessor() and the insertion
+			if (t == Listener::ProcessorAdded && p != nullptr)
+				p->getMainController()->moduleTreeChanged();
+
 			ScopedLock sl(listeners.getLock());
 
 			for (auto l : listeners)
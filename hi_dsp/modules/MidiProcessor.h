@@ -193,6 +193,16 @@ public:
 
 	void renderNextHiseEventBuffer(HiseEventBuffer &buffer, int numSamples);
 
+	/** Returns true if rendering the next buffer would leave the events untouched.
+	*
+	*	In this case the synth can read the events of its parent without copying them.
+	*/
+	bool canPassThroughEvents() const noexcept
+	{
+		return processors.isEmpty() && !isBypassed() && !allNotesOffAtNextBuffer &&
+			   futureEventBuffer.isEmpty() && artificialEvents.isEmpty();
+	}
+
 	/** Sequentially processes all processors. */
 	void processHiseEvent(HiseEvent &m) override
 	{
@@ -42,21 +42,27 @@ struct ModBufferExpansion
 		return (range.contains(rampStart) || range.getEnd() == rampStart) && range.getLength() < 0.001f;
 	}
 
-	/** Expands the data found in modulationData + startsample according to the HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR.
+	/** Expands the data found in modulationData + startsample according to the control rate divisor.
 	*
 	*	It updates the rampstart and returns true if there was movement in the modulation data.
 	*
 	*/
-	static bool expand(const float* modulationData, int startSample, int numSamples, float& rampStart)
+	static bool expand(const float* modulationData, int startSample, int numSamples, float& rampStart, int divisor)
 	{
-		const int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
-		const int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+		const int startSample_cr = startSample / divisor;
+		const int numSamples_cr = numSamples / divisor;
 
 		if (isEqual(rampStart, modulationData + startSample_cr, numSamples_cr))
 		{
 			rampStart = modulationData[startSample_cr];
 			return false;
 		}
+		else if (divisor == 1)
+		{
+			// Already at audio rate, just update the ramp value
+			rampStart = modulationData[startSample + numSamples - 1];
+			return true;
+		}
 		else
 		{
 			float* temp = (float*)alloca(sizeof(float) * (numSamples_cr));
@@ -65,21 +71,51 @@ struct ModBufferExpansion
 
 			float* d = const_cast<float*>(modulationData + startSample);
 
-			constexpr float ratio = 1.0f / (float)HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
-
-			for (int i = 0; i < numSamples_cr; i++)
+			switch (divisor)
 			{
-				AlignedSSERamper<HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR> ramper(d);
-
-				const float delta1 = (temp[i] - rampStart) * ratio;
-				ramper.ramp(rampStart, delta1);
-				rampStart = temp[i];
-				d += HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+			case 4:		rampAligned<4>(d, temp, numSamples_cr, rampStart); break;
+			case 8:		rampAligned<8>(d, temp, numSamples_cr, rampStart); break;
+			case 16:	rampAligned<16>(d, temp, numSamples_cr, rampStart); break;
+			case 32:	rampAligned<32>(d, temp, numSamples_cr, rampStart); break;
+			default:	rampUnaligned(d, temp, numSamples_cr, divisor, rampStart); break;
 			}
 
 			return true;
 		}
 	}
+
+private:
+
+	template <int Divisor> static void rampAligned(float* d, const float* controlValues, int numSamples_cr, float& rampStart)
+	{
+		constexpr float ratio = 1.0f / (float)Divisor;
+
+		for (int i = 0; i < numSamples_cr; i++)
+		{
+			AlignedSSERamper<Divisor> ramper(d);
+
+			const float delta1 = (controlValues[i] - rampStart) * ratio;
+			ramper.ramp(rampStart, delta1);
+			rampStart = controlValues[i];
+			d += Divisor;
+		}
+	}
+
+	/** Used for divisors that are smaller than a SSE register. */
+	static void rampUnaligned(float* d, const float* controlValues, int numSamples_cr, int divisor, float& rampStart)
+	{
+		const float ratio = 1.0f / (float)divisor;
+
+		for (int i = 0; i < numSamples_cr; i++)
+		{
+			const float delta1 = (controlValues[i] - rampStart) * ratio;
+
+			for (int j = 0; j < divisor; j++)
+				*d++ = rampStart + (float)j * delta1;
+
+			rampStart = controlValues[i];
+		}
+	}
 };
 
 template <class ModulatorSubType> struct ModIterator
@@ -323,7 +359,15 @@ void ModulatorChain::ModChainWithBuffer::expandVoiceValuesToAudioRate(int voiceI
 	{
 		polyExpandChecker = true;
 
-		if (!ModBufferExpansion::expand(currentVoiceData, startSample, numSamples, currentRampValues[voiceIndex]))
+		const int startSample_cr = startSample / getControlRateDivisor();
+
+		if (currentVoiceDataIsConstant && currentVoiceData[startSample_cr] == currentRampValues[voiceIndex])
+		{
+			// The envelopes flagged this block as constant and there's nothing to ramp, so skip the range check
+			currentConstantValue = currentRampValues[voiceIndex];
+			currentVoiceData = nullptr;
+		}
+		else if (!ModBufferExpansion::expand(currentVoiceData, startSample, numSamples, currentRampValues[voiceIndex], getControlRateDivisor()))
 		{
 			// Don't use the dynamic data for further processing...
 
@@ -346,7 +390,7 @@ void ModulatorChain::ModChainWithBuffer::expandMonophonicValuesToAudioRate(int s
 
 	if (auto data = getMonophonicModulationValues(startSample))
 	{
-		if (!ModBufferExpansion::expand(getMonophonicModulationValues(0), startSample, numSamples, currentMonophonicRampValue))
+		if (!ModBufferExpansion::expand(getMonophonicModulationValues(0), startSample, numSamples, currentMonophonicRampValue, getControlRateDivisor()))
 		{
 			FloatVectorOperations::fill(const_cast<float*>(data + startSample), currentMonophonicRampValue, numSamples);
 		}
@@ -364,6 +408,34 @@ void ModulatorChain::ModChainWithBuffer::setExpandToAudioRate(bool shouldExpandA
 	options.expandToAudioRate = shouldExpandAfterRendering;
 }
 
+void ModulatorChain::ModChainWithBuffer::setControlRateDivisor(int newDivisor)
+{
+	options.controlRateDivisor = newDivisor;
+	updateControlRateDivisor();
+}
+
+void ModulatorChain::ModChainWithBuffer::updateControlRateDivisor()
+{
+	// Only one value per sub block is used in the block-constant mode, so the modulators
+	// can run at the coarsest rate that still lines up with the sub blocks
+	const int newDivisor = options.constantValueForBlock ? HISE_EVENT_RASTER : options.controlRateDivisor;
+
+	if (newDivisor != getControlRateDivisor())
+	{
+		c->setControlRateDivisor(newDivisor);
+
+		// The modulators need to recalculate their timing with the new control rate
+		if (c->getSampleRate() > 0.0)
+			c->prepareToPlay(c->getSampleRate(), c->getLargestBlockSize());
+	}
+}
+
+void ModulatorChain::ModChainWithBuffer::setUseConstantValueForBlock(bool shouldUseConstantValue)
+{
+	options.constantValueForBlock = shouldUseConstantValue;
+	updateControlRateDivisor();
+}
+
 
 void ModulatorChain::ModChainWithBuffer::calculateMonophonicModulationValues(int startSample, int numSamples)
 {
@@ -372,8 +444,8 @@ void ModulatorChain::ModChainWithBuffer::calculateMonophonicModulationValues(int
 
 	if (c->hasMonophonicTimeModulationMods())
 	{
-		int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
-		int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+		int startSample_cr = startSample / getControlRateDivisor();
+		int numSamples_cr = numSamples / getControlRateDivisor();
 
 		jassert(type == Type::Normal);
 		jassert(c->hasMonophonicTimeModulationMods());
@@ -420,13 +492,15 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 	auto voiceData = modBuffer.voiceValues;
 	const auto monoData = modBuffer.monoValues;
 
-	jassert(startSample % HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR == 0);
+	jassert(startSample % getControlRateDivisor() == 0);
 
-	int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
-	int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	int startSample_cr = startSample / getControlRateDivisor();
+	int numSamples_cr = numSamples / getControlRateDivisor();
 
 	bool constantValuesAreSmoothed = false;
 
+	currentVoiceDataIsConstant = false;
+
 	if (c->hasActivePolyMods())
 	{
 		const float thisConstantValue = c->getConstantVoiceValue(voiceIndex);
@@ -461,11 +535,16 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 		{
 			ModIterator<EnvelopeModulator> iter(c);
 
+			bool allEnvelopesConstant = !constantValuesAreSmoothed && !useMonophonicData;
+
 			while (auto mod = iter.next())
 			{
 				mod->render(voiceIndex, voiceData, modBuffer.scratchBuffer, startSample_cr, numSamples_cr);
+				allEnvelopesConstant &= mod->isBlockConstant();
 			}
 
+			currentVoiceDataIsConstant = allEnvelopesConstant;
+
 			if (useMonophonicData)
 			{
 				applyMonophonicValuesToVoiceInternal(voiceData + startSample_cr, monoData + startSample_cr, numSamples_cr);
@@ -551,6 +630,16 @@ void ModulatorChain::ModChainWithBuffer::calculateModulationValuesForCurrentVoic
 
 	setDisplayValueInternal(voiceIndex, startSample_cr, numSamples_cr);
 
+	if (options.constantValueForBlock && currentVoiceData != nullptr)
+	{
+		// Use the value in the middle of the sub block and skip the audio rate buffers
+		const float blockValue = currentVoiceData[startSample_cr + numSamples_cr / 2];
+
+		currentConstantValue = blockValue;
+		currentRampValues[voiceIndex] = blockValue;
+		currentVoiceData = nullptr;
+	}
+
 	c->polyManager.clearCurrentVoice();
 }
 
@@ -595,9 +684,9 @@ float* ModulatorChain::ModChainWithBuffer::getWritePointerForManualExpansion(int
 	jassert(currentVoiceData != nullptr || !polyExpandChecker);
 
 	// Have you already downsampled the startOffsetValue? If not, this is really bad...
-	jassert(startSample % HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR == 0);
+	jassert(startSample % getControlRateDivisor() == 0);
 
-	int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	int startSample_cr = startSample / getControlRateDivisor();
 
 	manualExpansionPending = true;
 
@@ -634,7 +723,7 @@ float ModulatorChain::ModChainWithBuffer::getOneModulationValue(int startSample)
 	if (currentVoiceData == nullptr)
 		return getConstantModulationValue();
 
-	const int downsampledOffset = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	const int downsampledOffset = startSample / getControlRateDivisor();
 	return currentVoiceData[downsampledOffset];
 }
 
@@ -969,14 +1058,37 @@ void ModulatorChain::prepareToPlay(double sampleRate, int samplesPerBlock)
 	EnvelopeModulator::prepareToPlay(sampleRate, samplesPerBlock);
 	blockSize = samplesPerBlock;
 
-	
-	
+	for (auto m : allModulators)
+		applyControlRateDivisor(m);
+
 	for(int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
 	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
 
 	jassert(checkModulatorStructure());
 };
 
+void ModulatorChain::setControlRateDivisor(int newDivisor)
+{
+	EnvelopeModulator::setControlRateDivisor(newDivisor);
+
+	for (auto m : allModulators)
+		applyControlRateDivisor(m);
+}
+
+void ModulatorChain::applyControlRateDivisor(Modulator* m)
+{
+	const int divisor = getControlRateDivisor();
+
+	if (auto tm = dynamic_cast<TimeModulation*>(m))
+		tm->setControlRateDivisor(divisor);
+
+	for (int i = 0; i < m->getNumInternalChains(); i++)
+	{
+		if (auto internalChain = dynamic_cast<ModulatorChain*>(m->getChildProcessor(i)))
+			internalChain->setControlRateDivisor(divisor);
+	}
+}
+
 void ModulatorChain::setIsVoiceStartChain(bool isVoiceStartChain_)
 {
 	isVoiceStartChain = isVoiceStartChain_;
@@ -1071,6 +1183,8 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 
 	newModulator->addBypassListener(this);
 
+	chain->applyControlRateDivisor(newModulator);
+
 	if (chain->isInitialized())
 		newModulator->prepareToPlay(chain->getSampleRate(), chain->blockSize);
 	
@@ -1309,6 +1423,7 @@ void EnvelopeModulatorFactoryType::fillTypeNameList()
 	ADD_NAME_TO_TYPELIST(CCEnvelope);
 	ADD_NAME_TO_TYPELIST(JavascriptEnvelopeModulator);
 	ADD_NAME_TO_TYPELIST(MPEModulator);
+	ADD_NAME_TO_TYPELIST(GlobalEnvelopeModulator);
 }
 
 
@@ -263,15 +263,49 @@ public:
 
 		bool isAudioRateModulation() const noexcept { return options.expandToAudioRate; }
 
+		/** Sets the number of audio samples per calculated modulation value. Default is HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR.
+		*
+		*	Use a smaller value for chains that need a fast response (eg. pitch modulation). The divisor must be a power
+		*	of two that divides HISE_EVENT_RASTER so that every sub block starts at a control rate value. With the default
+		*	raster of 8 samples this means you can only go down to 1, 2 or 4 samples. If you want to save CPU on slow chains,
+		*	use setUseConstantValueForBlock() or raise HISE_EVENT_RASTER.
+		*
+		*	Global modulator receivers in this chain resample the values of their container, which always renders at
+		*	HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR.
+		*
+		*	This will prepare the modulators again if the chain is already initialised, so don't call it on the audio thread.
+		*/
+		void setControlRateDivisor(int newDivisor);
+
+		/** Returns the number of audio samples per calculated modulation value. */
+		int getControlRateDivisor() const noexcept { return c->getControlRateDivisor(); }
+
+		/** If enabled, the chain will only use one value per sub block. Default is disabled.
+		*
+		*	The voice modulation will always be reported as constant, so the expansion and the audio rate buffers are
+		*	skipped altogether. The modulators run at HISE_EVENT_RASTER samples per value while this is enabled, which
+		*	is the coarsest rate that keeps their timing intact across sub blocks of any length. With the default raster
+		*	this is the same as the default control rate. Use this for slowly changing chains where a stepped modulation
+		*	is not audible.
+		*
+		*	This will prepare the modulators again if the chain is already initialised, so don't call it on the audio thread.
+		*/
+		void setUseConstantValueForBlock(bool shouldUseConstantValue);
+
 		struct Options
 		{
 			bool expandToAudioRate = false;
 			bool includeMonophonicValues = true;
 			bool voiceValuesReadOnly = true;
+			bool constantValueForBlock = false;
+			int controlRateDivisor = HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
 		};
 
 	private:
 
+		/** Applies the divisor from setControlRateDivisor() or the coarsest one in the block-constant mode. */
+		void updateControlRateDivisor();
+
 		void applyMonophonicValuesToVoiceInternal(float* voiceBuffer, float* monoBuffer, int numSamples);
 
 		void setDisplayValueInternal(int voiceIndex, int startSample, int numSamples);
@@ -294,6 +328,9 @@ public:
 
 		bool manualExpansionPending = false;
 
+		/** Set when every envelope flagged its block as constant, so the expansion can skip the range check. */
+		bool currentVoiceDataIsConstant = false;
+
 		
 
 		Options options;
@@ -353,6 +390,9 @@ public:
 
 	/** Sets the sample rate for all modulators in the chain and initialized the UpdateMerger. */
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+
+	/** Sets the control rate divisor for this chain, all its modulators and their internal chains. */
+	void setControlRateDivisor(int newDivisor) override;
 	
 	bool hasActivePolyMods() const noexcept;
 	bool hasActiveVoiceStartMods() const noexcept;
@@ -578,6 +618,9 @@ private:
 
 	Array<Modulator*> allModulators;
 
+	/** Passes the control rate divisor of this chain to the modulator and its internal chains. */
+	void applyControlRateDivisor(Modulator* m);
+
 	int blockSize;
 	
 	Identifier chainIdentifier;
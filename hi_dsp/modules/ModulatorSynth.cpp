@@ -68,7 +68,8 @@ iconColour(Colours::transparentBlack),
 clockSpeed(ClockSpeed::Inactive),
 lastClockCounter(0),
 wasPlayingInLastBuffer(false),
-bypassState(false)
+bypassState(false),
+parallelVoiceRenderer(*this)
 {
 	modChains += { this, "GainModulation", ModulatorChain::ModulationType::Normal, Modulation::Mode::GainMode};
 	modChains += { this, "PitchModulation", ModulatorChain::ModulationType::Normal, Modulation::Mode::PitchMode};
@@ -210,6 +211,23 @@ const Processor * ModulatorSynth::getChildProcessor(int processorIndex) const
 	}
 }
 
+ModulatorChain::ModChainWithBuffer* ModulatorSynth::getModChainWithBuffer(int chainIndex)
+{
+	if (!isPositiveAndBelow(chainIndex, getNumInternalChains()))
+		return nullptr;
+
+	if (auto chain = dynamic_cast<ModulatorChain*>(getChildProcessor(chainIndex)))
+	{
+		for (auto& mb : modChains)
+		{
+			if (mb.getChain() == chain)
+				return &mb;
+		}
+	}
+
+	return nullptr;
+}
+
 int ModulatorSynth::getFreeTimerSlot()
 {
 	if (synthTimerIntervals[0] == 0.0) return 0;
@@ -319,16 +337,25 @@ ProcessorEditorBody *ModulatorSynth::createEditor(ProcessorEditor *parentEditor)
 
 void ModulatorSynth::processHiseEventBuffer(const HiseEventBuffer &inputBuffer, int numSamples)
 {
-	eventBuffer.copyFrom(inputBuffer);
+	const bool isMainSynthChain = getMainController()->getMainSynthChain() == this;
 
-	
+	if (!isMainSynthChain && !anyTimerActive && midiProcessorChain->canPassThroughEvents())
+	{
+		// Nothing would change the events, so just read the parent's buffer
+		eventBuffer.clear();
+		eventsToRender = &inputBuffer;
+		return;
+	}
+
+	eventsToRender = &eventBuffer;
+	eventBuffer.copyFrom(inputBuffer);
 
 	if (checkTimerCallback(0, numSamples)) synthTimerCallback(0, numSamples);
 	if (checkTimerCallback(1, numSamples)) synthTimerCallback(1, numSamples);
 	if (checkTimerCallback(2, numSamples)) synthTimerCallback(2, numSamples);
 	if (checkTimerCallback(3, numSamples)) synthTimerCallback(3, numSamples);
 
-	if (getMainController()->getMainSynthChain() == this)
+	if (isMainSynthChain)
 	{
 		handleHostInfoHiseEvents(numSamples);
 	}
@@ -378,11 +405,11 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
 
 	
-	midiInputFlag = !eventBuffer.isEmpty();
+	midiInputFlag = !eventsToRender->isEmpty();
 
 	
 
-	HiseEventBuffer::Iterator eventIterator(eventBuffer);
+	HiseEventBuffer::Iterator eventIterator(*eventsToRender);
 
 	HiseEvent m;
 	int midiEventPos;
@@ -482,18 +509,77 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
     
 	clearPendingRemoveVoices();
 
-	for (auto v : activeVoices)
+	if (canRenderVoicesInParallel())
 	{
-		jassert(!v->isInactive());
+		renderVoicesInParallel(startSample, numThisTime);
+	}
+	else
+	{
+		for (auto v : activeVoices)
+		{
+			jassert(!v->isInactive());
 
-		calculateModulationValuesForVoice(v, startSample, numThisTime);
+			calculateModulationValuesForVoice(v, startSample, numThisTime);
 
-		v->renderNextBlock(internalBuffer, startSample, numThisTime);
+			v->renderNextBlock(internalBuffer, startSample, numThisTime);
+		}
 	}
 
 	clearPendingRemoveVoices();
 };
 
+bool ModulatorSynth::canRenderVoicesInParallel() const
+{
+	if (!useParallelVoiceRendering || activeVoices.size() < MinNumVoicesForParallelRendering)
+		return false;
+
+	auto pool = const_cast<MainController*>(getMainController())->getAudioRenderingThreadPool();
+
+	if (pool == nullptr || pool->getNumWorkerThreads() == 0)
+		return false;
+
+	// All voices of a synth have the same type, so we only need to check one of them
+	return activeVoices[0]->canRenderInParallel();
+}
+
+void ModulatorSynth::renderVoicesInParallel(int startSample, int numThisTime)
+{
+	auto pool = getMainController()->getAudioRenderingThreadPool();
+
+	const int numSlots = jmin(pool->getNumWorkerThreads() + 1, activeVoices.size());
+
+	for (int i = 0; i < activeVoices.size(); i++)
+	{
+		auto v = activeVoices[i];
+
+		jassert(!v->isInactive());
+
+		calculateModulationValuesForVoice(v, startSample, numThisTime);
+		v->prepareParallelRendering(startSample, numThisTime, i % numSlots);
+	}
+
+	parallelVoiceRenderer.startSample = startSample;
+	parallelVoiceRenderer.numSamples = numThisTime;
+	parallelVoiceRenderer.numSlots = numSlots;
+
+	pool->process(parallelVoiceRenderer, numSlots);
+
+	// Sum up the voices in a deterministic order
+	for (auto v : activeVoices)
+	{
+		v->finishParallelRendering(startSample, numThisTime);
+		v->addVoiceBufferToOutput(internalBuffer, startSample, numThisTime);
+	}
+}
+
+void ModulatorSynth::ParallelVoiceRenderer::renderSlot(int slotIndex)
+{
+	auto& voices = synth.activeVoices;
+
+	for (int i = slotIndex; i < voices.size(); i += numSlots)
+		voices[i]->renderParallel(startSample, numSamples);
+}
+
 	
 void ModulatorSynth::calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime)
 {
@@ -1738,31 +1824,35 @@ void ModulatorSynthVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int
     { 
 		calculateBlock(startSample, numSamples);
 
-		if (gainFader.isSmoothing())
-		{
-			applyEventVolumeFade(startSample, numSamples);
-		}
-		else if (eventGainFactor != 1.0f)
-		{
-			applyEventVolumeFactor(startSample, numSamples);
-		}
+		addVoiceBufferToOutput(outputBuffer, startSample, numSamples);
+    }
+}
 
-		if(killThisVoice)
-		{
-			applyKillFadeout(startSample, numSamples);
-		}
+void ModulatorSynthVoice::addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+	if (gainFader.isSmoothing())
+	{
+		applyEventVolumeFade(startSample, numSamples);
+	}
+	else if (eventGainFactor != 1.0f)
+	{
+		applyEventVolumeFactor(startSample, numSamples);
+	}
 
-		const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
+	if (killThisVoice)
+	{
+		applyKillFadeout(startSample, numSamples);
+	}
 
-		for (int i = 0; i < maxChannelAmount; i++)
-		{
-			FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
-		}
+	const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
 
+	for (int i = 0; i < maxChannelAmount; i++)
+	{
+		FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
+	}
 
-		// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
-		checkRelease();
-    }
+	// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
+	checkRelease();
 }
 
 void ModulatorSynthVoice::setCurrentHiseEvent(const HiseEvent &m)
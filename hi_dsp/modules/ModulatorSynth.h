@@ -167,7 +167,7 @@ public:
 	virtual void preVoiceRendering(int startSample, int numThisTime);;
 
 	/** This method is called to actually render all voices. It operates on the internal buffer of the ModulatorSynth. */
-	void renderVoice(int startSample, int numThisTime);
+	virtual void renderVoice(int startSample, int numThisTime);
 
 	void calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime);;
 
@@ -270,6 +270,24 @@ public:
 
 	void setKillFadeOutTime(double fadeTimeSeconds);
 
+	/** The minimum amount of active voices that is required to render the voices in parallel. */
+	static constexpr int MinNumVoicesForParallelRendering = 8;
+
+	/** Enables the rendering of the voices on the audio worker threads (see HISE_NUM_AUDIO_WORKER_THREADS). 
+	*
+	*	This only has an effect if the voices of this synth support the parallel rendering and there are enough active voices,
+	*	otherwise the voices will be rendered one after another on the audio thread.
+	*/
+	void setUseParallelVoiceRendering(bool shouldBeEnabled) noexcept { useParallelVoiceRendering = shouldBeEnabled; }
+
+	bool isUsingParallelVoiceRendering() const noexcept { return useParallelVoiceRendering; }
+
+	/** Override this and return true if other synths of the parent ModulatorSynthChain use data of this synth while rendering. 
+	*
+	*	If the parent chain renders its child synths concurrently, these synths will be rendered before all other children. 
+	*/
+	virtual bool needsToBeRenderedBeforeSiblings() const { return false; }
+
 		/** Checks if the message fits the sound, but can be overriden to implement other group start logic. */
 	virtual bool soundCanBePlayed(ModulatorSynthSound *sound, int midiChannel, int midiNoteNumber, float velocity);
 
@@ -415,6 +433,9 @@ public:
 		return modChains[BasicChains::GainChain].getConstantModulationValue();
 	}
 
+	/** Returns the buffered modulation chain for the given child processor index (eg. GainModulation) or nullptr if it's not a modulation chain. */
+	ModulatorChain::ModChainWithBuffer* getModChainWithBuffer(int chainIndex);
+
 
 	float getConstantVoicePitchModulationValueDeleteSoon() const
 	{
@@ -444,6 +465,12 @@ protected:
 public:
 
 	HiseEventBuffer eventBuffer;
+
+	/** The events of the current block. This points either to the eventBuffer or to the
+	*	buffer of the parent synth if nothing would change the events.
+	*/
+	const HiseEventBuffer* eventsToRender = &eventBuffer;
+
 	AudioSampleBuffer internalBuffer;
 
 	UpdateMerger vuMerger;
@@ -512,10 +539,38 @@ protected:
 
 private:
 
+	/** Renders the voices that are assigned to a slot. 
+	*
+	*	The active voices are distributed to the slots by their position, so the assignment (and the result) doesn't 
+	*	depend on which thread renders which slot. 
+	*/
+	struct ParallelVoiceRenderer : public AudioRenderingThreadPool::Task
+	{
+		ParallelVoiceRenderer(ModulatorSynth& s) :
+			synth(s)
+		{};
+
+		void renderSlot(int slotIndex) override;
+
+		ModulatorSynth& synth;
+
+		int startSample = 0;
+		int numSamples = 0;
+		int numSlots = 1;
+	};
+
+	bool canRenderVoicesInParallel() const;
+
+	void renderVoicesInParallel(int startSample, int numThisTime);
+
     void updateShouldHaveEnvelope();
 	
 	bool shouldHaveEnvelope = true;
 
+	bool useParallelVoiceRendering = false;
+
+	ParallelVoiceRenderer parallelVoiceRenderer;
+
 
 
 	int numActiveVoices;
@@ -614,6 +669,32 @@ public:
 
 
 	virtual void calculateBlock(int startSample, int numSamples) = 0;
+
+	/** Override this and return true if the voice implements the parallel rendering methods below.
+	*
+	*	If the ModulatorSynth renders its voices in parallel, calculateBlock() won't be called, but
+	*	the rendering is split up into these three steps:
+	*
+	*	1. prepareParallelRendering() is called on the audio thread after the modulation values for this voice were calculated.
+	*	2. renderParallel() is called on an audio worker thread (or the audio thread).
+	*	3. finishParallelRendering() is called on the audio thread in the order of the active voices.
+	*/
+	virtual bool canRenderInParallel() const noexcept { return false; }
+
+	/** Copy everything you need from the modulation chains of the ModulatorSynth here (they will be overwritten by the next voice). 
+	*
+	*	The slot index is the same for every voice that is rendered on the same thread, so you can use it to pick a temporary buffer.
+	*/
+	virtual void prepareParallelRendering(int /*startSample*/, int /*numSamples*/, int /*slotIndex*/) {};
+
+	/** Render the voice into the voice buffer. This must only use data that belongs to this voice. */
+	virtual void renderParallel(int /*startSample*/, int /*numSamples*/) {};
+
+	/** Apply the voice effects and everything else that touches shared data here. The voice buffer is added to the output after this call. */
+	virtual void finishParallelRendering(int /*startSample*/, int /*numSamples*/) {};
+
+	/** Applies the event gain and the kill fade to the voice buffer and adds it to the output buffer. */
+	void addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples);
 	
 	bool isPitchFadeActive() const noexcept
 	{
@@ -40,7 +40,8 @@ ModulatorSynthChain::ModulatorSynthChain(MainController *mc, const String &id, i
 #endif
 	numVoices(numVoices_),
 	handler(this),
-	vuValue(0.0f)
+	vuValue(0.0f),
+	childSynthRenderer(*this)
 {
 #if USE_BACKEND == 0
 	ignoreUnused(viewUndoManager);
@@ -126,6 +127,133 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 	ModulatorSynth::prepareToPlay(newSampleRate, samplesPerBlock);
 
 	for (int i = 0; i < synths.size(); i++) synths[i]->prepareToPlay(newSampleRate, samplesPerBlock);
+
+	refreshChildSynthBuffers();
+}
+
+void ModulatorSynthChain::refreshChildSynthBuffers()
+{
+	if (getMainController()->getAudioRenderingThreadPool() == nullptr || getLargestBlockSize() <= 0)
+	{
+		childSynthBuffers.clear();
+		serialChildSynths.clear();
+		return;
+	}
+
+	const int numChannels = getMatrix().getNumSourceChannels();
+
+	while (childSynthBuffers.size() < synths.size())
+		childSynthBuffers.add(new AudioSampleBuffer(numChannels, 0));
+
+	serialChildSynths.resize(childSynthBuffers.size());
+	serialChildSynthsDirty = true;
+
+	for (auto b : childSynthBuffers)
+		b->setSize(numChannels, getLargestBlockSize());
+}
+
+bool ModulatorSynthChain::canRenderChildSynthsConcurrently(int numSamples) const
+{
+	if (!useConcurrentChildSynthRendering || synths.size() < 2)
+		return false;
+
+	auto pool = const_cast<MainController*>(getMainController())->getAudioRenderingThreadPool();
+
+	if (pool == nullptr || pool->getNumWorkerThreads() == 0)
+		return false;
+
+	// The buffers are resized when the synths or channels change, but let's make sure that they fit
+	return childSynthBuffers.size() >= synths.size() &&
+		   serialChildSynths.size() >= synths.size() &&
+		   childSynthBuffers[0]->getNumChannels() == internalBuffer.getNumChannels() &&
+		   childSynthBuffers[0]->getNumSamples() >= numSamples;
+}
+
+bool ModulatorSynthChain::needsSerialRendering(const Processor* p)
+{
+	// Scripts share their global data and MIDI processors can create artificial events
+	// (which modifies the EventIdHandler), so they must not run on multiple threads.
+	if (dynamic_cast<const JavascriptProcessor*>(p) != nullptr)
+		return true;
+
+	if (dynamic_cast<const hise::MidiProcessor*>(p) != nullptr && dynamic_cast<const MidiProcessorChain*>(p) == nullptr)
+		return true;
+
+	for (int i = 0; i < p->getNumChildProcessors(); i++)
+	{
+		if (auto c = p->getChildProcessor(i))
+		{
+			if (needsSerialRendering(c))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+void ModulatorSynthChain::updateSerialChildSynths()
+{
+	const uint32 treeVersion = getMainController()->getModuleTreeVersion();
+
+	if (!serialChildSynthsDirty && treeVersion == serialChildSynthsVersion)
+		return;
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		auto s = synths[i];
+		serialChildSynths.set(i, s->needsToBeRenderedBeforeSiblings() || needsSerialRendering(s));
+	}
+
+	serialChildSynthsVersion = treeVersion;
+	serialChildSynthsDirty = false;
+}
+
+void ModulatorSynthChain::renderChildSynthsConcurrently(int numSamples)
+{
+	// The module tree walk is only done after processors were added or removed
+	updateSerialChildSynths();
+
+	// Render the synths that the other synths depend on or that can't run on another thread before everything else
+	for (int i = 0; i < synths.size(); i++)
+	{
+		auto s = synths[i];
+
+		if (!s->isSoftBypassed() && serialChildSynths[i])
+			s->renderNextBlockWithModulators(internalBuffer, *eventsToRender);
+	}
+
+	childSynthRenderer.numSamples = numSamples;
+
+	getMainController()->getAudioRenderingThreadPool()->process(childSynthRenderer, synths.size());
+
+	// Merge the child buffers in the order of the synths so that the result doesn't depend on the thread timing
+	for (int i = 0; i < synths.size(); i++)
+	{
+		auto s = synths[i];
+
+		if (s->isSoftBypassed() || serialChildSynths[i])
+			continue;
+
+		auto b = childSynthBuffers[i];
+
+		for (int c = 0; c < internalBuffer.getNumChannels(); c++)
+			FloatVectorOperations::add(internalBuffer.getWritePointer(c, 0), b->getReadPointer(c, 0), numSamples);
+	}
+}
+
+void ModulatorSynthChain::ChildSynthRenderer::renderSlot(int slotIndex)
+{
+	auto s = chain.synths[slotIndex];
+
+	if (s->isSoftBypassed() || chain.serialChildSynths[slotIndex])
+		return;
+
+	auto b = chain.childSynthBuffers[slotIndex];
+
+	AudioSampleBuffer output(b->getArrayOfWritePointers(), b->getNumChannels(), numSamples);
+	output.clear();
+
+	s->renderNextBlockWithModulators(output, *chain.eventsToRender);
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -144,6 +272,11 @@ void ModulatorSynthChain::numSourceChannelsChanged()
 
 	ModulatorSynth::numSourceChannelsChanged();
 
+	{
+		ScopedLock sl(getMainController()->getLock());
+		refreshChildSynthBuffers();
+	}
+
 	
 }
 
@@ -229,7 +362,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 
 	processHiseEventBuffer(inputMidiBuffer, numSamples);
 
-	HiseEventBuffer::Iterator eventIterator(eventBuffer);
+	HiseEventBuffer::Iterator eventIterator(*eventsToRender);
 
 	while (auto e = eventIterator.getNextConstEventPointer(true, false))
 	{
@@ -244,13 +377,20 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	internalBuffer.setSize(getMatrix().getNumSourceChannels(), numSamples, true, false, true);
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++)
-    {
-        if (!synths[i]->isSoftBypassed())
-            synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
-    }
+	if (canRenderChildSynthsConcurrently(numSamples))
+	{
+		renderChildSynthsConcurrently(numSamples);
+	}
+	else
+	{
+		for (int i = 0; i < synths.size(); i++)
+		{
+			if (!synths[i]->isSoftBypassed())
+				synths[i]->renderNextBlockWithModulators(internalBuffer, *eventsToRender);
+		}
+	}
 
-	HiseEventBuffer::Iterator eventIterator(eventBuffer);
+	HiseEventBuffer::Iterator eventIterator(*eventsToRender);
 
 	while (auto e = eventIterator.getNextConstEventPointer(true, false))
 	{
@@ -544,6 +684,7 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 		LOCK_PROCESSING_CHAIN(synth);
 		ms->setIsOnAir(synth->isOnAir());
 		synth->synths.insert(index, ms);
+		synth->refreshChildSynthBuffers();
 	}
 
 	notifyListeners(Listener::ProcessorAdded, newProcessor);
@@ -559,6 +700,7 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::remove(Processor *processo
 		LOCK_PROCESSING_CHAIN(synth);
 		processorToBeRemoved->setIsOnAir(false);
 		synth->synths.removeObject(dynamic_cast<ModulatorSynth*>(processorToBeRemoved), false);
+		synth->serialChildSynthsDirty = true;
 	}
 
 	if (removeSynth)
@@ -590,6 +732,7 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::clear()
 	ScopedLock sl(synth->getMainController()->getLock());
 
 	synth->synths.clear();
+	synth->serialChildSynthsDirty = true;
 }
 
 } // namespace hise
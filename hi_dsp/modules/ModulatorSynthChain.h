@@ -230,8 +230,54 @@ public:
 
 	HiseEvent::ChannelFilterData* getActiveChannelData() { return &activeChannels; }
 
+	/** Renders the child synths concurrently on the audio worker threads (see HISE_NUM_AUDIO_WORKER_THREADS).
+	*
+	*	Every child synth renders into its own buffer and the buffers are added to the internal buffer in the order
+	*	of the child synths, so the result doesn't depend on the thread timing. It is not bit-identical to the serial 
+	*	rendering though: the serial rendering adds every synth directly to the internal buffer, while the concurrent 
+	*	rendering sums the synths in their own buffers first, so the floating point rounding differs.
+	*
+	*	The child synths must be independent from each other. Synths that return true in needsToBeRenderedBeforeSiblings()
+	*	and synths that contain scripts or MIDI processors are rendered serially before the other child synths.
+	*/
+	void setRenderChildSynthsConcurrently(bool shouldBeEnabled) noexcept { useConcurrentChildSynthRendering = shouldBeEnabled; }
+
+	bool isRenderingChildSynthsConcurrently() const noexcept { return useConcurrentChildSynthRendering; }
+
 private:
 
+	struct ChildSynthRenderer : public AudioRenderingThreadPool::Task
+	{
+		ChildSynthRenderer(ModulatorSynthChain& c) :
+			chain(c)
+		{};
+
+		void renderSlot(int slotIndex) override;
+
+		ModulatorSynthChain& chain;
+		int numSamples = 0;
+	};
+
+	/** Resizes the buffers for the concurrent rendering. Call this whenever the child synths or the channel amount changes. */
+	void refreshChildSynthBuffers();
+
+	bool canRenderChildSynthsConcurrently(int numSamples) const;
+
+	void renderChildSynthsConcurrently(int numSamples);
+
+	/** Checks whether the processor or one of its children must not be rendered on a worker thread. */
+	static bool needsSerialRendering(const Processor* p);
+
+	/** Updates the serial flags of the child synths if the module tree has changed since the last call. */
+	void updateSerialChildSynths();
+
+	bool useConcurrentChildSynthRendering = false;
+	OwnedArray<AudioSampleBuffer> childSynthBuffers;
+	Array<bool> serialChildSynths;
+	uint32 serialChildSynthsVersion = 0;
+	bool serialChildSynthsDirty = true;
+	ChildSynthRenderer childSynthRenderer;
+
 	HiseEvent::ChannelFilterData activeChannels;
 	ModulatorSynthChainHandler handler;
 	int numVoices;
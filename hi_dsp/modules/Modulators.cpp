@@ -185,6 +185,9 @@ void TimeModulation::applyTimeModulation(float* destinationBuffer, int startInde
 
 	if (smoothedIntensity.isSmoothing())
 	{
+		// the ramped intensity makes the result non-constant
+		blockIsConstant = false;
+
 		float* smoothedIntensityValues = (float*)alloca(sizeof(float) * samplesToCopy);
 
 		int numLoop = samplesToCopy;
@@ -202,6 +205,16 @@ void TimeModulation::applyTimeModulation(float* destinationBuffer, int startInde
 		case PanMode:	applyPanModulation(mod, dest, 1.0f, smoothedIntensityValues, samplesToCopy); break;
 		}
 	}
+	else if (blockIsConstant && modulationMode == GainMode)
+	{
+		const float intensity = getIntensity();
+		const float gain = constantBlockValue * intensity + (1.0f - intensity);
+
+		FloatVectorOperations::fill(mod, gain, samplesToCopy);
+
+		if (gain != 1.0f)
+			FloatVectorOperations::multiply(dest, gain, samplesToCopy);
+	}
 	else
 	{
 		switch (modulationMode)
@@ -226,9 +239,17 @@ TimeModulation::TimeModulation(Mode m) :
 {
 }
 
+void TimeModulation::setControlRateDivisor(int newDivisor)
+{
+	// The control rate values must line up with the event raster
+	jassert(isPowerOfTwo(newDivisor) && newDivisor <= HISE_EVENT_RASTER);
+
+	controlRateDivisor = jlimit<int>(1, HISE_EVENT_RASTER, nextPowerOfTwo(newDivisor));
+}
+
 void TimeModulation::prepareToModulate(double sampleRate, int /*samplesPerBlock*/)
 {
-	constexpr double ratio = 1.0 / (double)HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	const double ratio = 1.0 / (double)controlRateDivisor;
 
 	controlRate = sampleRate * ratio;
 
@@ -601,6 +622,7 @@ Processor *EnvelopeModulatorFactoryType::createProcessor(int typeIndex, const St
 	case ccEnvelope:		return new CCEnvelope(m, id, numVoices, mode);
 	case scriptEnvelope:	return new JavascriptEnvelopeModulator(m, id, numVoices, mode);
 	case mpeModulator:		return new MPEModulator(m, id, numVoices, mode);
+	case globalEnvelopeModulator:	return new GlobalEnvelopeModulator(m, id, numVoices, mode);
 	default: jassertfalse;	return nullptr;
 
 	}
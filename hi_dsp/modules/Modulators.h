@@ -368,8 +368,23 @@ public:
 	void setScratchBuffer(float* scratchBuffer, int numSamples)
 	{
 		internalBuffer.setDataToReferTo(&scratchBuffer, 1, numSamples);
+		blockIsConstant = false;
 	}
 
+	/** Returns true if the last calculated block was flagged with setBlockIsConstant(). */
+	bool isBlockConstant() const noexcept { return blockIsConstant; }
+
+	/** Sets the number of audio samples per calculated modulation value.
+	*
+	*	It must be a power of two and can't be bigger than HISE_EVENT_RASTER (bigger values are clamped), because
+	*	every sub block must start at a control rate value. It will be used to calculate the control rate in the
+	*	next prepareToPlay() call. Normally the ModulatorChain sets this for its children.
+	*/
+	virtual void setControlRateDivisor(int newDivisor);
+
+	/** Returns the number of audio samples per calculated modulation value. */
+	int getControlRateDivisor() const noexcept { return controlRateDivisor; }
+
 protected:
 
 	TimeModulation(Mode m);
@@ -381,6 +396,17 @@ protected:
 	/** Checks if the prepareToPlay method has been called. */
 	virtual bool isInitialized();
 
+	/** Call this from calculateBlock() if every value in the block is the given value.
+	*
+	*	The intensity will then be applied with a single multiplication (or skipped altogether) instead of
+	*	processing the whole buffer and the modulator chain can treat the result as constant.
+	*/
+	void setBlockIsConstant(float constantValue) noexcept
+	{
+		blockIsConstant = true;
+		constantBlockValue = constantValue;
+	}
+
 	/** a vectorized version of the calcIntensityValue() and applyModulationValue() for Gain modulation with a fixed intensity value. */
 	void applyGainModulation(float *calculatedModulationValues, float *destinationValues, float fixedIntensity, int numValues) const noexcept;
 
@@ -437,8 +463,13 @@ private:
 
 	double controlRate = 0.0;
 
+	int controlRateDivisor = HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+
 	float lastConstantValue = 1.0f;
 
+	bool blockIsConstant = false;
+	float constantBlockValue = 1.0f;
+
 	
 };
 
@@ -1079,7 +1110,8 @@ class EnvelopeModulatorFactoryType: public FactoryType
 		tableEnvelope,
 		ccEnvelope,
 		scriptEnvelope,
-		mpeModulator
+		mpeModulator,
+		globalEnvelopeModulator
 	};
 
 public:
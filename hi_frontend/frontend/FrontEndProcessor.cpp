@@ -240,6 +240,10 @@ unlockCounter(0)
     
 	LOG_START("Load images");
     restorePool(imageData, FileHandlerBase::Images, "ImageResources.dat");
+
+#if HISE_DECODE_EMBEDDED_IMAGES_IN_PARALLEL
+    getCurrentImagePool(true)->loadAllFilesFromDataProvider(true);
+#endif
     
    	LOG_START("Load embedded audio files");
     restorePool(impulseData, FileHandlerBase::AudioFiles, "AudioResources.dat");
@@ -32,6 +32,19 @@
 
 #include "hi_lac.h"
 
+#if JUCE_LINUX || JUCE_MAC || JUCE_IOS
+#include <sys/mman.h>
+#include <unistd.h>
+#elif JUCE_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
 #include "hlac/BitCompressors.cpp"
 #include "hlac/CompressionHelpers.cpp"
 #include "hlac/SampleBuffer.cpp"
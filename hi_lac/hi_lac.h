@@ -113,6 +113,20 @@ If enabled, then the unit test suite will be compiled and added to all unit test
 #define HLAC_INCLUDE_TEST_SUITE 0
 #endif
 
+//=============================================================================
+/** Config: HLAC_USE_SIMD_DECODING
+
+If enabled, the decoder uses SSE2 kernels for the bit unpacking, the diff reconstruction
+and the int16 -> float conversion. The output is identical to the scalar code.
+*/
+#ifndef HLAC_USE_SIMD_DECODING
+#if JUCE_IOS
+#define HLAC_USE_SIMD_DECODING 0
+#else
+#define HLAC_USE_SIMD_DECODING 1
+#endif
+#endif
+
 
 #include "hlac/BitCompressors.h"
 #include "hlac/CompressionHelpers.h"
@@ -147,6 +147,56 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 
 }
 
+#if HLAC_USE_SIMD_DECODING
+
+/** Unpacks eight offset-binary values from the packed uint16 words.
+*
+*	Every lane of a contains the word where the value starts and b contains the word after it.
+*	The multiplier m holds 2^(bit offset of the value in a) for every lane so that the low
+*	multiplication shifts the start word to the left and the high multiplication moves the
+*	remaining bits of the next word into the lower part.
+*/
+template <int BitDepth> static inline __m128i unpackEightValues(__m128i a, __m128i b, __m128i m)
+{
+	const __m128i window = _mm_or_si128(_mm_mullo_epi16(a, m), _mm_mulhi_epu16(b, m));
+	const __m128i values = _mm_srli_epi16(window, 16 - BitDepth);
+
+	return _mm_sub_epi16(values, _mm_set1_epi16((int16)((1 << (BitDepth - 1)) - 1)));
+}
+
+#endif
+
+/** Lookup tables that decode a whole byte of sign-magnitude values at once. */
+struct SignMagnitudeTables
+{
+	SignMagnitudeTables()
+	{
+		for (int i = 0; i < 256; i++)
+		{
+			for (int j = 0; j < 4; j++)
+			{
+				const int v = (i >> (2 * j)) & 0b11;
+				twoBit[i][j] = (int16)((v & 0b01) * ((v & 0b10) != 0 ? -1 : 1));
+			}
+
+			for (int j = 0; j < 2; j++)
+			{
+				const int v = (i >> (4 * j)) & 0b1111;
+				fourBit[i][j] = (int16)((v & 0b0111) * ((v & 0b1000) != 0 ? -1 : 1));
+			}
+		}
+	}
+
+	static const SignMagnitudeTables& get()
+	{
+		static const SignMagnitudeTables tables;
+		return tables;
+	}
+
+	int16 twoBit[256][4];
+	int16 fourBit[256][2];
+};
+
 
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
@@ -321,28 +371,13 @@ bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, i
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
+	const auto& table = SignMagnitudeTables::get().twoBit;
+
 	while (numValuesToDecompress >= 4)
 	{
-		const uint8 byte = *data;
-
-		const int16 sign1 = ((byte & signMasks[0]) != 0) ? -1 : 1;
-		const int16 value1 = (int16)(byte & valueMasks[0]);
-
-		*destination++ = value1 * sign1;
-
-		const int16 sign2 = ((byte & signMasks[1]) != 0) ? -1 : 1;
-		const int16 value2 = (int16)((byte & valueMasks[1]) >> 2);
-
-		*destination++ = value2 * sign2;
-
-		const int16 sign3 = ((byte & signMasks[2]) != 0) ? -1 : 1;
-		const int16 value3 = (int16)((byte & valueMasks[2]) >> 4);
-
-		*destination++ = value3 * sign3;
-
-		const int16 sign4 = ((byte & signMasks[3]) != 0) ? -1 : 1;
-		*destination++ = (int16)((byte & valueMasks[3]) >> 6) * sign4;
+		memcpy(destination, table[*data], sizeof(int16) * 4);
 
+		destination += 4;
 		numValuesToDecompress -= 4;
 		++data;
 	};
@@ -436,20 +471,13 @@ bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data,
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
 	const uint8 valueMasks[2] = { 0b00000111, 0b01110000 };
 
+	const auto& table = SignMagnitudeTables::get().fourBit;
+
 	while (numValuesToDecompress >= 2)
 	{
-		const uint8 byte = *data;
-
-		const int16 sign1 = ((byte & signMasks[0]) != 0) ? -1 : 1;
-		const int16 value1 = (int16)(byte & valueMasks[0]);
-
-		*destination++ = value1 * sign1;
-
-		const int16 sign2 = ((byte & signMasks[1]) != 0) ? -1 : 1;
-		const int16 value2 = (int16)((byte & valueMasks[1]) >> 4);
-
-		*destination++ = value2 * sign2;
+		memcpy(destination, table[*data], sizeof(int16) * 2);
 
+		destination += 2;
 		numValuesToDecompress -= 2;
 		++data;
 	};
@@ -543,122 +571,27 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-#if JUCE_IOS
-	while (numValuesToDecompress >= 8)
+#if HLAC_USE_SIMD_DECODING
+
+	// 8 values => 3 words. The loop stops one group early because it reads a word past the group.
+
+	const __m128i m = _mm_setr_epi16(1 << 0, 1 << 6, 1 << 12, 1 << 2, 1 << 8, 1 << 14, 1 << 4, 1 << 10);
+
+	while (numValuesToDecompress >= 16)
 	{
-		decompress6Bit(destination, data);
+		const __m128i w = _mm_loadl_epi64((const __m128i*)data);
+
+		const __m128i a = _mm_unpacklo_epi64(_mm_shufflelo_epi16(w, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shufflelo_epi16(w, _MM_SHUFFLE(2, 2, 1, 1)));
+		const __m128i b = _mm_unpacklo_epi64(_mm_shufflelo_epi16(w, _MM_SHUFFLE(2, 1, 1, 1)), _mm_shufflelo_epi16(w, _MM_SHUFFLE(3, 3, 2, 2)));
+
+		_mm_storeu_si128((__m128i*)destination, unpackEightValues<6>(a, b, m));
 
 		destination += 8;
 		data += 6;
 		numValuesToDecompress -= 8;
 	}
-#else
-
-	while (numValuesToDecompress >= 64)
-	{
-		const uint16* dataBlock = reinterpret_cast<const uint16*>(data);
 
-		destination[0] = (dataBlock[0] & 0b1111110000000000) >> 10;
-		destination[1] = (dataBlock[0] & 0b0000001111110000) >> 4;
-		destination[2] = (dataBlock[0] & 0b0000000000001111) << 2;
-		destination[2] |= (dataBlock[1] & 0b1100000000000000) >> 14;
-		destination[3] = (dataBlock[1] & 0b0011111100000000) >> 8;
-		destination[4] = (dataBlock[1] & 0b0000000011111100) >> 2;
-		destination[5] = (dataBlock[1] & 0b0000000000000011) << 4;
-		destination[5] |= (dataBlock[2] & 0b1111000000000000) >> 12;
-		destination[6] = (dataBlock[2] & 0b0000111111000000) >> 6;
-		destination[7] = (dataBlock[2] & 0b0000000000111111);
-
-		destination[8 + 0] =  (dataBlock[3 + 0] & 0b1111110000000000) >> 10;
-		destination[8 + 1] =  (dataBlock[3 + 0] & 0b0000001111110000) >> 4;
-		destination[8 + 2] =  (dataBlock[3 + 0] & 0b0000000000001111) << 2;
-		destination[8 + 2] |= (dataBlock[3 + 1] & 0b1100000000000000) >> 14;
-		destination[8 + 3] =  (dataBlock[3 + 1] & 0b0011111100000000) >> 8;
-		destination[8 + 4] =  (dataBlock[3 + 1] & 0b0000000011111100) >> 2;
-		destination[8 + 5] =  (dataBlock[3 + 1] & 0b0000000000000011) << 4;
-		destination[8 + 5] |= (dataBlock[3 + 2] & 0b1111000000000000) >> 12;
-		destination[8 + 6] =  (dataBlock[3 + 2] & 0b0000111111000000) >> 6;
-		destination[8 + 7] =  (dataBlock[3 + 2] & 0b0000000000111111);
-
-		destination[16 + 0] =  (dataBlock[6 + 0] & 0b1111110000000000) >> 10;
-		destination[16 + 1] =  (dataBlock[6 + 0] & 0b0000001111110000) >> 4;
-		destination[16 + 2] =  (dataBlock[6 + 0] & 0b0000000000001111) << 2;
-		destination[16 + 2] |= (dataBlock[6 + 1] & 0b1100000000000000) >> 14;
-		destination[16 + 3] =  (dataBlock[6 + 1] & 0b0011111100000000) >> 8;
-		destination[16 + 4] =  (dataBlock[6 + 1] & 0b0000000011111100) >> 2;
-		destination[16 + 5] =  (dataBlock[6 + 1] & 0b0000000000000011) << 4;
-		destination[16 + 5] |= (dataBlock[6 + 2] & 0b1111000000000000) >> 12;
-		destination[16 + 6] =  (dataBlock[6 + 2] & 0b0000111111000000) >> 6;
-		destination[16 + 7] =  (dataBlock[6 + 2] & 0b0000000000111111);
-
-		destination[24 + 0] =  (dataBlock[9 + 0] & 0b1111110000000000) >> 10;
-		destination[24 + 1] =  (dataBlock[9 + 0] & 0b0000001111110000) >> 4;
-		destination[24 + 2] =  (dataBlock[9 + 0] & 0b0000000000001111) << 2;
-		destination[24 + 2] |= (dataBlock[9 + 1] & 0b1100000000000000) >> 14;
-		destination[24 + 3] =  (dataBlock[9 + 1] & 0b0011111100000000) >> 8;
-		destination[24 + 4] =  (dataBlock[9 + 1] & 0b0000000011111100) >> 2;
-		destination[24 + 5] =  (dataBlock[9 + 1] & 0b0000000000000011) << 4;
-		destination[24 + 5] |= (dataBlock[9 + 2] & 0b1111000000000000) >> 12;
-		destination[24 + 6] =  (dataBlock[9 + 2] & 0b0000111111000000) >> 6;
-		destination[24 + 7] =  (dataBlock[9 + 2] & 0b0000000000111111);
-
-		destination[32 + 0] =  (dataBlock[12 + 0] & 0b1111110000000000) >> 10;
-		destination[32 + 1] =  (dataBlock[12 + 0] & 0b0000001111110000) >> 4;
-		destination[32 + 2] =  (dataBlock[12 + 0] & 0b0000000000001111) << 2;
-		destination[32 + 2] |= (dataBlock[12 + 1] & 0b1100000000000000) >> 14;
-		destination[32 + 3] =  (dataBlock[12 + 1] & 0b0011111100000000) >> 8;
-		destination[32 + 4] =  (dataBlock[12 + 1] & 0b0000000011111100) >> 2;
-		destination[32 + 5] =  (dataBlock[12 + 1] & 0b0000000000000011) << 4;
-		destination[32 + 5] |= (dataBlock[12 + 2] & 0b1111000000000000) >> 12;
-		destination[32 + 6] =  (dataBlock[12 + 2] & 0b0000111111000000) >> 6;
-		destination[32 + 7] =  (dataBlock[12 + 2] & 0b0000000000111111);
-
-		destination[40 + 0] =  (dataBlock[15 + 0] & 0b1111110000000000) >> 10;
-		destination[40 + 1] =  (dataBlock[15 + 0] & 0b0000001111110000) >> 4;
-		destination[40 + 2] =  (dataBlock[15 + 0] & 0b0000000000001111) << 2;
-		destination[40 + 2] |= (dataBlock[15 + 1] & 0b1100000000000000) >> 14;
-		destination[40 + 3] =  (dataBlock[15 + 1] & 0b0011111100000000) >> 8;
-		destination[40 + 4] =  (dataBlock[15 + 1] & 0b0000000011111100) >> 2;
-		destination[40 + 5] =  (dataBlock[15 + 1] & 0b0000000000000011) << 4;
-		destination[40 + 5] |= (dataBlock[15 + 2] & 0b1111000000000000) >> 12;
-		destination[40 + 6] =  (dataBlock[15 + 2] & 0b0000111111000000) >> 6;
-		destination[40 + 7] =  (dataBlock[15 + 2] & 0b0000000000111111);
-
-		destination[48 + 0] =  (dataBlock[18 + 0] & 0b1111110000000000) >> 10;
-		destination[48 + 1] =  (dataBlock[18 + 0] & 0b0000001111110000) >> 4;
-		destination[48 + 2] =  (dataBlock[18 + 0] & 0b0000000000001111) << 2;
-		destination[48 + 2] |= (dataBlock[18 + 1] & 0b1100000000000000) >> 14;
-		destination[48 + 3] =  (dataBlock[18 + 1] & 0b0011111100000000) >> 8;
-		destination[48 + 4] =  (dataBlock[18 + 1] & 0b0000000011111100) >> 2;
-		destination[48 + 5] =  (dataBlock[18 + 1] & 0b0000000000000011) << 4;
-		destination[48 + 5] |= (dataBlock[18 + 2] & 0b1111000000000000) >> 12;
-		destination[48 + 6] =  (dataBlock[18 + 2] & 0b0000111111000000) >> 6;
-		destination[48 + 7] =  (dataBlock[18 + 2] & 0b0000000000111111);
-
-		destination[56 + 0] =  (dataBlock[21 + 0] & 0b1111110000000000) >> 10;
-		destination[56 + 1] =  (dataBlock[21 + 0] & 0b0000001111110000) >> 4;
-		destination[56 + 2] =  (dataBlock[21 + 0] & 0b0000000000001111) << 2;
-		destination[56 + 2] |= (dataBlock[21 + 1] & 0b1100000000000000) >> 14;
-		destination[56 + 3] =  (dataBlock[21 + 1] & 0b0011111100000000) >> 8;
-		destination[56 + 4] =  (dataBlock[21 + 1] & 0b0000000011111100) >> 2;
-		destination[56 + 5] =  (dataBlock[21 + 1] & 0b0000000000000011) << 4;
-		destination[56 + 5] |= (dataBlock[21 + 2] & 0b1111000000000000) >> 12;
-		destination[56 + 6] =  (dataBlock[21 + 2] & 0b0000111111000000) >> 6;
-		destination[56 + 7] =  (dataBlock[21 + 2] & 0b0000000000111111);
-
-		unpackArrayOfInt16(destination, 8, 6);
-		unpackArrayOfInt16(destination+8, 8, 6);
-		unpackArrayOfInt16(destination+16, 8, 6);
-		unpackArrayOfInt16(destination+24, 8, 6);
-		unpackArrayOfInt16(destination+32, 8, 6);
-		unpackArrayOfInt16(destination+40, 8, 6);
-		unpackArrayOfInt16(destination+48, 8, 6);
-		unpackArrayOfInt16(destination+56, 8, 6);
-		
-		destination += 64;
-		data += 48;
-		numValuesToDecompress -= 64;
-	}
+#endif
 
 	while (numValuesToDecompress >= 8)
 	{
@@ -668,7 +601,6 @@ bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, i
 		data += 6;
 		numValuesToDecompress -= 8;
 	}
-#endif
 
 	memcpy(destination, data, sizeof(int16) * numValuesToDecompress);
 
@@ -703,7 +635,24 @@ bool BitCompressors::EightBit::compress(uint8* destination, const int16* data, i
 
 bool BitCompressors::EightBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-    while (--numValuesToDecompress >= 0)
+#if HLAC_USE_SIMD_DECODING
+
+	while (numValuesToDecompress >= 16)
+	{
+		const __m128i b = _mm_loadu_si128((const __m128i*)data);
+
+		// moves every byte into the upper half and shifts it back to extend the sign
+		_mm_storeu_si128((__m128i*)destination, _mm_srai_epi16(_mm_unpacklo_epi8(b, b), 8));
+		_mm_storeu_si128((__m128i*)(destination + 8), _mm_srai_epi16(_mm_unpackhi_epi8(b, b), 8));
+
+		destination += 16;
+		data += 16;
+		numValuesToDecompress -= 16;
+	}
+
+#endif
+
+	while (--numValuesToDecompress >= 0)
 	{
 		const int8 value = *reinterpret_cast<const int8*>(data++);
 		*destination++ = (int16)value;
@@ -790,6 +739,29 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+#if HLAC_USE_SIMD_DECODING
+
+	// 8 values => 5 words. The loop stops one group early because it reads a word past the group.
+
+	const __m128i m = _mm_setr_epi16(1 << 0, 1 << 10, 1 << 4, 1 << 14, 1 << 8, 1 << 2, 1 << 12, 1 << 6);
+
+	while (numValuesToDecompress >= 16)
+	{
+		const __m128i w1 = _mm_loadl_epi64((const __m128i*)data);
+		const __m128i w2 = _mm_loadl_epi64((const __m128i*)(data + 4));
+
+		const __m128i a = _mm_unpacklo_epi64(_mm_shufflelo_epi16(w1, _MM_SHUFFLE(1, 1, 0, 0)), _mm_shufflelo_epi16(w2, _MM_SHUFFLE(2, 1, 1, 0)));
+		const __m128i b = _mm_unpacklo_epi64(_mm_shufflelo_epi16(w1, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shufflelo_epi16(w2, _MM_SHUFFLE(3, 2, 2, 1)));
+
+		_mm_storeu_si128((__m128i*)destination, unpackEightValues<10>(a, b, m));
+
+		destination += 8;
+		data += 10;
+		numValuesToDecompress -= 8;
+	}
+
+#endif
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -886,6 +858,29 @@ bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data
 
 	int16* dst = destination;
 
+#if HLAC_USE_SIMD_DECODING
+
+	// 4 values => 3 words. The loop stops one group early because it reads a word past the groups.
+
+	const __m128i m = _mm_setr_epi16(1 << 0, 1 << 12, 1 << 8, 1 << 4, 1 << 0, 1 << 12, 1 << 8, 1 << 4);
+
+	while (numValuesToDecompress >= 12)
+	{
+		const __m128i w1 = _mm_loadl_epi64((const __m128i*)data);
+		const __m128i w2 = _mm_loadl_epi64((const __m128i*)(data + 6));
+
+		const __m128i a = _mm_unpacklo_epi64(_mm_shufflelo_epi16(w1, _MM_SHUFFLE(2, 1, 0, 0)), _mm_shufflelo_epi16(w2, _MM_SHUFFLE(2, 1, 0, 0)));
+		const __m128i b = _mm_unpacklo_epi64(_mm_shufflelo_epi16(w1, _MM_SHUFFLE(3, 2, 1, 1)), _mm_shufflelo_epi16(w2, _MM_SHUFFLE(3, 2, 1, 1)));
+
+		_mm_storeu_si128((__m128i*)dst, unpackEightValues<12>(a, b, m));
+
+		dst += 8;
+		data += 12;
+		numValuesToDecompress -= 8;
+	}
+
+#endif
+
 	while (numValuesToDecompress >= 4)
 	{
 		const uint16* dataBlock = reinterpret_cast<const uint16*>(data);
@@ -1002,6 +997,28 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+#if HLAC_USE_SIMD_DECODING
+
+	// 8 values => 7 words. Every value except the first starts in the word before it,
+	// so the start words are the loaded words shifted by one lane.
+
+	const __m128i m = _mm_setr_epi16(1 << 0, 1 << 14, 1 << 12, 1 << 10, 1 << 8, 1 << 6, 1 << 4, 1 << 2);
+	const __m128i firstLane = _mm_setr_epi16(-1, 0, 0, 0, 0, 0, 0, 0);
+
+	while (numValuesToDecompress >= 16)
+	{
+		const __m128i b = _mm_loadu_si128((const __m128i*)data);
+		const __m128i a = _mm_or_si128(_mm_slli_si128(b, 2), _mm_and_si128(b, firstLane));
+
+		_mm_storeu_si128((__m128i*)destination, unpackEightValues<14>(a, b, m));
+
+		destination += 8;
+		data += 14;
+		numValuesToDecompress -= 8;
+	}
+
+#endif
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
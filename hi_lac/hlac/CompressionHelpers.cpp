@@ -517,53 +517,62 @@ void CompressionHelpers::dump(const AudioSampleBuffer& b, String fileName)
 }
 
 
-void CompressionHelpers::fastInt16ToFloat(const void* source, float* dest, int numSamples)
+#if HLAC_USE_SIMD_DECODING
+
+/** Converts eight int16 values to float and multiplies them with the given factor. */
+static inline void int16ToFloatSSE(const int16* source, float* dest, __m128 factor)
 {
-#if !JUCE_WINDOWS
+	const __m128i a = _mm_loadu_si128((const __m128i*)source);
 
-	AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
+	// sign extend to 32 bit by moving the values into the upper half
+	const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+	const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
 
+	_mm_storeu_ps(dest, _mm_mul_ps(_mm_cvtepi32_ps(lo), factor));
+	_mm_storeu_ps(dest + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), factor));
+}
+
+/** Divides the 32 bit values the same way as the scalar Diff code of the respective platform.
+*
+*	The Windows version always used an arithmetic shift (which rounds towards negative infinity)
+*	and the other platforms use the division operator (which rounds towards zero).
+*	The decoder must use the same rounding as the encoder, so this can't be unified.
+*/
+template <int Shift> static inline __m128i diffDivide(__m128i x)
+{
+#if JUCE_WINDOWS
+	return _mm_srai_epi32(x, Shift);
 #else
+	const __m128i offset = _mm_and_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32((1 << Shift) - 1));
+	return _mm_srai_epi32(_mm_add_epi32(x, offset), Shift);
+#endif
+}
 
-	if (SystemStats::hasSSE41())
-	{
-		uint64 alignOffsetFloat = reinterpret_cast<uint64>(dest) % 16;
-		uint64 alignOffsetInt = reinterpret_cast<uint64>(source) % 16;
+#endif
 
-		if (alignOffsetFloat == 0 && alignOffsetInt == 0)
-		{
-			const int16* intData = static_cast<const int16*> (source);
-			const float scale = 1.0f / 0x7fff;
+void CompressionHelpers::fastInt16ToFloat(const void* source, float* dest, int numSamples)
+{
+#if HLAC_USE_SIMD_DECODING
 
-			__m128 s = _mm_set1_ps(scale);
+	// Uses the same scale factor as AudioDataConverters::convertInt16LEToFloat so the result is identical.
 
-			const int numSingle = (numSamples % 4);
-			const int numSSE = numSamples - numSingle;
+	const int16* intData = static_cast<const int16*> (source);
+	const float scale = 1.0f / 0x7fff;
 
-			for (int i = 0; i < numSSE; i += 4)
-			{
-				__m128i a = _mm_loadl_epi64((__m128i*)(intData + i));
-				a = _mm_cvtepi16_epi32(a);
-				__m128 a_f = _mm_cvtepi32_ps(a);
-				a_f = _mm_mul_ps(a_f, s);
-				_mm_store_ps(dest + i, a_f);
-			}
+	const __m128 s = _mm_set1_ps(scale);
+
+	const int numSSE = numSamples - (numSamples % 8);
+
+	for (int i = 0; i < numSSE; i += 8)
+		int16ToFloatSSE(intData + i, dest + i, s);
+
+	for (int i = numSSE; i < numSamples; i++)
+		dest[i] = scale * intData[i];
+
+#else
+
+	AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
 
-			for (int i = 0; i < numSingle; i++)
-			{
-				dest[i + numSSE] = scale * intData[i + numSSE];
-			}
-		}
-		else
-		{
-			AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
-		}
-	}
-	else
-	{
-		AudioDataConverters::convertInt16LEToFloat(source, dest, numSamples);
-	}
-    
 #endif
 }
 
@@ -902,80 +911,41 @@ void CompressionHelpers::Diff::distributeFullSamples(AudioBufferInt16& dst, cons
 	int thisValue = 0;
 	int nextValue = 0;
 
-#if !JUCE_WINDOWS
+	int i = 0;
 
-	for (int i = 0; i < numSamples - 2; i++)
-	{
-		thisValue = (int)r[i];
-		nextValue = (int)r[i + 1];
+#if HLAC_USE_SIMD_DECODING
 
-		d[0] = (int16)(thisValue);
-		d[1] = (int16)((3 * thisValue + nextValue) / 4);
-		d[2] = (int16)((thisValue + nextValue) / 2);
-		d[3] = (int16)((thisValue + 3 * nextValue) / 4);
+	// The last few values are calculated by the scalar loop below (this must stay
+	// like this because the old Windows SSE code did it the same way).
 
-		d += 4;
-	}
-
-#else
-
-	if (SystemStats::hasSSE41())
+	for (; i < numSamples - 9; i += 4)
 	{
-		for (int i = 0; i < numSamples - 9; i += 4)
-		{
-			__m128i a = _mm_loadl_epi64((const __m128i*)(r + i));
-			__m128i b = _mm_loadl_epi64((const __m128i*)(r + i + 1));
-			const __m128i mul3 = _mm_set1_epi32(3);
-
-			a = _mm_cvtepi16_epi32(a);
-			b = _mm_cvtepi16_epi32(b);
-
-			auto v1 = a;
+		const __m128i a16 = _mm_loadl_epi64((const __m128i*)(r + i));
+		const __m128i b16 = _mm_loadl_epi64((const __m128i*)(r + i + 1));
 
-			auto v2 = _mm_mullo_epi32(a, mul3);
-			v2 = _mm_add_epi32(v2, b);
-			v2 = _mm_srai_epi32(v2, 2);
+		const __m128i a = _mm_srai_epi32(_mm_unpacklo_epi16(a16, a16), 16);
+		const __m128i b = _mm_srai_epi32(_mm_unpacklo_epi16(b16, b16), 16);
 
-			auto v3 = _mm_add_epi32(a, b);
-			v3 = _mm_srai_epi32(v3, 1);
+		const __m128i v2 = diffDivide<2>(_mm_add_epi32(_mm_add_epi32(a, _mm_slli_epi32(a, 1)), b));
+		const __m128i v3 = diffDivide<1>(_mm_add_epi32(a, b));
+		const __m128i v4 = diffDivide<2>(_mm_add_epi32(_mm_add_epi32(b, _mm_slli_epi32(b, 1)), a));
 
-			auto v4 = _mm_mullo_epi32(b, mul3);
-			v4 = _mm_add_epi32(v4, a);
-			v4 = _mm_srai_epi32(v4, 2);
+		// The results are within the int16 range so the saturation doesn't kick in.
+		const __m128i p1 = _mm_packs_epi32(a, v3);
+		const __m128i p2 = _mm_packs_epi32(v2, v4);
 
-			const uint8 z = 0x80;
+		const __m128i lo = _mm_unpacklo_epi16(p1, p2); // a0 v2_0 a1 v2_1...
+		const __m128i hi = _mm_unpackhi_epi16(p1, p2); // v3_0 v4_0 v3_1 v4_1...
 
-			const __m128i mask1a = _mm_set_epi8(z, z, z, z, z, z, 5, 4, z, z, z, z, z, z, 1, 0);
-			const __m128i mask1b = _mm_set_epi8(z, z, z, z, z, z, 13, 12, z, z, z, z, z, z, 9, 8);
-			const __m128i mask2a = _mm_set_epi8(z, z, z, z, 5, 4, z, z, z, z, z, z, 1, 0, z, z);
-			const __m128i mask2b = _mm_set_epi8(z, z, z, z, 13, 12, z, z, z, z, z, z, 9, 8, z, z);
-			const __m128i mask3a = _mm_set_epi8(z, z, 5, 4, z, z, z, z, z, z, 1, 0, z, z, z, z);
-			const __m128i mask3b = _mm_set_epi8(z, z, 13, 12, z, z, z, z, z, z, 9, 8, z, z, z, z);
-			const __m128i mask4a = _mm_set_epi8(5, 4, z, z, z, z, z, z, 1, 0, z, z, z, z, z, z);
-			const __m128i mask4b = _mm_set_epi8(13, 12, z, z, z, z, z, z, 9, 8, z, z, z, z, z, z);
+		_mm_store_si128((__m128i*)d, _mm_unpacklo_epi32(lo, hi));
+		_mm_store_si128((__m128i*)(d + 8), _mm_unpackhi_epi32(lo, hi));
 
-			const __m128i d1a = _mm_shuffle_epi8(v1, mask1a);
-			const __m128i d1b = _mm_shuffle_epi8(v2, mask2a);
-			const __m128i d1c = _mm_shuffle_epi8(v3, mask3a);
-			const __m128i d1d = _mm_shuffle_epi8(v4, mask4a);
-
-			const __m128i d1 = _mm_or_si128(_mm_or_si128(d1a, d1b), _mm_or_si128(d1c, d1d));
-
-			const __m128i d2a = _mm_shuffle_epi8(v1, mask1b);
-			const __m128i d2b = _mm_shuffle_epi8(v2, mask2b);
-			const __m128i d2c = _mm_shuffle_epi8(v3, mask3b);
-			const __m128i d2d = _mm_shuffle_epi8(v4, mask4b);
-
-			const __m128i d2 = _mm_or_si128(_mm_or_si128(d2a, d2b), _mm_or_si128(d2c, d2d));
-
-			_mm_store_si128((__m128i*)d, d1);
-			_mm_store_si128((__m128i*)(d + 8), d2);
-
-			d += 16;
-		}
+		d += 16;
 	}
 
-	for (int i = numSamples - 9; i < numSamples - 2; i++)
+#endif
+
+	for (; i < numSamples - 2; i++)
 	{
 		thisValue = (int)r[i];
 		nextValue = (int)r[i + 1];
@@ -988,8 +958,6 @@ void CompressionHelpers::Diff::distributeFullSamples(AudioBufferInt16& dst, cons
 		d += 4;
 	}
 
-#endif
-
 	thisValue = r[numSamples - 2];
 	nextValue = r[numSamples - 1];
 	
@@ -1010,72 +978,47 @@ void CompressionHelpers::Diff::addErrorSignal(AudioBufferInt16& dst, const uint1
 
 	int16* e = const_cast<int16*>(reinterpret_cast<const int16*>(errorSignalPacked));
 
-	int counter = 0;
+#if HLAC_USE_SIMD_DECODING
 
-#if !JUCE_WINDOWS
+	// Every four samples contain one full value and three error values: [0 e0 e1 e2 0 e3 e4 e5]
+	const __m128i errorLanes = _mm_setr_epi16(0, -1, -1, -1, 0, 0, 0, 0);
 
-	while (numSamples > 2)
+	// Stops early because it reads one value past the 12 values and the last two are added below.
+	while (numSamples >= 14)
 	{
-		counter += 4;
+		const __m128i e1 = _mm_and_si128(_mm_slli_si128(_mm_loadl_epi64((const __m128i*)e), 2), errorLanes);
+		const __m128i e2 = _mm_slli_si128(_mm_loadl_epi64((const __m128i*)(e + 3)), 10);
+		const __m128i e3 = _mm_and_si128(_mm_slli_si128(_mm_loadl_epi64((const __m128i*)(e + 6)), 2), errorLanes);
+		const __m128i e4 = _mm_slli_si128(_mm_loadl_epi64((const __m128i*)(e + 9)), 10);
 
-		d[1] -= e[0];
-		d[2] -= e[1];
-		d[3] -= e[2];
+		const __m128i a1 = _mm_load_si128((const __m128i*)d);
+		const __m128i a2 = _mm_load_si128((const __m128i*)(d + 8));
 
-		d += 4;
-		e += 3;
+		_mm_store_si128((__m128i*)d, _mm_sub_epi16(a1, _mm_or_si128(e1, e2)));
+		_mm_store_si128((__m128i*)(d + 8), _mm_sub_epi16(a2, _mm_or_si128(e3, e4)));
 
-		numSamples -= 3;
-	}
+		d += 16;
+		e += 12;
 
-	d[1] -= e[0];
-	d[2] -= e[1];
+		numSamples -= 12;
+	}
 
-#else
+#endif
 
 	while (numSamples > 2)
 	{
-		// SSE 3.0 should be available everywhere by now...
-
-		counter += 16;
-
-		__m128i a1 = _mm_load_si128((__m128i*)d);
-		__m128i a2 = _mm_load_si128((__m128i*)(d+8));
-
-		__m128i b1 = _mm_loadl_epi64((__m128i*)e);
-		__m128i b2 = _mm_loadl_epi64((__m128i*)(e+3));
-		__m128i b3 = _mm_loadl_epi64((__m128i*)(e+6));
-		__m128i b4 = _mm_loadl_epi64((__m128i*)(e+9));
-
-		const uint8 z = 0x80;
-
-		const __m128i mask = _mm_set_epi8 (z, z, z, z, z, z, z, z, 5, 4, 3, 2, 1, 0, z, z);
-		const __m128i mask2 = _mm_set_epi8(5, 4, 3, 2, 1, 0, z, z, z, z, z, z, z, z, z, z);
-
-		__m128i ba = _mm_shuffle_epi8(b1, mask);
-		ba = _mm_or_si128(ba, _mm_shuffle_epi8(b2, mask2));
-
-		__m128i bb = _mm_shuffle_epi8(b3, mask);
-		bb = _mm_or_si128(bb, _mm_shuffle_epi8(b4, mask2));
-
-		a1 = _mm_sub_epi16(a1, ba);
-		a2 = _mm_sub_epi16(a2, bb);
-
-		_mm_store_si128((__m128i*)d, a1);
-		_mm_store_si128((__m128i*)(d+8), a2);
-
-		d += 16;
-		e += 12;
+		d[1] -= e[0];
+		d[2] -= e[1];
+		d[3] -= e[2];
 
-		numSamples -= 12;
+		d += 4;
+		e += 3;
 
+		numSamples -= 3;
 	}
 
 	d[1] -= e[0];
 	d[2] -= e[1];
-
-
-#endif
 }
 
 uint64 CompressionHelpers::Misc::NumberOfSetBits(uint64 i)
@@ -1711,7 +1654,28 @@ void CompressionHelpers::NormaliseMap::normalisedInt16ToFloat(float* destination
 		{
 			float gainFactor = (float)(1 << thisAmount);
 
-			for (int i = 0; i < numThisTime; i++)
+			int i = 0;
+
+#if HLAC_USE_SIMD_DECODING
+
+			// The division is also exact in SSE, so this yields the same values as the loop below.
+
+			const __m128 divisor = _mm_set1_ps((float)INT16_MAX * gainFactor);
+
+			for (; i < numThisTime - 7; i += 8)
+			{
+				const __m128i a = _mm_loadu_si128((const __m128i*)(r + i));
+
+				const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+				const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16);
+
+				_mm_storeu_ps(w + i, _mm_div_ps(_mm_cvtepi32_ps(lo), divisor));
+				_mm_storeu_ps(w + i + 4, _mm_div_ps(_mm_cvtepi32_ps(hi), divisor));
+			}
+
+#endif
+
+			for (; i < numThisTime; i++)
 			{
 				w[i] = (float)r[i] / ((float)INT16_MAX * gainFactor);
 			}
@@ -448,6 +448,71 @@ bool HlacMemoryMappedAudioFormatReader::mapSectionOfFile(Range<int64> samplesToM
 	}
 }
 
+void HlacMemoryMappedAudioFormatReader::prefetch(int64 startSampleInFile, int numSamples)
+{
+	if (map == nullptr || numSamples <= 0 || startSampleInFile < 0 || startSampleInFile >= lengthInSamples)
+		return;
+
+	const int64 endSampleInFile = jmin<int64>(lengthInSamples, startSampleInFile + numSamples);
+
+	Range<int64> byteRange;
+
+	if (isMonolith)
+	{
+		byteRange = { sampleToFilePos(startSampleInFile), sampleToFilePos(endSampleInFile) };
+	}
+	else
+	{
+		auto& header = internalReader.header;
+
+		const int64 start = (int64)header.getOffsetForReadPosition(startSampleInFile, true);
+		const bool isLastBlock = (endSampleInFile / COMPRESSION_BLOCK_SIZE) >= (int64)header.getBlockAmount() - 1;
+		const int64 end = isLastBlock ? getFile().getSize() : (int64)header.getOffsetForNextBlock(endSampleInFile, true);
+
+		byteRange = { start, end };
+	}
+
+	byteRange = byteRange.getIntersectionWith(map->getRange());
+
+	if (!byteRange.isEmpty())
+	{
+		auto data = addBytesToPointer(map->getData(), byteRange.getStart() - map->getRange().getStart());
+		prefetchMemory(data, (size_t)byteRange.getLength());
+	}
+}
+
+void HlacMemoryMappedAudioFormatReader::prefetchMemory(const void* data, size_t numBytes) noexcept
+{
+#if JUCE_LINUX || JUCE_MAC || JUCE_IOS
+	// madvise needs a page aligned address
+	static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+	auto start = (size_t)data & ~(pageSize - 1);
+	auto end = (size_t)data + numBytes;
+
+	madvise((void*)start, end - start, MADV_WILLNEED);
+#elif JUCE_WINDOWS
+	// PrefetchVirtualMemory() is only available on Windows 8 or newer, so it's loaded at runtime
+	struct MemoryRange
+	{
+		PVOID address;
+		SIZE_T numBytes;
+	};
+
+	using PrefetchFunction = BOOL(WINAPI*)(HANDLE, ULONG_PTR, MemoryRange*, ULONG);
+
+	static auto prefetchFunction = (PrefetchFunction)GetProcAddress(GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory");
+
+	if (prefetchFunction != nullptr)
+	{
+		MemoryRange range = { const_cast<void*>(data), (SIZE_T)numBytes };
+		prefetchFunction(GetCurrentProcess(), 1, &range, 0);
+	}
+#else
+	ignoreUnused(data, numBytes);
+#endif
+}
+
 void HlacMemoryMappedAudioFormatReader::setTargetAudioDataType(AudioDataConverters::DataFormat dataType)
 {
 	usesFloatingPointData = (dataType == AudioDataConverters::DataFormat::float32BE) ||
@@ -574,4 +639,10 @@ void HlacSubSectionReader::readIntoFixedBuffer(HiseSampleBuffer& buffer, int sta
 	}
 }
 
+void HlacSubSectionReader::prefetch(int64 readerStartSample, int numSamples)
+{
+	if (memoryReader != nullptr)
+		memoryReader->prefetch(start + readerStartSample, numSamples);
+}
+
 } // namespace hlac
@@ -179,6 +179,13 @@ public:
 
 	bool mapSectionOfFile(Range<int64> samplesToMap) override;
 
+	/** Tells the OS that the data for the given sample range will be read soon.
+	*
+	*	This returns immediately and lets the OS fetch the mapped pages in the background, so you can call this
+	*	for multiple upcoming reads to keep more requests in flight than a sequence of blocking page faults.
+	*/
+	void prefetch(int64 startSampleInFile, int numSamples);
+
 	void getSample(int64 /*sampleIndex*/, float* result) const noexcept override
 	{
 		// this should never be used
@@ -194,6 +201,8 @@ private:
 
 	static void copySampleData(int* const* destSamples, int startOffsetInDestBuffer, int numDestChannels, const void* sourceData, int numChannels, int numSamples) noexcept;
 
+	static void prefetchMemory(const void* data, size_t numBytes) noexcept;
+
 	bool copyFromMonolith(HiseSampleBuffer& destination, int startOffsetInBuffer, int numDestChannels, int64 offsetInFile, int numChannels, int numSamples);
 
 	ScopedPointer<MemoryInputStream> mis;
@@ -215,6 +224,9 @@ public:
 
 	void readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerStartSample);
 
+	/** Prefetches the given range if the source reader is memory mapped (it does nothing otherwise). */
+	void prefetch(int64 readerStartSample, int numSamples);
+
 private:
 
 	bool isMonolith = false;
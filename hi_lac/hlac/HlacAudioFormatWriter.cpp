@@ -56,6 +56,9 @@ bool HiseLosslessAudioFormatWriter::flush()
 	if (tempWasFlushed)
 		return true;
 
+	if (!encoder.flushPendingBlocks())
+		return false;
+
 	if (!writeHeader())
 		return false;
 
@@ -74,6 +77,11 @@ void HiseLosslessAudioFormatWriter::setOptions(HlacEncoder::CompressorOptions& n
 	encoder.setOptions(newOptions);
 }
 
+void HiseLosslessAudioFormatWriter::setNumEncoderThreads(int numThreadsToUse)
+{
+	encoder.setNumThreads(numThreadsToUse);
+}
+
 void HiseLosslessAudioFormatWriter::setEnableFullDynamics(bool shouldEnableFullDynamics)
 {
 	options.normalisationMode = shouldEnableFullDynamics ? 2 : 0;
@@ -58,6 +58,9 @@ public:
 
 	void setEnableFullDynamics(bool shouldEnableFullDynamics);
 
+	/** Encodes the data with multiple threads. The result will be the same, but it will be much faster on multicore machines. */
+	void setNumEncoderThreads(int numThreadsToUse);
+
 	bool write(const int** samplesToWrite, int numSamples) override;
 
 	double getCompressionRatioForLastFile() { return encoder.getCompressionRatio(); }
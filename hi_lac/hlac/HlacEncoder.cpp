@@ -45,6 +45,12 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	else
 		currentNormaliseBitShiftAmount = 0;
 
+	if (numThreads > 1)
+	{
+		addPendingBlocks(source, output, blockOffsetData);
+		return;
+	}
+
 	if (source.getNumSamples() == COMPRESSION_BLOCK_SIZE)
 	{
 		blockOffsetData[blockIndex] = numBytesWritten;
@@ -134,12 +140,163 @@ void HlacEncoder::reset()
 	bitRateForCurrentCycle = 0;
 	firstCycleLength = -1;
 	ratio = 0.0f;
+	pendingBlocks.clear();
 }
 
 
 HlacEncoder::~HlacEncoder()
 {
+	// You must call flushPendingBlocks() after the last compress() call...
+	jassert(pendingBlocks.isEmpty());
+}
+
+class HlacEncoder::BlockEncoderJob : public ThreadPoolJob
+{
+public:
+
+	BlockEncoderJob(HlacEncoder& parent_, std::atomic<int>& nextBlockIndex_) :
+		ThreadPoolJob("HLAC Block Encoder"),
+		parent(parent_),
+		nextBlockIndex(nextBlockIndex_)
+	{}
+
+	JobStatus runJob() override
+	{
+		parent.encodePendingBlocks(nextBlockIndex);
+		return jobHasFinished;
+	}
+
+private:
+
+	HlacEncoder& parent;
+	std::atomic<int>& nextBlockIndex;
+};
+
+void HlacEncoder::setNumThreads(int numThreadsToUse)
+{
+	// Flush the queue before changing the thread amount
+	jassert(pendingBlocks.isEmpty());
+
+	numThreads = jmax<int>(1, numThreadsToUse);
+
+	if (numThreads > 1)
+		threadPool = new ThreadPool(numThreads - 1);
+	else
+		threadPool = nullptr;
+}
+
+void HlacEncoder::addPendingBlocks(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData)
+{
+	jassert(pendingOutput == nullptr || pendingOutput == &output);
+
+	pendingOutput = &output;
+	pendingBlockOffsets = blockOffsetData;
+
+	const int numChannels = source.getNumChannels() == 2 ? 2 : 1;
+
+	int offset = 0;
+
+	while (offset < source.getNumSamples())
+	{
+		const int numThisTime = jmin<int>(COMPRESSION_BLOCK_SIZE, source.getNumSamples() - offset);
+
+		auto b = new PendingBlock();
+
+		b->data.setSize(numChannels, numThisTime);
+
+		for (int c = 0; c < numChannels; c++)
+			b->data.copyFrom(c, 0, source, c, offset, numThisTime);
+
+		b->isLastBlock = numThisTime < COMPRESSION_BLOCK_SIZE;
+		b->normaliseBitShiftAmount = currentNormaliseBitShiftAmount;
 
+		pendingBlocks.add(b);
+
+		offset += numThisTime;
+	}
+
+	// Keep enough blocks in the queue so that every thread has a few blocks to encode
+	if (pendingBlocks.size() >= numThreads * 16)
+		flushPendingBlocks();
+}
+
+void HlacEncoder::encodePendingBlocks(std::atomic<int>& nextBlockIndex)
+{
+	for (int i = nextBlockIndex++; i < pendingBlocks.size(); i = nextBlockIndex++)
+	{
+		auto b = pendingBlocks.getUnchecked(i);
+
+		// Use a fresh encoder for every block so that no state of the previous block leaks into this one
+		HlacEncoder blockEncoder;
+
+		blockEncoder.setOptions(options);
+		blockEncoder.deferChecksums = true;
+		blockEncoder.currentNormaliseBitShiftAmount = b->normaliseBitShiftAmount;
+
+		for (int c = 0; c < b->data.getNumChannels(); c++)
+		{
+			AudioSampleBuffer channel(b->data.getArrayOfWritePointers() + c, 1, b->data.getNumSamples());
+
+			if (b->isLastBlock)
+				blockEncoder.encodeLastBlock(channel, b->encodedData);
+			else
+				blockEncoder.encodeBlock(channel, b->encodedData);
+		}
+
+		b->checksumPositions.swapWith(blockEncoder.checksumPositions);
+		b->numBytesWritten = blockEncoder.numBytesWritten;
+		b->numBytesUncompressed = blockEncoder.numBytesUncompressed;
+	}
+}
+
+bool HlacEncoder::flushPendingBlocks()
+{
+	if (pendingBlocks.isEmpty())
+		return true;
+
+	std::atomic<int> nextBlockIndex(0);
+
+	OwnedArray<BlockEncoderJob> jobs;
+
+	for (int i = 0; i < numThreads - 1; i++)
+	{
+		jobs.add(new BlockEncoderJob(*this, nextBlockIndex));
+		threadPool->addJob(jobs.getLast(), false);
+	}
+
+	encodePendingBlocks(nextBlockIndex);
+
+	for (auto j : jobs)
+		threadPool->waitForJobToFinish(j, -1);
+
+	bool ok = true;
+
+	for (auto b : pendingBlocks)
+	{
+		pendingBlockOffsets[blockIndex] = numBytesWritten;
+		++blockIndex;
+
+		auto data = static_cast<const uint8*>(b->encodedData.getData());
+		int64 numWritten = 0;
+
+		// Create the checksums in the same order as the single threaded encoder
+		for (auto checksumPosition : b->checksumPositions)
+		{
+			ok &= pendingOutput->write(data + numWritten, (size_t)(checksumPosition - numWritten));
+			ok &= pendingOutput->writeInt((int)CompressionHelpers::Misc::createChecksum());
+
+			numWritten = checksumPosition + sizeof(uint32);
+		}
+
+		ok &= pendingOutput->write(data + numWritten, (size_t)((int64)b->encodedData.getDataSize() - numWritten));
+
+		numBytesWritten += b->numBytesWritten;
+		numBytesUncompressed += b->numBytesUncompressed;
+	}
+
+	pendingBlocks.clear();
+
+	return ok;
 }
 
 
@@ -333,7 +490,17 @@ uint8 HlacEncoder::getBitReductionAmountForMSEncoding(AudioSampleBuffer& block)
 
 bool HlacEncoder::writeChecksumBytesForBlock(OutputStream& output)
 {
-	
+	if (deferChecksums)
+	{
+		checksumPositions.add(output.getPosition());
+
+		if (!output.writeInt(0))
+			return false;
+
+		numBytesWritten += 4;
+		return true;
+	}
+
 	auto checkSum = CompressionHelpers::Misc::createChecksum();
 
 	if (!output.writeInt((int)checkSum))
@@ -444,7 +611,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForFull > 0)
 	{
 		MemoryBlock mbFull;
-		mbFull.setSize(numBytesForFull);
+		mbFull.setSize(numBytesForFull, true);
 		compressorFull->compress((uint8*)mbFull.getData(), packedBuffer.getReadPointer(), numFullValues);
 
 		if (!output.write(mbFull.getData(), numBytesForFull))
@@ -456,7 +623,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForError > 0)
 	{
 		MemoryBlock mbError;
-		mbError.setSize(numBytesForError);
+		mbError.setSize(numBytesForError, true);
 		compressorError->compress((uint8*)mbError.getData(), packedErrorBuffer.getReadPointer(), numErrorValues);
 
 		
@@ -141,8 +141,39 @@ public:
 
 	uint32 getNumBlocksWritten() const { return blockIndex; }
 
+	/** Sets the number of threads that are used to encode the blocks.
+	*
+	*	If this is bigger than 1, compress() only copies the blocks into a queue which is encoded in parallel
+	*	as soon as it is full (or when you call flushPendingBlocks()). The encoded blocks are written in their
+	*	original order and the checksums are created on the calling thread, so the data is the same as with
+	*	a single thread.
+	*/
+	void setNumThreads(int numThreadsToUse);
+
+	/** Encodes and writes all blocks that are waiting in the queue. You must call this after the last compress() call. */
+	bool flushPendingBlocks();
+
 private:
 
+	/** A block that waits for the parallel encoding. */
+	struct PendingBlock
+	{
+		AudioSampleBuffer data;
+		bool isLastBlock = false;
+		int normaliseBitShiftAmount = 0;
+
+		MemoryOutputStream encodedData;
+		Array<int64> checksumPositions;
+		uint32 numBytesWritten = 0;
+		uint32 numBytesUncompressed = 0;
+	};
+
+	class BlockEncoderJob;
+
+	void addPendingBlocks(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData);
+
+	void encodePendingBlocks(std::atomic<int>& nextBlockIndex);
+
 	bool encodeBlock(AudioSampleBuffer& block, OutputStream& output);
 
 	bool encodeBlock(CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
@@ -207,6 +238,17 @@ private:
 	uint64 readIndex = 0;
 
 	double decompressionSpeed = 0.0;
+
+	int numThreads = 1;
+	ScopedPointer<ThreadPool> threadPool;
+
+	OwnedArray<PendingBlock> pendingBlocks;
+	OutputStream* pendingOutput = nullptr;
+	uint32* pendingBlockOffsets = nullptr;
+
+	// If true, the checksums are written as zeros and their positions are stored so that they can be created later
+	bool deferChecksums = false;
+	Array<int64> checksumPositions;
 };
 
 } // namespace hlac
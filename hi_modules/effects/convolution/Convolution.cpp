@@ -41,17 +41,146 @@ struct ConvolutionEffect::WdlPimpl
 };
 #endif
 
+ConvolutionScheduler::ConvolutionScheduler()
+{
+
+}
+
+ConvolutionScheduler::~ConvolutionScheduler()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	notify();
+
+	for (auto w : workers)
+		w->stopThread(1000);
+
+	workers.clear();
+}
+
+void ConvolutionScheduler::addJob(Job* j)
+{
+	ScopedLock sl(jobLock);
+
+	jobs.addIfNotAlreadyThere(j);
+
+	if (workers.isEmpty())
+	{
+		// Leave enough cores for the audio thread and the other background tasks
+		const int numWorkers = jlimit<int>(1, 4, SystemStats::getNumCpus() / 2);
+
+		for (int i = 0; i < numWorkers; i++)
+		{
+			auto w = workers.add(new WorkerThread(*this, i));
+			w->startThread(9);
+		}
+	}
+}
+
+void ConvolutionScheduler::Job::finish()
+{
+	if (tryToStart())
+	{
+		perform();
+		state.store(Idle);
+		return;
+	}
+
+	if (state.load() != Running)
+		return;
+
+	const double start = Time::getMillisecondCounterHiRes();
+
+	// The worker is usually about to finish, so spin for a short time before going to sleep
+	while (state.load() == Running)
+	{
+		if (Time::getMillisecondCounterHiRes() - start > MaxSpinMilliseconds)
+			break;
+	}
+
+	// The result is needed for this block, so this has to wait until the worker is done. Sleeping
+	// instead of spinning leaves the core to the worker if it was preempted.
+	while (state.load() == Running)
+		workerFinished.wait(1);
+
+	if (Time::getMillisecondCounterHiRes() - start > MaxWaitMilliseconds)
+		numInlineBlocksLeft = NumInlineBlocksAfterStall;
+}
+
+void ConvolutionScheduler::removeJob(Job* j)
+{
+	{
+		ScopedLock sl(jobLock);
+		jobs.removeFirstMatchingValue(j);
+	}
+
+	// A worker might have picked it up before it was removed
+	while (j->state.load() == Job::Running)
+		Thread::yield();
+}
+
+void ConvolutionScheduler::notify()
+{
+	for (auto w : workers)
+		w->notify();
+}
+
+ConvolutionScheduler::Job* ConvolutionScheduler::getNextJob()
+{
+	ScopedLock sl(jobLock);
+
+	Job* nextJob = nullptr;
+	double nextDeadline = 0.0;
+
+	for (auto j : jobs)
+	{
+		if (j->state.load(std::memory_order_acquire) != Job::Pending)
+			continue;
+
+		const double d = j->deadline.load(std::memory_order_relaxed);
+
+		if (nextJob == nullptr || d < nextDeadline)
+		{
+			nextJob = j;
+			nextDeadline = d;
+		}
+	}
+
+	// The audio thread might have started it in the meantime
+	if (nextJob != nullptr && nextJob->tryToStart())
+		return nextJob;
+
+	return nullptr;
+}
+
+void ConvolutionScheduler::WorkerThread::run()
+{
+	while (!threadShouldExit())
+	{
+		if (auto j = parent.getNextJob())
+		{
+			j->perform();
+			j->markAsFinished();
+			continue;
+		}
+
+		wait(500);
+	}
+}
+
 ConvolutionEffect::ConvolutionEffect(MainController *mc, const String &id) :
 MasterEffectProcessor(mc, id),
 AudioSampleProcessor(this),
 dryGain(0.0f),
 wetGain(1.0f),
-wetBuffer(2, 0),
+wetBuffer(6, 0),
 latency(0),
 isReloading(false),
 rampFlag(false),
 rampIndex(0),
 processFlag(true),
+nextProcessFlag(true),
 loadAfterProcessFlag(false),
 isCurrentlyProcessing(false),
 loadingThread(*this),
@@ -113,9 +242,9 @@ float ConvolutionEffect::getAttribute(int parameterIndex) const
 	case WetGain:		return Decibels::gainToDecibels(wetGain);
 	case Latency:		return (float)latency;
 	case ImpulseLength:	return 1.0f;
-	case ProcessInput:	return processFlag ? 1.0f : 0.0f;
+	case ProcessInput:	return nextProcessFlag ? 1.0f : 0.0f;
 #if USE_FFT_CONVOLVER
-	case UseBackgroundThread:	return convolverL->isUsingBackgroundThread() ? 1.0f : 0.0f;
+	case UseBackgroundThread:	return useBackgroundThread ? 1.0f : 0.0f;
 #endif
 	case Predelay:		return predelayMs;
 	case HiCut:			return (float)cutoffFrequency;
@@ -142,8 +271,7 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 		break;
 	case ProcessInput:	enableProcessing(newValue >= 0.5f); break;
 #if USE_FFT_CONVOLVER
-	case UseBackgroundThread:	convolverL->setUseBackgroundThread(newValue > 0.5f);
-								convolverR->setUseBackgroundThread(newValue > 0.5f);
+	case UseBackgroundThread:	setUseBackgroundThread(newValue > 0.5f);
 								break;
 #endif
 	case Predelay:		predelayMs = newValue;
@@ -221,8 +349,6 @@ void ConvolutionEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 
 	if (sampleRate != lastSampleRate)
 	{
-		ScopedLock sl(getImpulseLock());
-
 		lastSampleRate = sampleRate;
 
 		smoothedGainerWet.prepareToPlay(sampleRate, samplesPerBlock);
@@ -232,7 +358,8 @@ void ConvolutionEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 		rightPredelay.prepareToPlay(sampleRate);
 
 #if USE_FFT_CONVOLVER
-		
+		convolverL->setSampleRate(sampleRate);
+		convolverR->setSampleRate(sampleRate);
 
 		setImpulse();
 
@@ -261,9 +388,50 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 	
 	isCurrentlyProcessing.store(true);
 
-	ScopedLock sl(getImpulseLock());
+	// The lock only guards the handoff of the flags and convolver pointers. The other threads only
+	// replace or delete the next and retired convolvers, so the current ones are processed after
+	// releasing it. If another thread is holding the lock, the changes are picked up in the next block.
+	{
+		GenericScopedTryLock<SpinLock> stl(swapLock);
 
-	if (isReloading || (!processFlag && !rampFlag))
+		if (stl.isLocked())
+		{
+			if (processFlag != nextProcessFlag)
+			{
+				processFlag = nextProcessFlag;
+
+				rampFlag = true;
+				rampUp = processFlag;
+				rampIndex = 0;
+			}
+
+#if USE_FFT_CONVOLVER
+
+			const bool fadeIsFinished = inputFadeIndex >= getInputFadeLength() && numTailSamplesRemaining <= 0;
+
+			// Hand the convolvers that have rung out over to the loading thread
+			if (fadingConvolverL != nullptr && fadeIsFinished && retiredConvolverL == nullptr && retiredConvolverR == nullptr)
+			{
+				retiredConvolverL = fadingConvolverL.release();
+				retiredConvolverR = fadingConvolverR.release();
+			}
+
+			if (fadingConvolverL == nullptr && nextConvolverL != nullptr)
+			{
+				fadingConvolverL = convolverL.release();
+				fadingConvolverR = convolverR.release();
+				convolverL = nextConvolverL.release();
+				convolverR = nextConvolverR.release();
+
+				inputFadeIndex = 0;
+				numTailSamplesRemaining = jmax<int>(fadingConvolverL->getTailLength(), fadingConvolverR->getTailLength());
+			}
+
+#endif
+		}
+	}
+
+	if (!processFlag && !rampFlag)
 	{
 		smoothedGainerDry.processBlock(channels, 2, numSamples);
 
@@ -272,6 +440,12 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
 #endif
 
+#if USE_FFT_CONVOLVER
+		// The wet signal is muted, so the old tail can be dropped
+		inputFadeIndex = getInputFadeLength();
+		numTailSamplesRemaining = 0;
+#endif
+
 		isCurrentlyProcessing.store(false);
 		return;
 	}
@@ -301,11 +475,18 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		//memset(convolutedL, 0, sizeof(float)*numSamples);
 		//memset(convolutedR, 0, sizeof(float)*numSamples);
 
-		if (convolverL != nullptr)
-			convolverL->process(l, convolutedL, numSamples);
+		if (fadingConvolverL != nullptr && fadingConvolverR != nullptr)
+		{
+			processWithCrossfade(l, r, numSamples);
+		}
+		else
+		{
+			if (convolverL != nullptr)
+				convolverL->process(l, convolutedL, numSamples);
 
-		if(convolverR != nullptr)
-			convolverR->process(r, convolutedR, numSamples);
+			if (convolverR != nullptr)
+				convolverR->process(r, convolutedR, numSamples);
+		}
 		
 		
 
@@ -432,16 +613,9 @@ ProcessorEditorBody *ConvolutionEffect::createEditor(ProcessorEditor *parentEdit
 
 void ConvolutionEffect::enableProcessing(bool shouldBeProcessed)
 {
-	if (processFlag != shouldBeProcessed)
-	{
-		ScopedLock sl(getImpulseLock());
+	SpinLock::ScopedLockType sl(swapLock);
 
-		processFlag = shouldBeProcessed;
-
-		rampFlag = true;
-		rampUp = shouldBeProcessed;
-		rampIndex = 0;
-	}
+	nextProcessFlag = shouldBeProcessed;
 }
 
 void ConvolutionEffect::calcPredelay()
@@ -507,6 +681,112 @@ void ConvolutionEffect::calcCutoff()
 	setImpulse();
 }
 
+#if USE_FFT_CONVOLVER
+
+void ConvolutionEffect::setUseBackgroundThread(bool shouldUseBackgroundThread)
+{
+	SpinLock::ScopedLockType sl(swapLock);
+
+	useBackgroundThread = shouldUseBackgroundThread;
+
+	MultithreadedConvolver* convolvers[6] = { convolverL.get(), convolverR.get(), nextConvolverL.get(), nextConvolverR.get(), fadingConvolverL.get(), fadingConvolverR.get() };
+
+	for (auto c : convolvers)
+	{
+		if (c != nullptr)
+			c->setUseBackgroundThread(useBackgroundThread);
+	}
+}
+
+void ConvolutionEffect::swapInPreparedConvolvers(MultithreadedConvolver* newL, MultithreadedConvolver* newR)
+{
+	// The convolvers are deleted after the lock is released because their destructor waits for the workers
+	ScopedPointer<MultithreadedConvolver> unusedL, unusedR, retiredL, retiredR;
+
+	{
+		SpinLock::ScopedLockType sl(swapLock);
+
+		newL->setUseBackgroundThread(useBackgroundThread);
+		newR->setUseBackgroundThread(useBackgroundThread);
+
+		// If the audio thread didn't pick up the last convolvers yet, they are replaced by the new ones
+		unusedL = nextConvolverL.release();
+		unusedR = nextConvolverR.release();
+		retiredL = retiredConvolverL.release();
+		retiredR = retiredConvolverR.release();
+
+		nextConvolverL = newL;
+		nextConvolverR = newR;
+	}
+}
+
+void ConvolutionEffect::deleteRetiredConvolvers()
+{
+	ScopedPointer<MultithreadedConvolver> retiredL, retiredR;
+
+	{
+		SpinLock::ScopedLockType sl(swapLock);
+
+		retiredL = retiredConvolverL.release();
+		retiredR = retiredConvolverR.release();
+	}
+}
+
+void ConvolutionEffect::processWithCrossfade(const float* l, const float* r, int numSamples)
+{
+	float* newL = wetBuffer.getWritePointer(0);
+	float* newR = wetBuffer.getWritePointer(1);
+	float* oldL = wetBuffer.getWritePointer(2);
+	float* oldR = wetBuffer.getWritePointer(3);
+	float* inputL = wetBuffer.getWritePointer(4);
+	float* inputR = wetBuffer.getWritePointer(5);
+
+	const int fadeLength = getInputFadeLength();
+	const int numToFade = jlimit<int>(0, numSamples, fadeLength - inputFadeIndex);
+	const float delta = 1.0f / (float)fadeLength;
+
+	// Fade in the input of the new convolvers. They start with an empty history, so they
+	// can't be crossfaded at the output without cutting off the tail of the old convolvers.
+	for (int i = 0; i < numToFade; i++)
+	{
+		const float alpha = (float)(inputFadeIndex + i) * delta;
+
+		inputL[i] = alpha * l[i];
+		inputR[i] = alpha * r[i];
+	}
+
+	FloatVectorOperations::copy(inputL + numToFade, l + numToFade, numSamples - numToFade);
+	FloatVectorOperations::copy(inputR + numToFade, r + numToFade, numSamples - numToFade);
+
+	convolverL->process(inputL, newL, numSamples);
+	convolverR->process(inputR, newR, numSamples);
+
+	// Fade out the input of the old convolvers and let them ring out
+	for (int i = 0; i < numToFade; i++)
+	{
+		const float alpha = 1.0f - (float)(inputFadeIndex + i) * delta;
+
+		inputL[i] = alpha * l[i];
+		inputR[i] = alpha * r[i];
+	}
+
+	FloatVectorOperations::clear(inputL + numToFade, numSamples - numToFade);
+	FloatVectorOperations::clear(inputR + numToFade, numSamples - numToFade);
+
+	fadingConvolverL->process(inputL, oldL, numSamples);
+	fadingConvolverR->process(inputR, oldR, numSamples);
+
+	FloatVectorOperations::add(newL, oldL, numSamples);
+	FloatVectorOperations::add(newR, oldR, numSamples);
+
+	inputFadeIndex += numToFade;
+
+	if (inputFadeIndex >= fadeLength)
+		numTailSamplesRemaining -= numSamples - numToFade;
+}
+
+#endif
+
 
 
 void GainSmoother::processBlock(float** data, int numChannels, int numSamples)
@@ -586,6 +866,10 @@ void ConvolutionEffect::LoadingThread::run()
 			reloadInternal();
 		}
 
+#if USE_FFT_CONVOLVER
+		parent.deleteRetiredConvolvers();
+#endif
+
 		wait(500);
 	}
 	
@@ -595,10 +879,7 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 {
 	if (parent.getSampleBuffer() == nullptr || parent.getSampleBuffer()->getNumChannels() == 0)
 	{
-		ScopedLock sl(parent.getImpulseLock());
-
-		parent.convolverL->reset();
-		parent.convolverR->reset();
+		parent.swapInPreparedConvolvers(new MultithreadedConvolver(), new MultithreadedConvolver());
 		shouldReload = false;
 		return;
 	}
@@ -683,9 +964,15 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 	const auto headSize = nextPowerOfTwo(parent.getLargestBlockSize());
 	const auto fullTailLength = nextPowerOfTwo(resampledLength - headSize);
 
-	ScopedLock sl(parent.getImpulseLock());
+	// Prepare the partition spectra in new convolvers so that the audio thread can keep
+	// using the old impulse response until these are ready.
+	ScopedPointer<MultithreadedConvolver> newL = new MultithreadedConvolver();
+	ScopedPointer<MultithreadedConvolver> newR = new MultithreadedConvolver();
 
-	parent.convolverL->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(0), resampledLength);
+	newL->setSampleRate(parent.getSampleRate());
+	newR->setSampleRate(parent.getSampleRate());
+
+	newL->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(0), resampledLength);
 
 	if (shouldRestart)
 	{
@@ -693,7 +980,7 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 		return;
 	}
 
-	parent.convolverR->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(1), resampledLength);
+	newR->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(1), resampledLength);
 
 	if (shouldRestart)
 	{
@@ -701,6 +988,8 @@ void ConvolutionEffect::LoadingThread::reloadInternal()
 		return;
 	}
 
+	parent.swapInPreparedConvolvers(newL.release(), newR.release());
+
 	shouldReload = false;
 
 #else
@@ -103,70 +103,164 @@ private:
 	
 };
 
-class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver
+/** A process-wide pool of worker threads that renders the tail partitions of all convolution effects.
+*
+*	Instead of starting one thread per convolver, every MultithreadedConvolver registers itself as a Job
+*	and submits its tail block along with a deadline (the time when the audio thread will need the result).
+*	The worker threads always pick the pending job with the earliest deadline, so a short tail block never
+*	waits behind a long one. If the audio thread needs a result that has not been picked up yet, it will
+*	render it itself instead of waiting. If a worker is still rendering it, the audio thread spins for a
+*	few microseconds and then sleeps until the worker is done. A wait that took too long makes the job
+*	render the next blocks on the audio thread.
+*
+*	Use it with a SharedResourcePointer - the threads are started when the first job is added.
+*/
+class ConvolutionScheduler
 {
-	class BackgroundThread : public Thread
+public:
+
+	/** A unit of work that can be submitted to the scheduler. */
+	class Job
 	{
 	public:
 
-		BackgroundThread(MultithreadedConvolver& parent_) :
-			Thread("Convolution Background Thread"),
-			parent(parent_)
+		enum State
 		{
-			
+			Idle = 0,
+			Pending,
+			Running
+		};
+
+		virtual ~Job() {};
+
+		/** Overwrite this method and do the work. */
+		virtual void perform() = 0;
+
+		/** Marks the job as pending. Call ConvolutionScheduler::notify() afterwards to wake up the workers. */
+		void submit(double deadlineMs)
+		{
+			// The deadline is published by the state change, so the workers read it after they saw the pending state
+			deadline.store(deadlineMs, std::memory_order_relaxed);
+			state.store(Pending, std::memory_order_release);
 		}
 
-		void run() override
+		/** Makes sure that the last submitted work is done.
+		*
+		*	If no worker has picked up the job yet, it will be performed on the calling thread. If a worker
+		*	is still rendering it, this spins for MaxSpinMilliseconds and then sleeps until the worker is done.
+		*/
+		void finish();
+
+		/** Returns true if the job should be performed on the calling thread instead of being submitted.
+		*
+		*	This is the case for NumInlineBlocksAfterStall calls after finish() had to wait longer than
+		*	MaxWaitMilliseconds for a worker (eg. because the system is overloaded).
+		*/
+		bool shouldRenderInline()
 		{
-			while (!threadShouldExit())
+			if (numInlineBlocksLeft > 0)
 			{
+				--numInlineBlocksLeft;
+				return true;
+			}
 
-				if (active)
-				{
-					ScopedValueSetter<bool> svs(currentlyRendering, true);
-					parent.doBackgroundProcessing();
-					active = false;
+			return false;
+		}
 
-					if (threadShouldExit())
-						return;
-				}
+	private:
 
-				wait(500);
-			}
-		};
+		static constexpr double MaxSpinMilliseconds = 0.05;
+		static constexpr double MaxWaitMilliseconds = 1.0;
+		static constexpr int NumInlineBlocksAfterStall = 256;
+
+		friend class ConvolutionScheduler;
+
+		/** Called by the worker after it performed the job. */
+		void markAsFinished()
+		{
+			state.store(Idle);
+			workerFinished.signal();
+		}
 
-		void setSomethingTodo(bool shouldBeActive)
+		bool tryToStart()
 		{
-			active = shouldBeActive;
+			int expected = Pending;
+			return state.compare_exchange_strong(expected, Running);
 		}
 
-		bool isBusy() const { return currentlyRendering; }
+		std::atomic<int> state = { Idle };
+		std::atomic<double> deadline = { 0.0 };
 
-		bool currentlyRendering = false;
-		bool active = false;
+		WaitableEvent workerFinished;
 
-		MultithreadedConvolver& parent;
+		// only accessed by the thread that calls finish()
+		int numInlineBlocksLeft = 0;
 	};
 
+	ConvolutionScheduler();
+	~ConvolutionScheduler();
+
+	/** Registers the job. This will start the worker threads if they are not running yet. */
+	void addJob(Job* j);
+
+	/** Removes the job and waits until a worker has finished rendering it. */
+	void removeJob(Job* j);
+
+	/** Wakes up the workers. */
+	void notify();
+
+	int getNumWorkers() const { return workers.size(); }
+
+private:
+
+	class WorkerThread : public Thread
+	{
+	public:
+
+		WorkerThread(ConvolutionScheduler& parent_, int index) :
+			Thread("Convolution Worker Thread " + String(index + 1)),
+			parent(parent_)
+		{};
+
+		void run() override;
+
+		ConvolutionScheduler& parent;
+	};
+
+	/** Picks the pending job with the earliest deadline and marks it as running. */
+	Job* getNextJob();
+
+	CriticalSection jobLock;
+	Array<Job*> jobs;
 
+	OwnedArray<WorkerThread> workers;
+
+	JUCE_DECLARE_NON_COPYABLE(ConvolutionScheduler);
+};
+
+class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver,
+							   private ConvolutionScheduler::Job
+{
 public:
 
 	MultithreadedConvolver() :
-		TwoStageFFTConvolver(),
-		backgroundThread(*this)
+		TwoStageFFTConvolver()
 	{};
 
 	virtual ~MultithreadedConvolver()
 	{
-		backgroundThread.stopThread(1000);
+		setUseBackgroundThread(false);
+		finish();
 	};
 
 	void startBackgroundProcessing() override
 	{
-		if (useBackgroundThread)
+		if (useBackgroundThread && !shouldRenderInline())
 		{
-			backgroundThread.setSomethingTodo(true);
-			backgroundThread.notify();
+			const double blockLengthMs = 1000.0 * (double)getTailBlockSize() / sampleRate;
+
+			submit(Time::getMillisecondCounterHiRes() + blockLengthMs);
+			scheduler->notify();
 		}
 		else
 		{
@@ -176,27 +270,44 @@ public:
 
 	void waitForBackgroundProcessing() override
 	{
-		if (useBackgroundThread)
-		{
-			while (backgroundThread.isBusy())
-				jassertfalse;
-		}
+		finish();
+	}
+
+	/** Sets the sample rate that is used to calculate the deadline of the tail block. */
+	void setSampleRate(double newSampleRate)
+	{
+		if (newSampleRate > 0.0)
+			sampleRate = newSampleRate;
+	}
+
+	/** Initialises the convolver and stores the impulse length for getTailLength(). */
+	bool init(size_t headBlockSize, size_t tailBlockSize, const fftconvolver::Sample* ir, size_t irLen)
+	{
+		impulseLength = (int)irLen;
+		return TwoStageFFTConvolver::init(headBlockSize, tailBlockSize, ir, irLen);
+	}
+
+	/** Returns the number of samples that the output keeps ringing after the input became silent. */
+	int getTailLength() const
+	{
+		return impulseLength + (int)getTailBlockSize();
 	}
 
 	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread)
 	{
 		if (useBackgroundThread != shouldBeUsingBackgroundThread)
 		{
-			useBackgroundThread = shouldBeUsingBackgroundThread;
-		
-			if (useBackgroundThread)
-				backgroundThread.startThread(9);
+			if (shouldBeUsingBackgroundThread)
+			{
+				scheduler->addJob(this);
+				useBackgroundThread = true;
+			}
 			else
 			{
-				if(backgroundThread.isThreadRunning())
-					backgroundThread.stopThread(1000);
+				// a pending job will be picked up by the next waitForBackgroundProcessing() call
+				useBackgroundThread = false;
+				scheduler->removeJob(this);
 			}
-				
 		}
 	}
 
@@ -207,9 +318,16 @@ public:
 
 private:
 
-	BackgroundThread backgroundThread;
+	void perform() override
+	{
+		doBackgroundProcessing();
+	}
+
+	SharedResourcePointer<ConvolutionScheduler> scheduler;
 
-	bool useBackgroundThread = true;
+	double sampleRate = 44100.0;
+	int impulseLength = 0;
+	std::atomic<bool> useBackgroundThread = { false };
 };
 
 
@@ -272,11 +390,7 @@ class ConvolutionEffect: public MasterEffectProcessor,
 			}
 
 			shouldReload = true;
-
-			ScopedLock sl(parent.getImpulseLock());
-
-			parent.convolverL->reset();
-			parent.convolverR->reset();
+			notify();
 
 			stopTimer();
 		}
@@ -333,8 +447,13 @@ public:
 
 	void voicesKilled() override
 	{
+		convolverL->waitForBackgroundProcessing();
+		convolverR->waitForBackgroundProcessing();
 		convolverL->cleanPipeline();
 		convolverR->cleanPipeline();
+
+		// There's nothing left to ring out
+		numTailSamplesRemaining = 0;
 	}
 
 	int getNumChildProcessors() const override { return 0; };
@@ -377,8 +496,7 @@ private:
 
 	AudioSampleBuffer wetBuffer;
 
-	const CriticalSection& getImpulseLock() const { return lock; };
-
+	/** Requests the processing state change. The audio thread picks it up the next time it gets the swapLock. */
 	void enableProcessing(bool shouldBeProcessed);
 
 	std::atomic<bool> isCurrentlyProcessing;
@@ -387,13 +505,12 @@ private:
 	bool rampFlag;
 	bool rampUp;
 	bool processFlag;
+	bool nextProcessFlag;
 	int rampIndex;
 
 	DelayLine<4096> leftPredelay;
 	DelayLine<4096> rightPredelay;
 
-	CriticalSection lock;
-
 	bool isUsingPoolData;
 
 	bool isReloading;
@@ -411,6 +528,37 @@ private:
 	ScopedPointer<MultithreadedConvolver> convolverL;
 	ScopedPointer<MultithreadedConvolver> convolverR;
 
+	/** The convolvers with the new impulse response. They are prepared on the loading thread
+	*	and picked up by the audio thread as soon as the previous crossfade is finished. */
+	ScopedPointer<MultithreadedConvolver> nextConvolverL;
+	ScopedPointer<MultithreadedConvolver> nextConvolverR;
+
+	/** The convolvers with the previous impulse response. Their input is faded out while the input of the
+	*	new convolvers is faded in, and they keep running until their tail has decayed. */
+	ScopedPointer<MultithreadedConvolver> fadingConvolverL;
+	ScopedPointer<MultithreadedConvolver> fadingConvolverR;
+
+	/** The convolvers that have rung out. They are deleted on the loading thread. */
+	ScopedPointer<MultithreadedConvolver> retiredConvolverL;
+	ScopedPointer<MultithreadedConvolver> retiredConvolverR;
+
+	int inputFadeIndex = 0;
+	int numTailSamplesRemaining = 0;
+
+	bool useBackgroundThread = false;
+
+	void setUseBackgroundThread(bool shouldUseBackgroundThread);
+
+	int getInputFadeLength() const { return jmax<int>(1, (CONVOLUTION_RAMPING_TIME_MS * (int)getSampleRate()) / 1000); }
+
+	/** Renders the new and the fading convolvers and writes the sum into the first two channels of the wet buffer. */
+	void processWithCrossfade(const float* l, const float* r, int numSamples);
+
+	/** Hands the prepared convolvers over to the audio thread. */
+	void swapInPreparedConvolvers(MultithreadedConvolver* newL, MultithreadedConvolver* newR);
+
+	void deleteRetiredConvolvers();
+
 #else
 
 	struct WdlPimpl;
@@ -256,21 +256,15 @@ class FFTDisplay : public AudioAnalyserComponent
 public:
 
 	FFTDisplay(Processor* p) :
-#if USE_IPP
         AudioAnalyserComponent(p),
-		fftObject(IppFFT::DataType::RealFloat)
-#else
-       AudioAnalyserComponent(p)
-#endif
+		fftObject(FFTImplementation::DataType::RealFloat)
 	{};
 
 	void paint(Graphics& g) override;
 
 private:
 
-#if USE_IPP
-	IppFFT fftObject;
-#endif
+	FFTImplementation fftObject;
 
 	Path lPath;
 	Path rPath;
@@ -33,6 +33,201 @@
 namespace hise {
 using namespace juce;
 
+/** The kernels for the ChannelLaneProcessor. They run the exact same operations as the
+	scalar code of the filter types, just with one channel per lane. */
+namespace FilterKernels
+{
+
+struct Moog
+{
+	using Lanes = ChannelLaneProcessor<double>;
+	using RegisterType = Lanes::RegisterType;
+
+	Moog(double* data_, double fb_, double fss, double invF_) :
+		data(data_),
+		fb(fb_),
+		inputGain(0.35013 * fss),
+		invF(invF_)
+	{}
+
+	void loadState(int firstChannel, int numLanesUsed)
+	{
+		for (int i = 0; i < 8; i++)
+			state[i] = Lanes::load(data + i * NUM_MAX_CHANNELS, firstChannel, numLanesUsed);
+	}
+
+	void storeState(int firstChannel, int numLanesUsed)
+	{
+		for (int i = 0; i < 8; i++)
+			Lanes::store(state[i], data + i * NUM_MAX_CHANNELS, firstChannel, numLanesUsed);
+	}
+
+	RegisterType processFrame(RegisterType input)
+	{
+		auto& in1 = state[0]; auto& in2 = state[1]; auto& in3 = state[2]; auto& in4 = state[3];
+		auto& out1 = state[4]; auto& out2 = state[5]; auto& out3 = state[6]; auto& out4 = state[7];
+
+		input = input - out4 * fb;
+		input = input * inputGain;
+		out1 = input + in1 * 0.3 + out1 * invF;
+		in1 = input;
+		out2 = out1 + in2 * 0.3 + out2 * invF;
+		in2 = out1;
+		out3 = out2 + in3 * 0.3 + out3 * invF;
+		in3 = out2;
+		out4 = out3 + in4 * 0.3 + out4 * invF;
+		in4 = out3;
+
+		return out4 * 2.0;
+	}
+
+	double* data;
+	const double fb, inputGain, invF;
+
+	RegisterType state[8];
+};
+
+struct Ladder
+{
+	using Lanes = ChannelLaneProcessor<float>;
+	using RegisterType = Lanes::RegisterType;
+
+	Ladder(float* buf_, float cut_, float res_) :
+		buf(buf_),
+		cut(cut_),
+		res(res_)
+	{}
+
+	void loadState(int firstChannel, int numLanesUsed)
+	{
+		for (int i = 0; i < 4; i++)
+			state[i] = Lanes::load(buf + i, firstChannel, numLanesUsed, 4);
+	}
+
+	void storeState(int firstChannel, int numLanesUsed)
+	{
+		for (int i = 0; i < 4; i++)
+			Lanes::store(state[i], buf + i, firstChannel, numLanesUsed, 4);
+	}
+
+	RegisterType processFrame(RegisterType input)
+	{
+		const auto in = input - state[3] * res;
+		state[0] = ((in - state[0]) * cut) + state[0];
+		state[1] = ((state[0] - state[1]) * cut) + state[1];
+		state[2] = ((state[1] - state[2]) * cut) + state[2];
+		state[3] = ((state[2] - state[3]) * cut) + state[3];
+		return state[3] * 2.0f;
+	}
+
+	float* buf;
+	const float cut, res;
+
+	RegisterType state[4];
+};
+
+template <int Type> struct StateVariable
+{
+	using Lanes = ChannelLaneProcessor<float>;
+	using RegisterType = Lanes::RegisterType;
+
+	StateVariable(float* v0z_, float* z1_A_, float* v2_, float k_, float g1_, float g2_, float g3_, float g4_) :
+		v0zData(v0z_),
+		z1Data(z1_A_),
+		v2Data(v2_),
+		k(k_), g1(g1_), g2(g2_), g3(g3_), g4(g4_)
+	{}
+
+	void loadState(int firstChannel, int numLanesUsed)
+	{
+		v0z = Lanes::load(v0zData, firstChannel, numLanesUsed);
+		z1_A = Lanes::load(z1Data, firstChannel, numLanesUsed);
+		v2 = Lanes::load(v2Data, firstChannel, numLanesUsed);
+	}
+
+	void storeState(int firstChannel, int numLanesUsed)
+	{
+		Lanes::store(v0z, v0zData, firstChannel, numLanesUsed);
+		Lanes::store(z1_A, z1Data, firstChannel, numLanesUsed);
+		Lanes::store(v2, v2Data, firstChannel, numLanesUsed);
+	}
+
+	RegisterType processFrame(RegisterType v0)
+	{
+		const auto v1z = z1_A;
+		const auto v3 = v0 + v0z - v2 * 2.0f;
+		z1_A += v3 * g1 - v1z * g2;
+		v2 += v3 * g3 + v1z * g4;
+		v0z = v0;
+
+		switch (Type)
+		{
+		case StateVariableFilterSubType::LP:	return v2;
+		case StateVariableFilterSubType::BP:	return z1_A;
+		case StateVariableFilterSubType::HP:	return v0 - z1_A * k - v2;
+		case StateVariableFilterSubType::NOTCH:	return v0 - z1_A * k;
+		default:								return v0;
+		}
+	}
+
+	float* v0zData;
+	float* z1Data;
+	float* v2Data;
+
+	const float k, g1, g2, g3, g4;
+
+	RegisterType v0z, z1_A, v2;
+};
+
+struct Biquad
+{
+	using Lanes = ChannelLaneProcessor<float>;
+	using RegisterType = Lanes::RegisterType;
+
+	Biquad(float* v1_, float* v2_, const IIRCoefficients& c) :
+		v1Data(v1_),
+		v2Data(v2_),
+		c0(c.coefficients[0]), c1(c.coefficients[1]), c2(c.coefficients[2]), c3(c.coefficients[3]), c4(c.coefficients[4])
+	{}
+
+	void loadState(int firstChannel, int numLanesUsed)
+	{
+		lv1 = Lanes::load(v1Data, firstChannel, numLanesUsed);
+		lv2 = Lanes::load(v2Data, firstChannel, numLanesUsed);
+	}
+
+	void storeState(int firstChannel, int numLanesUsed)
+	{
+		Lanes::store(lv1, v1Data, firstChannel, numLanesUsed);
+		Lanes::store(lv2, v2Data, firstChannel, numLanesUsed);
+
+		for (int i = firstChannel; i < firstChannel + numLanesUsed; i++)
+		{
+			JUCE_SNAP_TO_ZERO(v1Data[i]);
+			JUCE_SNAP_TO_ZERO(v2Data[i]);
+		}
+	}
+
+	RegisterType processFrame(RegisterType in)
+	{
+		const auto out = in * c0 + lv1;
+
+		lv1 = in * c1 - out * c3 + lv2;
+		lv2 = in * c2 - out * c4;
+
+		return out;
+	}
+
+	float* v1Data;
+	float* v2Data;
+
+	const float c0, c1, c2, c3, c4;
+
+	RegisterType lv1, lv2;
+};
+
+}
+
 
 hise::MoogFilterSubType::MoogFilterSubType()
 {
@@ -66,27 +261,8 @@ void MoogFilterSubType::updateCoefficients(double sampleRate, double frequency,
 
 void MoogFilterSubType::processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
 {
-	for (int c = 0; c < buffer.getNumChannels(); c++)
-	{
-		float* d = buffer.getWritePointer(c, startSample);
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			double input = (double)d[i];
-
-			input -= out4[c] * fb;
-			input *= 0.35013 * fss;
-			out1[c] = input + 0.3 * in1[c] + invF * out1[c];
-			in1[c] = input;
-			out2[c] = out1[c] + 0.3 * in2[c] + invF * out2[c];
-			in2[c] = out1[c];
-			out3[c] = out2[c] + 0.3 * in3[c] + invF * out3[c];
-			in3[c] = out2[c];
-			out4[c] = out3[c] + 0.3 * in4[c] + invF * out4[c];
-			in4[c] = out3[c];
-			d[i] = 2.0f * (float)out4[c];
-		}
-	}
+	FilterKernels::Moog kernel(data, fb, fss, invF);
+	ChannelLaneProcessor<double>::process(kernel, buffer, startSample, numSamples);
 }
 
 void SimpleOnePoleSubType::processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
@@ -164,21 +340,17 @@ void StaticBiquadSubType::reset(int numNewChannels)
 {
 	numChannels = numNewChannels;
 
-	for (int i = 0; i < numChannels; i++)
-	{
-		filters[i].reset();
-	}
+	memset(v1, 0, sizeof(float) * numChannels);
+	memset(v2, 0, sizeof(float) * numChannels);
 }
 
 void StaticBiquadSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
 {
-	int channelAmount = b.getNumChannels();
+	if (!active)
+		return;
 
-	for (int i = 0; i < channelAmount; i++)
-	{
-		float* d = b.getWritePointer(i, startSample);
-		filters[i].processSamples(d, numSamples);
-	}
+	FilterKernels::Biquad kernel(v1, v2, currentCoefficients);
+	ChannelLaneProcessor<float>::process(kernel, b, startSample, numSamples);
 }
 
 void PhaseAllpassSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
@@ -235,14 +407,8 @@ float PhaseAllpassSubType::InternalFilter::getNextSample(float input)
 
 void LadderSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
 {
-	for (int c = 0; c < b.getNumChannels(); c++)
-	{
-		for (int i = 0; i < numSamples; i++)
-		{
-			float* d = b.getWritePointer(c, i + startSample);
-			*d = processSample(*d, c);
-		}
-	}
+	FilterKernels::Ladder kernel(&buf[0][0], cut, res);
+	ChannelLaneProcessor<float>::process(kernel, b, startSample, numSamples);
 }
 
 void LadderSubType::updateCoefficients(double sampleRate, double frequency, double q, double /*gain*/)
@@ -255,20 +421,6 @@ void LadderSubType::updateCoefficients(double sampleRate, double frequency, doub
 	res = jlimit<float>(0.3f, 4.0f, (float)q / 2.0f);
 }
 
-float LadderSubType::processSample(float input, int channel)
-{
-	float* buffer = buf[channel];
-
-	float resoclip = buffer[3];
-
-	const float in = input - (resoclip * res);
-	buffer[0] = ((in - buffer[0]) * cut) + buffer[0];
-	buffer[1] = ((buffer[0] - buffer[1]) * cut) + buffer[1];
-	buffer[2] = ((buffer[1] - buffer[2]) * cut) + buffer[2];
-	buffer[3] = ((buffer[2] - buffer[3]) * cut) + buffer[3];
-	return 2.0f * buffer[3];
-}
-
 void StateVariableFilterSubType::updateCoefficients(double sampleRate, double frequency, double q, double /*gain*/)
 {
 	const float scaledQ = jlimit<float>(0.0f, 9.999f, (float)q * 0.1f);
@@ -311,66 +463,20 @@ void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int s
 	{
 	case LP:
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v2[c];
-			}
-		}
-
+		FilterKernels::StateVariable<LP> kernel(v0z, z1_A, v2, k, g1, g2, g3, g4);
+		ChannelLaneProcessor<float>::process(kernel, buffer, startSample, numSamples);
 		break;
 	}
 	case BP:
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = z1_A[c];
-			}
-		}
-
+		FilterKernels::StateVariable<BP> kernel(v0z, z1_A, v2, k, g1, g2, g3, g4);
+		ChannelLaneProcessor<float>::process(kernel, buffer, startSample, numSamples);
 		break;
 	}
-
 	case HP:
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v0 - k * z1_A[c] - v2[c];
-			}
-		}
-
+		FilterKernels::StateVariable<HP> kernel(v0z, z1_A, v2, k, g1, g2, g3, g4);
+		ChannelLaneProcessor<float>::process(kernel, buffer, startSample, numSamples);
 		break;
 	}
 	case FilterType::ALLPASS:
@@ -398,23 +504,8 @@ void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int s
 
 	case NOTCH:
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v0 - k * z1_A[c];
-			}
-		}
-
+		FilterKernels::StateVariable<NOTCH> kernel(v0z, z1_A, v2, k, g1, g2, g3, g4);
+		ChannelLaneProcessor<float>::process(kernel, buffer, startSample, numSamples);
 		break;
 	}
         default:
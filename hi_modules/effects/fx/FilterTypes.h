@@ -129,6 +129,95 @@ public:
 	};
 };
 
+/** Runs the recursion of a filter for multiple channels at once.
+*
+*	Every channel of the buffer is processed in its own lane of a SIMD register. The samples are
+*	interleaved into a small aligned buffer, so the inner loop only needs aligned loads and stores.
+*	The filter state arrays of the filter types are indexed by channel, so a lane just uses the state
+*	of its channel.
+*
+*	The Kernel class needs these methods:
+*
+*		void loadState(int firstChannel, int numLanesUsed);
+*		RegisterType processFrame(RegisterType input);
+*		void storeState(int firstChannel, int numLanesUsed);
+*/
+template <typename SampleType> struct ChannelLaneProcessor
+{
+	using RegisterType = dsp::SIMDRegister<SampleType>;
+
+	static constexpr int NumLanes = (int)RegisterType::SIMDNumElements;
+	static constexpr int NumFramesPerChunk = 64;
+
+	template <typename Kernel> static void process(Kernel& k, AudioSampleBuffer& b, int startSample, int numSamples)
+	{
+		alignas(RegisterType::SIMDRegisterSize) SampleType frames[NumFramesPerChunk * NumLanes];
+
+		// The unused lanes must not contain garbage (they stay zero if the state is zero)
+		memset(frames, 0, sizeof(frames));
+
+		const int numChannels = b.getNumChannels();
+
+		for (int firstChannel = 0; firstChannel < numChannels; firstChannel += NumLanes)
+		{
+			const int numLanesUsed = jmin<int>(NumLanes, numChannels - firstChannel);
+
+			k.loadState(firstChannel, numLanesUsed);
+
+			for (int offset = 0; offset < numSamples; offset += NumFramesPerChunk)
+			{
+				const int numFrames = jmin<int>(NumFramesPerChunk, numSamples - offset);
+
+				for (int l = 0; l < numLanesUsed; l++)
+				{
+					const float* src = b.getReadPointer(firstChannel + l, startSample + offset);
+
+					for (int i = 0; i < numFrames; i++)
+						frames[i * NumLanes + l] = (SampleType)src[i];
+				}
+
+				for (int i = 0; i < numFrames; i++)
+				{
+					auto frame = frames + i * NumLanes;
+					k.processFrame(RegisterType::fromRawArray(frame)).copyToRawArray(frame);
+				}
+
+				for (int l = 0; l < numLanesUsed; l++)
+				{
+					float* dst = b.getWritePointer(firstChannel + l, startSample + offset);
+
+					for (int i = 0; i < numFrames; i++)
+						dst[i] = (float)frames[i * NumLanes + l];
+				}
+			}
+
+			k.storeState(firstChannel, numLanesUsed);
+		}
+	}
+
+	/** Loads the values of the given channels into the lanes. The other lanes are set to zero. */
+	static RegisterType load(const SampleType* data, int firstChannel, int numLanesUsed, int stride=1)
+	{
+		alignas(RegisterType::SIMDRegisterSize) SampleType lanes[NumLanes] = {};
+
+		for (int l = 0; l < numLanesUsed; l++)
+			lanes[l] = data[(firstChannel + l) * stride];
+
+		return RegisterType::fromRawArray(lanes);
+	}
+
+	/** Writes the lanes back to the values of the given channels. */
+	static void store(RegisterType value, SampleType* data, int firstChannel, int numLanesUsed, int stride=1)
+	{
+		alignas(RegisterType::SIMDRegisterSize) SampleType lanes[NumLanes];
+
+		value.copyToRawArray(lanes);
+
+		for (int l = 0; l < numLanesUsed; l++)
+			data[(firstChannel + l) * stride] = lanes[l];
+	}
+};
+
 /** A base class for filters with multiple channels.
 *
 *   It exposes an interface for different filter types which have common methods for
@@ -470,8 +559,14 @@ private:
 	int numChannels = NUM_MAX_CHANNELS;
 
 	IIRCoefficients currentCoefficients;
-	IIRFilter filters[NUM_MAX_CHANNELS];
 	FilterType biquadType;
+
+	// The state of the transposed direct form II (same as juce::IIRFilter)
+	float v1[NUM_MAX_CHANNELS] = {};
+	float v2[NUM_MAX_CHANNELS] = {};
+
+	// the filter passes the signal through until the first coefficients are calculated
+	bool active = false;
 };
 
 using StaticBiquad = MultiChannelFilter<StaticBiquadSubType>;
@@ -588,8 +683,6 @@ protected:
 
 private:
 
-	float processSample(float input, int channel);
-
 	float buf[NUM_MAX_CHANNELS][4];
 
 	float cut;
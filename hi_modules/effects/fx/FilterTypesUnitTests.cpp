@@ -0,0 +1,386 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+/** Compares the filters that process the channels in SIMD lanes with the scalar code they replaced. */
+class FilterTypesUnitTests : public UnitTest
+{
+public:
+
+	FilterTypesUnitTests() :
+		UnitTest("Testing the SIMD filter lanes")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testMoog();
+		testLadder();
+		testStateVariableFilter();
+		testStaticBiquad();
+	}
+
+private:
+
+	static constexpr double sampleRate = 44100.0;
+	static constexpr double frequency = 1500.0;
+	static constexpr double q = 4.0;
+	static constexpr double gain = 2.0;
+
+	static constexpr int NumSamples = 4096;
+
+	/** The scalar Moog filter before the channels were processed in SIMD lanes. */
+	struct ScalarMoog
+	{
+		void updateCoefficients(double frequency_, double q_, double /*gain*/)
+		{
+			auto lFrequency = FilterLimits::limitFrequency(frequency_);
+
+			fc = lFrequency / (0.5 * sampleRate);
+			res = q_ / 2.0;
+			if (res > 4.0) res = 4.0;
+			f = fc * 1.16;
+			fss = (f * f) * (f * f);
+			invF = 1.0 - f;
+			fb = res * (1.0 - 0.15 * f * f);
+		}
+
+		void processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+		{
+			for (int c = 0; c < buffer.getNumChannels(); c++)
+			{
+				float* d = buffer.getWritePointer(c, startSample);
+
+				for (int i = 0; i < numSamples; i++)
+				{
+					double input = (double)d[i];
+
+					input -= out4[c] * fb;
+					input *= 0.35013 * fss;
+					out1[c] = input + 0.3 * in1[c] + invF * out1[c];
+					in1[c] = input;
+					out2[c] = out1[c] + 0.3 * in2[c] + invF * out2[c];
+					in2[c] = out1[c];
+					out3[c] = out2[c] + 0.3 * in3[c] + invF * out3[c];
+					in3[c] = out2[c];
+					out4[c] = out3[c] + 0.3 * in4[c] + invF * out4[c];
+					in4[c] = out3[c];
+					d[i] = 2.0f * (float)out4[c];
+				}
+			}
+		}
+
+		double in1[NUM_MAX_CHANNELS] = {}, in2[NUM_MAX_CHANNELS] = {}, in3[NUM_MAX_CHANNELS] = {}, in4[NUM_MAX_CHANNELS] = {};
+		double out1[NUM_MAX_CHANNELS] = {}, out2[NUM_MAX_CHANNELS] = {}, out3[NUM_MAX_CHANNELS] = {}, out4[NUM_MAX_CHANNELS] = {};
+
+		double fc, res, f, fss, invF, fb;
+	};
+
+	/** The scalar ladder filter before the channels were processed in SIMD lanes. */
+	struct ScalarLadder
+	{
+		void updateCoefficients(double frequency_, double q_, double /*gain*/)
+		{
+			float inFreq = (float)FilterLimits::limitFrequency(frequency_);
+
+			const float x = 2.0f * float_Pi*inFreq / (float)sampleRate;
+
+			cut = jlimit<float>(0.0f, 0.8f, x);
+			res = jlimit<float>(0.3f, 4.0f, (float)q_ / 2.0f);
+		}
+
+		void processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
+		{
+			for (int c = 0; c < b.getNumChannels(); c++)
+			{
+				for (int i = 0; i < numSamples; i++)
+				{
+					float* d = b.getWritePointer(c, i + startSample);
+					float* buffer = buf[c];
+
+					float resoclip = buffer[3];
+
+					const float in = *d - (resoclip * res);
+					buffer[0] = ((in - buffer[0]) * cut) + buffer[0];
+					buffer[1] = ((buffer[0] - buffer[1]) * cut) + buffer[1];
+					buffer[2] = ((buffer[1] - buffer[2]) * cut) + buffer[2];
+					buffer[3] = ((buffer[2] - buffer[3]) * cut) + buffer[3];
+					*d = 2.0f * buffer[3];
+				}
+			}
+		}
+
+		float buf[NUM_MAX_CHANNELS][4] = {};
+
+		float cut, res;
+	};
+
+	/** The scalar state variable filter before the channels were processed in SIMD lanes. */
+	struct ScalarStateVariableFilter
+	{
+		using FilterType = StateVariableFilterSubType::FilterType;
+
+		ScalarStateVariableFilter(int type_) :
+			type((FilterType)type_)
+		{}
+
+		void updateCoefficients(double frequency_, double q_, double /*gain*/)
+		{
+			const float scaledQ = jlimit<float>(0.0f, 9.999f, (float)q_ * 0.1f);
+
+			if (type == FilterType::ALLPASS)
+			{
+				float wd = static_cast<float>(frequency_ * 2.0f * float_Pi);
+				float T = 1.0f / (float)sampleRate;
+				float wa = (2.0f / T) * tan(wd * T / 2.0f);
+
+				gCoeff = wa * T / 2.0f;
+				RCoeff = 1.0f / (2.0f * (float)q_);
+
+				x1 = (2.0f * RCoeff + gCoeff);
+				x2 = 1.0f / (1.0f + (2.0f * RCoeff * gCoeff) + gCoeff * gCoeff);
+			}
+			else
+			{
+				float g = (float)tan(double_Pi * frequency_ / sampleRate);
+				k = 1.0f - 0.99f * scaledQ;
+				float ginv = g / (1.0f + g * (g + k));
+				g1 = ginv;
+				g2 = 2.0f * (g + k) * ginv;
+				g3 = g * ginv;
+				g4 = 2.0f * ginv;
+			}
+		}
+
+		void processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+		{
+			for (int c = 0; c < buffer.getNumChannels(); c++)
+			{
+				float* d = buffer.getWritePointer(c, startSample);
+
+				for (int i = 0; i < numSamples; i++)
+				{
+					if (type == FilterType::ALLPASS)
+					{
+						const float input = d[i];
+						const float HP = (input - x1 * z1_A[c] - v2[c]) / x2;
+						const float BP = HP * gCoeff + z1_A[c];
+						const float LP = BP * gCoeff + v2[c];
+
+						z1_A[c] = gCoeff * HP + BP;
+						v2[c] = gCoeff * BP + LP;
+
+						d[i] = input - (4.0f * RCoeff * BP);
+						continue;
+					}
+
+					float v0 = d[i];
+					float v1z = z1_A[c];
+					float v2z = v2[c];
+					float v3 = v0 + v0z[c] - 2.0f * v2z;
+					z1_A[c] += g1 * v3 - g2 * v1z;
+					v2[c] += g3 * v3 + g4 * v1z;
+					v0z[c] = v0;
+
+					switch (type)
+					{
+					case FilterType::LP:	d[i] = v2[c]; break;
+					case FilterType::BP:	d[i] = z1_A[c]; break;
+					case FilterType::HP:	d[i] = v0 - k * z1_A[c] - v2[c]; break;
+					case FilterType::NOTCH:	d[i] = v0 - k * z1_A[c]; break;
+					default:				jassertfalse; break;
+					}
+				}
+			}
+		}
+
+		FilterType type;
+
+		float v0z[NUM_MAX_CHANNELS] = {};
+		float z1_A[NUM_MAX_CHANNELS] = {};
+		float v2[NUM_MAX_CHANNELS] = {};
+
+		float k = 0.0f, g1 = 0.0f, g2 = 0.0f, g3 = 0.0f, g4 = 0.0f, x1 = 0.0f, x2 = 0.0f, gCoeff = 0.0f, RCoeff = 0.0f;
+	};
+
+	/** The static biquad before the channels were processed in SIMD lanes (one juce::IIRFilter per channel). */
+	struct ScalarBiquad
+	{
+		using FilterType = StaticBiquadSubType::FilterType;
+
+		ScalarBiquad(int type_) :
+			type((FilterType)type_)
+		{}
+
+		void updateCoefficients(double frequency_, double q_, double gain_)
+		{
+			IIRCoefficients c;
+
+			switch (type)
+			{
+			case FilterType::LowPass:	c = IIRCoefficients::makeLowPass(sampleRate, frequency_); break;
+			case FilterType::HighPass:	c = IIRCoefficients::makeHighPass(sampleRate, frequency_); break;
+			case FilterType::LowShelf:	c = IIRCoefficients::makeLowShelf(sampleRate, frequency_, q_, (float)gain_); break;
+			case FilterType::HighShelf:	c = IIRCoefficients::makeHighShelf(sampleRate, frequency_, q_, (float)gain_); break;
+			case FilterType::Peak:		c = IIRCoefficients::makePeakFilter(sampleRate, frequency_, q_, (float)gain_); break;
+			case FilterType::ResoLow:	c = FilterEffect::makeResoLowPass(sampleRate, frequency_, q_); break;
+			default:					jassertfalse; break;
+			}
+
+			for (auto& f : filters)
+				f.setCoefficients(c);
+		}
+
+		void processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
+		{
+			for (int i = 0; i < b.getNumChannels(); i++)
+				filters[i].processSamples(b.getWritePointer(i, startSample), numSamples);
+		}
+
+		FilterType type;
+		IIRFilter filters[NUM_MAX_CHANNELS];
+	};
+
+	void testMoog()
+	{
+		beginTest("Testing the Moog filter lanes");
+
+		// The Moog filter has only one response (the mode isn't used by the recursion)
+		expectMatchesScalarFilter<MultiChannelFilter<MoogFilterSubType>>("Moog", 0, [](){ return ScalarMoog(); });
+	}
+
+	void testLadder()
+	{
+		beginTest("Testing the ladder filter lanes");
+
+		for (int type = 0; type < LadderSubType::numTypes; type++)
+		{
+			expectMatchesScalarFilter<Ladder>("Ladder type " + String(type), type, [](){ return ScalarLadder(); });
+		}
+	}
+
+	void testStateVariableFilter()
+	{
+		beginTest("Testing the state variable filter lanes");
+
+		for (int type = 0; type < StateVariableFilterSubType::numTypes; type++)
+		{
+			expectMatchesScalarFilter<StateVariableFilter>("SVF type " + String(type), type, [type](){ return ScalarStateVariableFilter(type); });
+		}
+	}
+
+	void testStaticBiquad()
+	{
+		beginTest("Testing the static biquad lanes");
+
+		for (int type = 0; type < StaticBiquadSubType::numFilterTypes; type++)
+		{
+			expectMatchesScalarFilter<StaticBiquad>("Biquad type " + String(type), type, [type](){ return ScalarBiquad(type); });
+		}
+	}
+
+	/** Renders noise through the filter and the scalar reference with 1, 2, 3 and 6 channels.
+	*
+	*	The block sizes don't line up with the chunks of the ChannelLaneProcessor, and the frequency changes
+	*	after the first half so that the state is carried over to new coefficients.
+	*/
+	template <class FilterType, typename ReferenceFactory> void expectMatchesScalarFilter(const String& name, int type, const ReferenceFactory& createReference)
+	{
+		static const int blockSizes[] = { 512, 17, 64, 100, 1 };
+
+		for (int numChannels : { 1, 2, 3, 6 })
+		{
+			FilterType filter;
+			auto reference = createReference();
+
+			filter.setSampleRate(sampleRate);
+			filter.setType(type);
+			filter.setFrequency(frequency);
+			filter.setQ(q);
+			filter.setGain(gain);
+			filter.setNumChannels(numChannels);
+
+			AudioSampleBuffer simdBuffer(numChannels, NumSamples);
+			Random r(numChannels);
+
+			for (int c = 0; c < numChannels; c++)
+			{
+				for (int i = 0; i < NumSamples; i++)
+					simdBuffer.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+			}
+
+			AudioSampleBuffer scalarBuffer(simdBuffer);
+
+			int blockIndex = 0;
+			bool changedFrequency = false;
+
+			for (int start = 0; start < NumSamples;)
+			{
+				const int numThisTime = jmin(blockSizes[blockIndex++ % numElementsInArray(blockSizes)], NumSamples - start);
+				const double freqModValue = changedFrequency ? 0.25 : 1.0;
+
+				FilterHelpers::RenderData rd(simdBuffer, start, numThisTime);
+				rd.freqModValue = freqModValue;
+				filter.render(rd);
+
+				reference.updateCoefficients(FilterLimits::limitFrequency(frequency * freqModValue), FilterLimits::limitQ(q), gain);
+				reference.processSamples(scalarBuffer, start, numThisTime);
+
+				start += numThisTime;
+				changedFrequency = start > NumSamples / 2;
+			}
+
+			float maxError = 0.0f;
+
+			for (int c = 0; c < numChannels; c++)
+			{
+				for (int i = 0; i < NumSamples; i++)
+					maxError = jmax(maxError, std::abs(simdBuffer.getSample(c, i) - scalarBuffer.getSample(c, i)));
+			}
+
+			expect(simdBuffer.getMagnitude(0, NumSamples) > 0.01f, name + ": silent output");
+			expect(maxError < 1.0e-5f, name + " with " + String(numChannels) + " channels: max error " + String(maxError));
+		}
+	}
+};
+
+static FilterTypesUnitTests filterTypesUnitTests;
+
+#endif
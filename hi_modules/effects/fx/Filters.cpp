@@ -628,10 +628,7 @@ void StaticBiquadSubType::updateCoefficients(double sampleRate, double frequency
 	default:							jassertfalse; break;
 	}
 
-	for (int i = 0; i < numChannels; i++)
-	{
-		filters[i].setCoefficients(currentCoefficients);
-	}
+	active = true;
 }
 
 
@@ -313,22 +313,40 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 		else
 		{
 			FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), thisSustainValue, numSamples);
+
+			if (!usePerSampleRendering)
+				setBlockIsConstant(thisSustainValue);
 			startSample += numSamples;
 		}
 
 		state->lastSustainValue = thisSustainValue;
 		state->current_value = thisSustainValue;
 	}
+	else if (usePerSampleRendering)
+	{
+		float* data = internalBuffer.getWritePointer(0, startSample);
+
+		for (int i = 0; i < numSamples; i++)
+			data[i] = calculateNewValue(voiceIndex);
+	}
 	else
 	{
-		while (numSamples > 0)
+		float* data = internalBuffer.getWritePointer(0, startSample);
+		bool isConstant = false;
+		int numRendered = renderSegment(data, numSamples, isConstant);
+
+		if (numRendered == numSamples && isConstant)
 		{
-			internalBuffer.setSample(0, startSample, calculateNewValue(voiceIndex));
-			++startSample;
-			numSamples--;
+			setBlockIsConstant(data[0]);
 		}
 
-		
+		while (numRendered < numSamples)
+		{
+			data[numRendered] = calculateNewValue(voiceIndex);
+			++numRendered;
+
+			numRendered += renderSegment(data + numRendered, numSamples - numRendered, isConstant);
+		}
 	}
 
 #if ENABLE_ALL_PEAK_METERS
@@ -599,6 +617,129 @@ float AhdsrEnvelope::calculateNewValue(int /*voiceIndex*/)
 	return state->current_value;
 }
 
+int AhdsrEnvelope::renderSegment(float* data, int numSamples, bool& isConstant)
+{
+	isConstant = false;
+
+	if (numSamples <= 0)
+		return 0;
+
+	const float thisSustain = sustain * state->modValues[SustainLevelChain];
+
+	switch (state->current_state)
+	{
+	case AhdsrEnvelopeState::IDLE:
+	{
+		isConstant = true;
+		FloatVectorOperations::fill(data, state->current_value, numSamples);
+		return numSamples;
+	}
+	case AhdsrEnvelopeState::SUSTAIN:
+	{
+		isConstant = true;
+		state->current_value = thisSustain;
+		FloatVectorOperations::fill(data, thisSustain, numSamples);
+		return numSamples;
+	}
+	case AhdsrEnvelopeState::HOLD:
+	{
+		// The sample that reaches the hold time switches to the decay state, so leave it to calculateNewValue()
+		int numHold = 0;
+
+		while (numHold < numSamples && (float)(state->holdCounter + numHold + 1) < holdTimeSamples)
+			++numHold;
+
+		if (numHold > 0)
+		{
+			isConstant = true;
+			state->holdCounter += numHold;
+			state->current_value = state->attackLevel;
+			FloatVectorOperations::fill(data, state->attackLevel, numHold);
+		}
+
+		return numHold;
+	}
+	case AhdsrEnvelopeState::ATTACK:
+	{
+		if (attack == 0.0f)
+			return 0;
+
+		const float base = state->attackBase;
+		const float coef = state->attackCoef;
+		const float target = state->attackLevel > thisSustain ? state->attackLevel : thisSustain;
+
+		float value = state->current_value;
+		int i = 0;
+
+		for (; i < numSamples; i++)
+		{
+			const float nextValue = base + value * coef;
+
+			if (nextValue >= target)
+				break;
+
+			value = nextValue;
+			data[i] = value;
+		}
+
+		state->current_value = value;
+		return i;
+	}
+	case AhdsrEnvelopeState::DECAY:
+	{
+		if (decay == 0.0f)
+			return 0;
+
+		const float base = state->decayBase;
+		const float coef = state->decayCoef;
+
+		float value = state->current_value;
+		int i = 0;
+
+		for (; i < numSamples; i++)
+		{
+			const float nextValue = base + value * coef;
+
+			if ((nextValue - thisSustain) < 0.001f)
+				break;
+
+			value = nextValue;
+			data[i] = value;
+		}
+
+		state->current_value = value;
+		return i;
+	}
+	case AhdsrEnvelopeState::RELEASE:
+	{
+		if (release == 0.0f)
+			return 0;
+
+		const float base = state->releaseBase;
+		const float coef = state->releaseCoef;
+
+		float value = state->current_value;
+		int i = 0;
+
+		for (; i < numSamples; i++)
+		{
+			const float nextValue = base + value * coef;
+
+			if (nextValue <= 0.001f)
+				break;
+
+			value = nextValue;
+			data[i] = value;
+		}
+
+		state->current_value = value;
+		return i;
+	}
+	default:
+		return 0;
+	}
+}
+
 
 void AhdsrEnvelope::setAttackCurve(float newValue)
 {
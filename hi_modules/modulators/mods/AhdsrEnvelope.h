@@ -220,6 +220,12 @@ public:
 		return stateInfo;
 	};
 
+	/** Calculates every sample with calculateNewValue() instead of rendering whole segments and never flags a block as constant.
+	*
+	*	This is slower and only used by the unit tests as reference for the segment rendering.
+	*/
+	void setUsePerSampleRendering(bool shouldRenderPerSample) noexcept { usePerSampleRendering = shouldRenderPerSample; }
+
 private:
 
 	StateInfo stateInfo;
@@ -237,6 +243,19 @@ private:
 	float calcCoef(float rate, float targetRatio) const;
 
 	float calculateNewValue(int voiceIndex);
+
+	/** Renders the current segment of the state until the next state change (or the end of the block).
+	*
+	*	Returns the number of rendered samples. If it returns less than numSamples, the next sample
+	*	needs to be calculated with calculateNewValue() in order to perform the state transition.
+	*
+	*	This renders one voice at a time. ModulatorSynth::renderVoicesInParallel() does compute the
+	*	modulation of all voices in one serial pass, but it runs the whole chain of one voice before it
+	*	moves to the next. Stepping the envelope of several voices as SIMD lanes would need the chain
+	*	to run modulator by modulator across the voices, and every voice reaches its segment
+	*	boundaries at a different sample.
+	*/
+	int renderSegment(float* data, int numSamples, bool& isConstant);
 	
 	void setAttackCurve(float newValue);
 	void setDecayCurve(float newValue);
@@ -270,6 +289,8 @@ private:
 
 	float release_delta;
 
+	bool usePerSampleRendering = false;
+
 	ModulatorChain::Collection internalChains;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AhdsrEnvelope)
@@ -107,6 +107,31 @@ const GlobalModulatorContainer * GlobalModulator::getConnectedContainer() const
 	return dynamic_cast<const GlobalModulatorContainer*>(connectedContainer.get());
 }
 
+void GlobalModulator::copyContainerValues(float* destination, const float* source, int startSample, int numSamples, int divisor) const
+{
+	const int containerDivisor = getConnectedContainer()->getControlRateDivisor();
+
+	if (divisor == containerDivisor)
+	{
+		FloatVectorOperations::copy(destination, source + startSample, numSamples);
+		return;
+	}
+
+	// The container only has rendered the values up to the end of the current sub block
+	const int lastIndex = ((startSample + numSamples) * divisor - 1) / containerDivisor;
+	const float ratio = (float)divisor / (float)containerDivisor;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float position = (float)(startSample + i) * ratio;
+		const int index = jmin<int>((int)position, lastIndex);
+		const int nextIndex = jmin<int>(index + 1, lastIndex);
+		const float alpha = position - (float)index;
+
+		destination[i] = source[index] + alpha * (source[nextIndex] - source[index]);
+	}
+}
+
 void GlobalModulator::processorChanged(EventType /*t*/, Processor* /*p*/)
 {
 	// Just send a regular update message to update the GUI
@@ -142,6 +167,7 @@ StringArray GlobalModulator::getListOfAllModulatorsWithType()
 			case VoiceStart: matches = dynamic_cast<VoiceStartModulator*>(chain->getHandler()->getProcessor(i)) != nullptr; break;
 			case TimeVariant: matches = dynamic_cast<TimeVariantModulator*>(chain->getHandler()->getProcessor(i)) != nullptr; break;
 			case StaticTimeVariant: matches = dynamic_cast<TimeVariantModulator*>(chain->getHandler()->getProcessor(i)) != nullptr; break;
+			case Envelope: matches = dynamic_cast<EnvelopeModulator*>(chain->getHandler()->getProcessor(i)) != nullptr; break;
             case numTypes: jassertfalse; break;
 			}
 
@@ -440,37 +466,33 @@ void GlobalTimeVariantModulator::calculateBlock(int startSample, int numSamples)
 {
 	if (isConnected())
 	{
-		if (useTable)
-		{
-			const float *data = getConnectedContainer()->getModulationValuesForModulator(getOriginalModulator(), startSample);
-
-			const float thisInputValue = data[0];
+		const float* data = getConnectedContainer()->getModulationValuesForModulator(getOriginalModulator(), 0);
+		float* d = internalBuffer.getWritePointer(0, startSample);
 
-			int i = 0;
+		copyContainerValues(d, data, startSample, numSamples, getControlRateDivisor());
 
-			const int startIndex = startSample;
+		if (useTable)
+		{
+			const float thisInputValue = d[0];
 
-			while (--numSamples >= 0)
+			for (int i = 0; i < numSamples; i++)
 			{
-				const int tableIndex = (int)(data[i++] * 127.0f);
+				const int tableIndex = (int)(d[i] * 127.0f);
 
-				internalBuffer.setSample(0, startSample++, table->get(tableIndex));
+				d[i] = table->get(tableIndex);
 			}
 
 			invertBuffer(startSample, numSamples);
 
-
-			setOutputValue(internalBuffer.getSample(0, startIndex));
+			setOutputValue(d[0]);
 			sendTableIndexChangeMessage(false, table, thisInputValue);
 
 		}
 		else
 		{
-			FloatVectorOperations::copy(internalBuffer.getWritePointer(0, startSample), getConnectedContainer()->getModulationValuesForModulator(getOriginalModulator(), startSample), numSamples);
-
 			invertBuffer(startSample, numSamples);
 
-			setOutputValue(internalBuffer.getSample(0, startSample));
+			setOutputValue(d[0]);
 		}
 
 		
@@ -492,4 +514,170 @@ void GlobalTimeVariantModulator::invertBuffer(int startSample, int numSamples)
 	}
 }
 
+GlobalEnvelopeModulator::GlobalEnvelopeModulator(MainController *mc, const String &id, int numVoices, Modulation::Mode m) :
+EnvelopeModulator(mc, id, numVoices, m),
+Modulation(m),
+GlobalModulator(mc)
+{
+	// The monophonic / retrigger behaviour is defined by the original envelope
+	parameterNames.clear();
+	parameterNames.add("UseTable");
+	parameterNames.add("Inverted");
+
+	for (int i = 0; i < polyManager.getVoiceAmount(); i++) states.add(createSubclassedState(i));
+
+	monophonicState = createSubclassedState(-1);
+}
+
+void GlobalEnvelopeModulator::restoreFromValueTree(const ValueTree &v)
+{
+	EnvelopeModulator::restoreFromValueTree(v);
+	loadFromValueTree(v);
+}
+
+ValueTree GlobalEnvelopeModulator::exportAsValueTree() const
+{
+	ValueTree v = EnvelopeModulator::exportAsValueTree();
+
+	v.removeProperty("Monophonic", nullptr);
+	v.removeProperty("Retrigger", nullptr);
+
+	saveToValueTree(v);
+
+	return v;
+}
+
+ProcessorEditorBody * GlobalEnvelopeModulator::createEditor(ProcessorEditor *parentEditor)
+{
+#if USE_BACKEND
+	return new GlobalModulatorEditor(parentEditor);
+#else
+	ignoreUnused(parentEditor);
+	jassertfalse;
+	return nullptr;
+#endif
+}
+
+void GlobalEnvelopeModulator::setInternalAttribute(int parameterIndex, float newValue)
+{
+	switch (parameterIndex)
+	{
+	case UseTable:			useTable = (newValue > 0.5f); break;
+	case Inverted:			inverted = (newValue > 0.5f); break;
+	default:				jassertfalse; break;
+	}
+}
+
+float GlobalEnvelopeModulator::getAttribute(int parameterIndex) const
+{
+	switch (parameterIndex)
+	{
+	case UseTable:			return useTable ? 1.0f : 0.0f;
+	case Inverted:			return inverted ? 1.0f : 0.0f;
+	default:				jassertfalse; return -1.0f;
+	}
+}
+
+void GlobalEnvelopeModulator::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	EnvelopeModulator::prepareToPlay(sampleRate, samplesPerBlock);
+
+	// Cache the synth so we don't have to search it in the audio thread
+	parentSynth = ProcessorHelpers::findParentProcessor(this, true);
+}
+
+float GlobalEnvelopeModulator::startVoice(int voiceIndex)
+{
+	EnvelopeModulator::startVoice(voiceIndex);
+
+	auto state = static_cast<GlobalEnvelopeState*>(states[voiceIndex]);
+
+	state->isPressed = true;
+	state->containerVoiceIndex = -1;
+
+	auto synth = dynamic_cast<ModulatorSynth*>(parentSynth.get());
+
+	if (isConnected() && synth != nullptr)
+	{
+		auto v = static_cast<ModulatorSynthVoice*>(synth->getVoice(voiceIndex));
+
+		state->eventId = v->getCurrentHiseEvent().getEventId();
+		state->containerVoiceIndex = getConnectedContainer()->getVoiceIndexForEvent(state->eventId);
+	}
+
+	return 1.0f;
+}
+
+void GlobalEnvelopeModulator::stopVoice(int voiceIndex)
+{
+	EnvelopeModulator::stopVoice(voiceIndex);
+
+	static_cast<GlobalEnvelopeState*>(states[voiceIndex])->isPressed = false;
+}
+
+void GlobalEnvelopeModulator::reset(int voiceIndex)
+{
+	EnvelopeModulator::reset(voiceIndex);
+
+	auto state = static_cast<GlobalEnvelopeState*>(states[voiceIndex]);
+
+	state->isPressed = false;
+	state->containerVoiceIndex = -1;
+}
+
+bool GlobalEnvelopeModulator::isPlaying(int voiceIndex) const
+{
+	auto state = static_cast<GlobalEnvelopeState*>(states[voiceIndex]);
+
+	if (isConnected() && state->containerVoiceIndex != -1 && !getOriginalModulator()->isBypassed())
+		return getConnectedContainer()->isEnvelopePlaying(getOriginalModulator(), state->containerVoiceIndex, state->eventId);
+
+	// Behave like there is no envelope if the event isn't played by the container
+	return state->isPressed;
+}
+
+void GlobalEnvelopeModulator::calculateBlock(int startSample, int numSamples)
+{
+	const int voiceIndex = polyManager.getCurrentVoice();
+	auto state = static_cast<GlobalEnvelopeState*>(states[voiceIndex]);
+
+	const float* data = nullptr;
+
+	if (isConnected() && state->containerVoiceIndex != -1)
+		data = getConnectedContainer()->getEnvelopeValuesForModulator(getOriginalModulator(), state->containerVoiceIndex, state->eventId, 0);
+
+	float* d = internalBuffer.getWritePointer(0, startSample);
+
+	if (data == nullptr)
+	{
+		FloatVectorOperations::fill(d, 1.0f, numSamples);
+		return;
+	}
+
+	// The envelope modulation is applied in place, so we need to copy the values
+	// before doing the table lookup and the inversion.
+	copyContainerValues(d, data, startSample, numSamples, getControlRateDivisor());
+
+	if (useTable)
+	{
+		const float thisInputValue = d[0];
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int tableIndex = jlimit<int>(0, 127, (int)(d[i] * 127.0f));
+			const float value = table->get(tableIndex);
+
+			d[i] = inverted ? 1.0f - value : value;
+		}
+
+		if (voiceIndex == polyManager.getLastStartedVoice())
+			sendTableIndexChangeMessage(false, table, thisInputValue);
+	}
+	else if (inverted)
+	{
+		for (int i = 0; i < numSamples; i++)
+			d[i] = 1.0f - d[i];
+	}
+}
+
 } // namespace hise
@@ -61,6 +61,7 @@ public:
 		VoiceStart,
 		TimeVariant,
 		StaticTimeVariant,
+		Envelope,
 		numTypes
 	};
 
@@ -91,6 +92,13 @@ protected:
 
 	GlobalModulator(MainController *mc);
 
+	/** Copies the values of the connected container into the destination.
+	*
+	*	The container renders at its own control rate, so if this modulator uses a smaller control rate
+	*	divisor, the values are interpolated. The source must point to the start of the container buffer.
+	*/
+	void copyContainerValues(float* destination, const float* source, int startSample, int numSamples, int divisor) const;
+
 	ScopedPointer<MidiTable> table;
 
 	bool useTable = false;
@@ -238,6 +246,72 @@ private:
 
 };
 
+/** A modulator that connects to a global EnvelopeModulator (eg. AHDSR).
+@ingroup modulatorTypes
+
+The envelope is calculated once for every voice of the GlobalModulatorContainer and this modulator 
+reads the values of the voice that was started with the same event. The attack / release phase is
+controlled by the original envelope, so the voice will be kept alive until it is finished.
+*/
+class GlobalEnvelopeModulator : public EnvelopeModulator,
+								public GlobalModulator
+{
+public:
+
+	SET_PROCESSOR_NAME("GlobalEnvelopeModulator", "Global Envelope Modulator");
+
+	GlobalModulator::ModulatorType getModulatorType() const override { return GlobalModulator::Envelope; };
+
+	GlobalEnvelopeModulator(MainController *mc, const String &id, int numVoices, Modulation::Mode m);
+
+	~GlobalEnvelopeModulator() {};
+
+	void restoreFromValueTree(const ValueTree &v) override;
+
+	ValueTree exportAsValueTree() const override;
+
+	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
+
+	void setInternalAttribute(int parameterIndex, float newValue) override;
+
+	float getAttribute(int parameterIndex) const override;
+
+	float getDefaultValue(int /*parameterIndex*/) const override { return 0.0f; }
+
+	virtual Processor *getChildProcessor(int /*processorIndex*/) override final { return nullptr; };
+
+	virtual const Processor *getChildProcessor(int /*processorIndex*/) const override final { return nullptr; };
+
+	virtual int getNumChildProcessors() const override final { return 0; };
+
+	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+
+	float startVoice(int voiceIndex) override;
+	void stopVoice(int voiceIndex) override;
+	void reset(int voiceIndex) override;
+	bool isPlaying(int voiceIndex) const override;
+
+	void calculateBlock(int startSample, int numSamples) override;
+
+	/** @internal Stores the event and the voice of the container that plays it. */
+	struct GlobalEnvelopeState : public EnvelopeModulator::ModulatorState
+	{
+		GlobalEnvelopeState(int voiceIndex) :
+			ModulatorState(voiceIndex)
+		{};
+
+		int containerVoiceIndex = -1;
+		uint16 eventId = 0;
+		bool isPressed = false;
+	};
+
+	ModulatorState *createSubclassedState(int voiceIndex) const override { return new GlobalEnvelopeState(voiceIndex); };
+
+private:
+
+	WeakReference<Processor> parentSynth;
+};
+
 
 } // namespace hise
 
@@ -87,8 +87,6 @@ LfoModulator::LfoModulator(MainController *mc, const String &id, Modulation::Mod
 	parameterNames.add(Identifier("NumSteps"));
 	parameterNames.add(Identifier("LoopEnabled"));
 
-	frequencyUpdater.setManualCountLimit(4096/HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR);
-
 	randomGenerator.setSeedRandomly();
 
 	getMainController()->addTempoListener(this);
@@ -472,6 +470,9 @@ void LfoModulator::prepareToPlay(double sampleRate, int samplesPerBlock)
 
 		inputMerger.setManualCountLimit(10);
 
+		// Update the frequency modulation every 4096 samples at the control rate of the parent chain
+		frequencyUpdater.setManualCountLimit(4096 / getControlRateDivisor());
+
 		valueUpdater.setManualCountLimit(LFO_DOWNSAMPLING_FACTOR);
 
 		randomGenerator.setSeedRandomly();
@@ -510,8 +511,9 @@ void LfoModulator::calculateBlock(int startSample, int numSamples)
 
 	float *mod = internalBuffer.getWritePointer(0, startIndex);
 
-	const int pseudoOffset = startIndex * HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
-	const int pseudoSize = numValues * HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	// The internal chains use the same control rate as this modulator
+	const int pseudoOffset = startIndex * getControlRateDivisor();
+	const int pseudoSize = numValues * getControlRateDivisor();
 
 	for (auto& mb : modChains)
 	{
@@ -47,6 +47,8 @@ ModulatorSynth(mc, id, numVoices)
 	for (int i = 0; i < numVoices; i++) addVoice(new GlobalModulatorContainerVoice(this));
 	addSound(new GlobalModulatorContainerSound());
 
+	voiceEventIds.insertMultiple(0, -1, numVoices);
+
 	disableChain(PitchModulation, true);
 	disableChain(ModulatorSynth::EffectChain, true);
 
@@ -108,6 +110,56 @@ float GlobalModulatorContainer::getConstantVoiceValue(Processor *p, int noteNumb
 	return 1.0f;
 }
 
+int GlobalModulatorContainer::getVoiceIndexForEvent(uint16 eventId) const
+{
+	return voiceEventIds.indexOf((int)eventId);
+}
+
+const float* GlobalModulatorContainer::getEnvelopeValuesForModulator(const Processor* p, int voiceIndex, uint16 eventId, int startIndex) const
+{
+	if (!isPositiveAndBelow(voiceIndex, voiceEventIds.size()) || voiceEventIds[voiceIndex] != (int)eventId)
+		return nullptr;
+
+	for (const auto& ed : envelopeData)
+	{
+		if (ed.getModulator() == p)
+			return ed.getReadPointer(voiceIndex, startIndex);
+	}
+
+	return nullptr;
+}
+
+bool GlobalModulatorContainer::isEnvelopePlaying(const Processor* p, int voiceIndex, uint16 eventId) const
+{
+	if (!isPositiveAndBelow(voiceIndex, voiceEventIds.size()) || voiceEventIds[voiceIndex] != (int)eventId)
+		return false;
+
+	for (const auto& ed : envelopeData)
+	{
+		if (auto mod = ed.getModulator())
+		{
+			if (mod == p)
+				return !mod->isBypassed() && mod->isPlaying(voiceIndex);
+		}
+	}
+
+	return false;
+}
+
+bool GlobalModulatorContainer::isAnyEnvelopePlaying(int voiceIndex) const
+{
+	for (const auto& ed : envelopeData)
+	{
+		if (auto mod = ed.getModulator())
+		{
+			if (!mod->isBypassed() && mod->isPlaying(voiceIndex))
+				return true;
+		}
+	}
+
+	return false;
+}
+
 ProcessorEditorBody* GlobalModulatorContainer::createEditor(ProcessorEditor *parentEditor)
 {
 
@@ -129,12 +181,16 @@ void GlobalModulatorContainer::preStartVoice(int voiceIndex, int noteNumber)
 	{
 		vd.saveValue(noteNumber, voiceIndex);
 	}
+
+	// The event ID stays after the voice was reset so that the receivers can read the last block
+	auto v = static_cast<ModulatorSynthVoice*>(getVoice(voiceIndex));
+	voiceEventIds.set(voiceIndex, (int)v->getCurrentHiseEvent().getEventId());
 }
 
 void GlobalModulatorContainer::preVoiceRendering(int startSample, int numThisTime)
 {
-	int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
-	int numSamples_cr = numThisTime / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+	int startSample_cr = startSample / getControlRateDivisor();
+	int numSamples_cr = numThisTime / getControlRateDivisor();
 	
 	auto scratchBuffer = modChains[GainChain].getScratchBuffer();
 
@@ -157,6 +213,40 @@ void GlobalModulatorContainer::preVoiceRendering(int startSample, int numThisTim
 	}
 }
 
+void GlobalModulatorContainer::renderVoice(int startSample, int numThisTime)
+{
+	ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthVoiceRendering);
+
+	clearPendingRemoveVoices();
+
+	const int startSample_cr = startSample / getControlRateDivisor();
+	const int numSamples_cr = numThisTime / getControlRateDivisor();
+
+	auto scratchBuffer = modChains[GainChain].getScratchBuffer();
+
+	// The container voices don't produce any signal, so we skip the voice modulation
+	// of the gain chain and render each envelope into its own buffer instead.
+	for (auto v : activeVoices)
+	{
+		const int voiceIndex = v->getVoiceIndex();
+
+		for (auto& ed : envelopeData)
+		{
+			if (auto mod = ed.getModulator())
+			{
+				auto modBuffer = ed.initialiseBuffer(voiceIndex, startSample_cr, numSamples_cr);
+
+				if (!mod->isBypassed())
+					mod->render(voiceIndex, modBuffer, scratchBuffer, startSample_cr, numSamples_cr);
+			}
+		}
+
+		v->renderNextBlock(internalBuffer, startSample, numThisTime);
+	}
+
+	clearPendingRemoveVoices();
+}
+
 void GlobalModulatorContainer::prepareToPlay(double newSampleRate, int samplesPerBlock)
 {
 	ModulatorSynth::prepareToPlay(newSampleRate, samplesPerBlock);
@@ -164,6 +254,9 @@ void GlobalModulatorContainer::prepareToPlay(double newSampleRate, int samplesPe
 	for (auto& d : timeVariantData)
 		d.prepareToPlay(samplesPerBlock);
 
+	for (auto& d : envelopeData)
+		d.prepareToPlay(samplesPerBlock);
+
 	for (int i = 0; i < data.size(); i++)
 	{
 		data[i]->prepareToPlay(newSampleRate, samplesPerBlock);
@@ -267,6 +360,13 @@ void GlobalModulatorContainer::refreshList()
 		timeVariantData.add(TimeVariantData(mod, getLargestBlockSize()));
 		//mod->deactivateIntensitySmoothing();
 	}
+
+	envelopeData.clearQuick();
+
+	for (auto& mod : handler_->activeEnvelopesList)
+	{
+		envelopeData.add(EnvelopeData(mod, voiceEventIds.size(), getLargestBlockSize()));
+	}
 }
 
 void GlobalModulatorContainerVoice::startNote(int midiNoteNumber, float /*velocity*/, SynthesiserSound*, int /*currentPitchWheelPosition*/)
@@ -284,8 +384,15 @@ void GlobalModulatorContainerVoice::calculateBlock(int startSample, int numSampl
 	
 	FloatVectorOperations::fill(voiceBuffer.getWritePointer(0, startSample), 0.0f, numSamples);
 	FloatVectorOperations::fill(voiceBuffer.getWritePointer(1, startSample), 0.0f, numSamples);
+}
+
+void GlobalModulatorContainerVoice::checkRelease()
+{
+	auto container = static_cast<GlobalModulatorContainer*>(getOwnerSynth());
 
-	resetVoice();
+	// Without envelopes the voice only lasts one block (it just triggers the voice start modulators)
+	if (isBeingKilled() || !container->isAnyEnvelopePlaying(voiceIndex))
+		resetVoice();
 }
 
 GlobalModulatorData::GlobalModulatorData(Processor *modulator_):
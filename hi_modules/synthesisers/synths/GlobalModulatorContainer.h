@@ -57,6 +57,9 @@ public:
 	void startNote(int midiNoteNumber, float /*velocity*/, SynthesiserSound*, int /*currentPitchWheelPosition*/) override;
 	void calculateBlock(int startSample, int numSamples) override;;
 
+	/** Keeps the voice alive as long as one of the global envelopes is still playing. */
+	void checkRelease() override;
+
 };
 
 template <class ModulatorType> class GlobalModulatorDataBase
@@ -80,6 +83,14 @@ public:
 		return static_cast<ModulatorType*>(mod.get());
 	}
 
+	const ModulatorType* getModulator() const
+	{
+		if (mod.get() == nullptr)
+			return nullptr;
+
+		return static_cast<const ModulatorType*>(mod.get());
+	}
+
 private:
 
 	WeakReference<Modulator> mod;
@@ -172,6 +183,44 @@ private:
 	bool isClear = false;
 };
 
+/** Stores the values of a global envelope for every voice of the container.
+*
+*	The receivers look up the voice that plays their event and read the values from here, so
+*	the envelope is only calculated once per event, no matter how many receivers use it.
+*/
+class EnvelopeData : public GlobalModulatorDataBase<EnvelopeModulator>
+{
+public:
+
+	EnvelopeData(Modulator* mod, int numVoices, int samplesPerBlock) :
+		GlobalModulatorDataBase(mod),
+		savedValuesForBlock(jmax<int>(1, numVoices), 0)
+	{
+		prepareToPlay(samplesPerBlock);
+	}
+
+	void prepareToPlay(int samplesPerBlock)
+	{
+		ProcessorHelpers::increaseBufferIfNeeded(savedValuesForBlock, samplesPerBlock);
+	}
+
+	const float* getReadPointer(int voiceIndex, int startSample) const
+	{
+		return savedValuesForBlock.getReadPointer(voiceIndex, startSample);
+	}
+
+	float* initialiseBuffer(int voiceIndex, int startSample, int numSamples)
+	{
+		auto wp = savedValuesForBlock.getWritePointer(voiceIndex, 0);
+		FloatVectorOperations::fill(wp + startSample, 1.0f, numSamples);
+		return wp;
+	}
+
+private:
+
+	AudioSampleBuffer savedValuesForBlock;
+};
+
 class GlobalModulatorData
 {
 public:
@@ -330,6 +379,9 @@ public:
 	float getVoiceStartValueFor(const Processor *voiceStartModulator);
 
     int getNumActiveVoices() const override { return 0; };
+
+	/** The global modulators in other synths use the values of this container, so it must be rendered first. */
+	bool needsToBeRenderedBeforeSiblings() const override { return true; }
     
 	GlobalModulatorContainer(MainController *mc, const String &id, int numVoices);;
 
@@ -342,6 +394,24 @@ public:
 	const float *getModulationValuesForModulator(Processor *p, int startIndex);
 	float getConstantVoiceValue(Processor *p, int noteNumber);
 
+	/** Returns the index of the voice that was started with the given event or -1 if there is no such voice. */
+	int getVoiceIndexForEvent(uint16 eventId) const;
+
+	/** Returns the values of the global envelope for the given voice.
+	*
+	*	If the voice has been reused for another event in the meantime, it will return nullptr.
+	*/
+	const float* getEnvelopeValuesForModulator(const Processor* p, int voiceIndex, uint16 eventId, int startIndex) const;
+
+	/** Checks if the global envelope is still playing the given event. */
+	bool isEnvelopePlaying(const Processor* p, int voiceIndex, uint16 eventId) const;
+
+	/** Returns the number of audio samples per value in the modulation buffers of this container. */
+	int getControlRateDivisor() const noexcept { return modChains[GainChain].getControlRateDivisor(); }
+
+	/** Checks if any of the global envelopes is still playing in the given voice. */
+	bool isAnyEnvelopePlaying(int voiceIndex) const;
+
 	ProcessorEditorBody* createEditor(ProcessorEditor *parentEditor) override;
 
 	void changeListenerCallback(SafeChangeBroadcaster *) { refreshList(); }
@@ -351,6 +421,9 @@ public:
 
 	void preVoiceRendering(int startSample, int numThisTime) override;
 
+	/** Renders every global envelope separately for each active voice so that the receivers can pick the values of their event. */
+	void renderVoice(int startSample, int numThisTime) override;
+
 	void addProcessorsWhenEmpty() override {};
 
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
@@ -370,6 +443,9 @@ private:
 
 	Array<VoiceStartData> voiceStartData;
 	Array<TimeVariantData> timeVariantData;
+	Array<EnvelopeData> envelopeData;
+
+	Array<int> voiceEventIds;
 
 	Array<WeakReference<ModulatorListListener>> modListeners;
 
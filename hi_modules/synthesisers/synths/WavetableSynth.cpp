@@ -128,111 +128,79 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 	const int samplesToCopy = numSamples;
 
 	const float *voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
-		
+	const int maxTableIndex = currentSound->getWavetableAmount() - 1;
+	const float normaliseGain = 1.0f / currentSound->getUnnormalizedMaximum();
+
+	WavetableSound::MipLevelFade mipLevelFade;
+
 	if (auto tableValues = getTableModulationValues())
 	{
-		while (--numSamples >= 0)
+		for (int i = 0; i < numSamples; i++)
 		{
-			// Get the two indexes for the table position
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
 
-			int index = (int)voiceUptime;
+			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
 
-			const int i1 = index % (tableSize);
+			// The mip levels follow the pitch within the block
+			if (i % MipLevelFadeInterval == 0)
+				mipLevelFade = currentSound->getMipLevelFade(delta);
 
-			int i2 = i1 + 1;
+			const int i1 = (int)voiceUptime % tableSize;
+			const float tableModValue = tableValues[startSample];
 
-			if (i2 >= tableSize)
-			{
-				const float tableModValue = tableValues[startSample];
-				currentTableIndex = roundToInt(tableModValue * 63);
-				i2 = 0;
-			}
+			if (i1 + 1 >= tableSize)
+				currentTableIndex = roundToInt(tableModValue * (float)maxTableIndex);
 
-			const float tableModValue = tableValues[startSample];
-			const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * 63.0f;
+			const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * (float)maxTableIndex;
 
 			const int lowerTableIndex = (int)(tableValue);
-			const int upperTableIndex = jmin(63, lowerTableIndex + 1);
+			const int upperTableIndex = jmin(maxTableIndex, lowerTableIndex + 1);
 			const float tableDelta = tableValue - (float)lowerTableIndex;
 			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
 
-			lowerTable = currentSound->getWaveTableData(lowerTableIndex);
-			upperTable = currentSound->getWaveTableData(upperTableIndex);
-
 			float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
 
 			tableGainValue *= getGainValue(tableModValue);
 
-			float u1 = upperTable[i1];
-			float u2 = upperTable[i2];
-
-			float l1 = lowerTable[i1];
-			float l2 = lowerTable[i2];
-
-			const float alpha = float(voiceUptime) - (float)index;
-			//const float invAlpha = 1.0f - alpha;
+			const float lowerSample = currentSound->getInterpolatedSample(lowerTableIndex, voiceUptime, mipLevelFade);
 
-			const float upperSample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
+			float sample = lowerSample;
 
-			const float lowerSample = tableGainInterpolator.interpolateLinear(l1, l2, alpha);
-
-			float sample = lowerTableIndex != upperTableIndex ? tableGainInterpolator.interpolateLinear(lowerSample, upperSample, tableDelta) : lowerSample;
-
-			sample *= tableGainValue;
-
-			sample *= 1.0f / currentSound->getUnnormalizedMaximum();
+			if (lowerTableIndex != upperTableIndex)
+			{
+				const float upperSample = currentSound->getInterpolatedSample(upperTableIndex, voiceUptime, mipLevelFade);
+				sample = tableGainInterpolator.interpolateLinear(lowerSample, upperSample, tableDelta);
+			}
 
 			// Stereo mode assumed
-			voiceBuffer.setSample(0, startSample, sample);
-
-			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
-
-			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+			voiceBuffer.setSample(0, startSample, sample * tableGainValue * normaliseGain);
 
 			voiceUptime += delta;
-
 			++startSample;
 		}
 	}
 	else
 	{
 		const float tableModValue = static_cast<WavetableSynth*>(getOwnerSynth())->getConstantTableModValue();
-		currentTableIndex = roundToInt(tableModValue * 63);
+		currentTableIndex = jlimit<int>(0, maxTableIndex, roundToInt(tableModValue * (float)maxTableIndex));
 		lowerTable = currentSound->getWaveTableData(currentTableIndex);
-		float tableGainValue = currentSound->getUnnormalizedGainValue(currentTableIndex);
+		upperTable = lowerTable;
 
-		while (--numSamples >= 0)
-		{
-			// Get the two indexes for the table position
+		const float tableGainValue = currentSound->getUnnormalizedGainValue(currentTableIndex) * normaliseGain;
 
-			int index = (int)voiceUptime;
-
-			const int i1 = index % (tableSize);
-
-			int i2 = i1 + 1;
-
-			if (i2 >= tableSize)
-			{
-				i2 = 0;
-			}
-
-			float u1 = upperTable[i1];
-			float u2 = upperTable[i2];
-
-			const float alpha = float(voiceUptime) - (float)index;
+		for (int i = 0; i < numSamples; i++)
+		{
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
 
-			float sample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
+			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
 
-			sample *= tableGainValue;
+			if (i % MipLevelFadeInterval == 0)
+				mipLevelFade = currentSound->getMipLevelFade(delta);
 
-			sample *= 1.0f / currentSound->getUnnormalizedMaximum();
+			const float sample = currentSound->getInterpolatedSample(currentTableIndex, voiceUptime, mipLevelFade);
 
 			// Stereo mode assumed
-			voiceBuffer.setSample(0, startSample, sample);
-
-			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
-
-			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+			voiceBuffer.setSample(0, startSample, sample * tableGainValue);
 
 			voiceUptime += delta;
 			++startSample;
@@ -283,7 +251,8 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData)
 
 	maximum = wavetables.getMagnitude(0, numSamples);
 
-	wavetableAmount = wavetableData.getProperty("amount", 64);
+	wavetableAmount = jmax<int>(1, wavetableData.getProperty("amount", 64));
+	unnormalizedGainValues.calloc(wavetableAmount);
 
 	sampleRate = wavetableData.getProperty("sampleRate", 48000.0);
 
@@ -300,6 +269,11 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData)
 
 	normalizeTables();
 
+	createMipLevels();
+
+	// The tables live in the mip level data from now on
+	wavetables.setSize(0, 0);
+
 	pitchRatio = 1.0;
 }
 
@@ -307,10 +281,7 @@ const float * WavetableSound::getWaveTableData(int wavetableIndex) const
 {
 	if (wavetableIndex < wavetableAmount)
 	{
-		jassert((wavetableIndex + 1) * wavetableSize <= wavetables.getNumSamples());
-
-		return wavetables.getReadPointer(0, wavetableIndex * wavetableSize);
-
+		return mipLevelData + wavetableIndex * getMipLevelStride(0);
 	}
 	else
 	{
@@ -318,6 +289,29 @@ const float * WavetableSound::getWaveTableData(int wavetableIndex) const
 	}
 }
 
+const float* WavetableSound::getMipLevelData(int mipLevel) const
+{
+	jassert(isPositiveAndBelow(mipLevel, numMipLevels));
+
+	return mipLevelData + mipLevelOffsets[mipLevel];
+}
+
+WavetableSound::MipLevelFade WavetableSound::getMipLevelFade(double uptimeDelta) const noexcept
+{
+	MipLevelFade fade;
+
+	if (uptimeDelta <= 1.0 || numMipLevels == 1)
+		return fade;
+
+	const double position = jmin<double>(std::log2(uptimeDelta), (double)(numMipLevels - 1));
+
+	fade.lowerLevel = (int)position;
+	fade.upperLevel = jmin(fade.lowerLevel + 1, numMipLevels - 1);
+	fade.upperGain = fade.upperLevel != fade.lowerLevel ? (float)(position - (double)fade.lowerLevel) : 0.0f;
+
+	return fade;
+}
+
 void WavetableSound::calculatePitchRatio(double playBackSampleRate)
 {
 	const double idealCycleLength = playBackSampleRate / MidiMessage::getMidiNoteInHertz(noteNumber);
@@ -349,4 +343,81 @@ void WavetableSound::normalizeTables()
 	maximum = 1.0f;
 }
 
+void WavetableSound::createMipLevels()
+{
+	numMipLevels = 1;
+
+	// The band-limiting needs a power of two table size for the FFT
+	if (isPowerOfTwo(wavetableSize) && wavetableSize >= 8)
+	{
+		const int order = roundToInt(std::log2((double)wavetableSize));
+		numMipLevels = jlimit<int>(1, HISE_WAVETABLE_MAX_MIP_LEVELS, order - 1);
+	}
+
+	int numTotalSamples = 0;
+
+	for (int mipLevel = 0; mipLevel < numMipLevels; mipLevel++)
+	{
+		mipLevelOffsets[mipLevel] = numTotalSamples;
+		numTotalSamples += wavetableAmount * getMipLevelStride(mipLevel);
+	}
+
+	mipLevelData.calloc(numTotalSamples);
+
+	for (int i = 0; i < wavetableAmount; i++)
+	{
+		float* table = mipLevelData + i * getMipLevelStride(0);
+
+		FloatVectorOperations::copy(table, wavetables.getReadPointer(0, i * wavetableSize), wavetableSize);
+		table[wavetableSize] = table[0];
+	}
+
+	if (numMipLevels == 1)
+		return;
+
+	const int order = roundToInt(std::log2((double)wavetableSize));
+
+	dsp::FFT fft(order);
+
+	HeapBlock<float> spectrum;
+	HeapBlock<float> levelData;
+
+	spectrum.calloc(2 * wavetableSize);
+	levelData.calloc(2 * wavetableSize);
+
+	for (int i = 0; i < wavetableAmount; i++)
+	{
+		FloatVectorOperations::clear(spectrum, 2 * wavetableSize);
+		FloatVectorOperations::copy(spectrum, getWaveTableData(i), wavetableSize);
+
+		fft.performRealOnlyForwardTransform(spectrum);
+
+		for (int mipLevel = 1; mipLevel < numMipLevels; mipLevel++)
+		{
+			const int levelSize = getMipLevelTableSize(mipLevel);
+			const int nyquistBin = levelSize / 2;
+			const int decimation = 1 << mipLevel;
+
+			FloatVectorOperations::copy(levelData, spectrum, 2 * wavetableSize);
+
+			// Remove the bins from the Nyquist frequency of the smaller table upwards along with their negative frequency mirrors
+			for (int bin = nyquistBin; bin <= wavetableSize - nyquistBin; bin++)
+			{
+				levelData[2 * bin] = 0.0f;
+				levelData[2 * bin + 1] = 0.0f;
+			}
+
+			fft.performRealOnlyInverseTransform(levelData);
+
+			// The band-limited table can be decimated without aliasing
+			float* table = mipLevelData + mipLevelOffsets[mipLevel] + i * getMipLevelStride(mipLevel);
+
+			for (int s = 0; s < levelSize; s++)
+				table[s] = levelData[s * decimation];
+
+			table[levelSize] = table[0];
+		}
+	}
+}
+
 } // namespace hise
@@ -39,6 +39,15 @@ namespace hise { using namespace juce;
 
 #define WAVETABLE_HQ_MODE 1
 
+/** The maximum number of octave-spaced band-limited versions that are created for each wavetable.
+*
+*	Every level halves the table size, so all levels together need about twice the memory of the
+*	wavetable data. Set it to 1 to disable the band-limiting and keep only the original tables.
+*/
+#ifndef HISE_WAVETABLE_MAX_MIP_LEVELS
+#define HISE_WAVETABLE_MAX_MIP_LEVELS 8
+#endif
+
 class WavetableSynth;
 
 class WavetableSound: public ModulatorSynthSound
@@ -67,6 +76,55 @@ public:
 	*/
 	const float *getWaveTableData(int wavetableIndex) const;
 
+	/** Returns a read pointer to the first table of the given mip level.
+	*
+	*	Every mip level halves the table size, so a position in the original table has to be divided by
+	*	2^mipLevel. All tables of a mip level are stored consecutively with getMipLevelStride() samples per table.
+	*	Each table is followed by a copy of its first sample, so the interpolation can read one sample past the end.
+	*/
+	const float* getMipLevelData(int mipLevel) const;
+
+	/** Returns the number of samples of a single table in the given mip level. */
+	int getMipLevelTableSize(int mipLevel) const noexcept { return wavetableSize >> mipLevel; }
+
+	/** Returns the distance between two tables in the given mip level. */
+	int getMipLevelStride(int mipLevel) const noexcept { return getMipLevelTableSize(mipLevel) + 1; }
+
+	/** The two neighbouring mip levels that are crossfaded for a playback speed. */
+	struct MipLevelFade
+	{
+		int lowerLevel = 0;
+		int upperLevel = 0;
+		float upperGain = 0.0f;
+	};
+
+	/** Returns the two mip levels around the given increment per sample.
+	*
+	*	The gain of the upper level is the fractional part of log2(uptimeDelta), so the harmonics fade out
+	*	smoothly when the pitch changes instead of switching at every octave. The upper level never aliases.
+	*/
+	MipLevelFade getMipLevelFade(double uptimeDelta) const noexcept;
+
+	/** Returns the linear interpolated value of a table at the given position in the original table size.
+	*
+	*	The position is scaled down for every mip level, and the two levels of the fade are mixed together.
+	*/
+	float getInterpolatedSample(int tableIndex, double uptime, const MipLevelFade& fade) const noexcept
+	{
+		const float lowerSample = getInterpolatedSampleFromLevel(tableIndex, fade.lowerLevel, uptime);
+
+		if (fade.upperGain == 0.0f)
+			return lowerSample;
+
+		const float upperSample = getInterpolatedSampleFromLevel(tableIndex, fade.upperLevel, uptime);
+
+		return (1.0f - fade.upperGain) * lowerSample + fade.upperGain * upperSample;
+	}
+
+	int getNumMipLevels() const noexcept { return numMipLevels; }
+
+	int getWavetableAmount() const noexcept { return wavetableAmount; }
+
 	float getUnnormalizedMaximum()
 	{
 		return unnormalizedMaximum;
@@ -94,7 +152,7 @@ public:
 
 	float getUnnormalizedGainValue(int tableIndex)
 	{
-		jassert(tableIndex < 64);
+		jassert(tableIndex < wavetableAmount);
 		jassert(tableIndex >= 0);
 
 		return unnormalizedGainValues[tableIndex];
@@ -102,9 +160,33 @@ public:
 
 private:
 
+	/** Copies the normalised tables into the first mip level and creates the band-limited levels. */
+	void createMipLevels();
+
+	float getInterpolatedSampleFromLevel(int tableIndex, int mipLevel, double uptime) const noexcept
+	{
+		jassert(isPositiveAndBelow(tableIndex, wavetableAmount));
+		jassert(isPositiveAndBelow(mipLevel, numMipLevels));
+
+		// Every mip level halves the table size, so the position is scaled down accordingly (this is exact for powers of two)
+		const double levelUptime = uptime * (1.0 / (double)(1 << mipLevel));
+		const int index = (int)levelUptime;
+		const int i1 = index % getMipLevelTableSize(mipLevel);
+		const float alpha = float(levelUptime) - (float)index;
+
+		// Every table has a copy of its first sample at the end, so i1 + 1 never wraps
+		const float* table = mipLevelData + mipLevelOffsets[mipLevel] + tableIndex * getMipLevelStride(mipLevel) + i1;
+
+		return (1.0f - alpha) * table[0] + alpha * table[1];
+	}
+
 	float maximum;
 	float unnormalizedMaximum;
-	float unnormalizedGainValues[64];
+	HeapBlock<float> unnormalizedGainValues;
+
+	HeapBlock<float> mipLevelData;
+	int mipLevelOffsets[HISE_WAVETABLE_MAX_MIP_LEVELS];
+	int numMipLevels = 1;
 
 	BigInteger midiNotes;
 	int noteNumber;
@@ -185,6 +267,9 @@ public:
 
 private:
 
+	/** The number of samples between two updates of the mip level fade. */
+	static constexpr int MipLevelFadeInterval = 8;
+
 	WavetableSynth *wavetableSynth;
 
 	int octaveTransposeFactor;
@@ -0,0 +1,367 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class WavetableSynthUnitTests : public UnitTest
+{
+public:
+
+	WavetableSynthUnitTests() :
+		UnitTest("Testing wavetable mip levels")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testNumMipLevels();
+		testMipLevelFade();
+		testBandLimiting();
+		testInterpolatedSample();
+		runBenchmark();
+		runRenderBenchmark();
+	}
+
+private:
+
+	using HarmonicList = std::vector<std::pair<int, float>>;
+
+	/** Creates the data for a wavetable sound with one table per harmonic list. */
+	static ValueTree createWavetableData(int tableSize, const std::vector<HarmonicList>& tables)
+	{
+		HeapBlock<float> data;
+		data.calloc(tableSize * (int)tables.size());
+
+		for (int t = 0; t < (int)tables.size(); t++)
+			fillWithHarmonics(data + t * tableSize, tableSize, tables[t]);
+
+		ValueTree v("wavetable");
+
+		v.setProperty("data", var(data.get(), sizeof(float) * tableSize * (int)tables.size()), nullptr);
+		v.setProperty("amount", (int)tables.size(), nullptr);
+		v.setProperty("sampleRate", 48000.0, nullptr);
+		v.setProperty("noteNumber", 60, nullptr);
+
+		return v;
+	}
+
+	static void fillWithHarmonics(float* data, int tableSize, const HarmonicList& harmonics)
+	{
+		for (int i = 0; i < tableSize; i++)
+		{
+			double value = 0.0;
+
+			for (const auto& h : harmonics)
+				value += h.second * std::sin(2.0 * double_Pi * (double)(h.first * i) / (double)tableSize);
+
+			data[i] = (float)value;
+		}
+	}
+
+	void testNumMipLevels()
+	{
+		beginTest("Testing the number of mip levels");
+
+		WavetableSound pow2(createWavetableData(2048, { { { 1, 1.0f } } }));
+
+		expectEquals(pow2.getNumMipLevels(), jmin(HISE_WAVETABLE_MAX_MIP_LEVELS, 10));
+
+		WavetableSound small(createWavetableData(8, { { { 1, 1.0f } } }));
+
+		expectEquals(small.getNumMipLevels(), jmin(HISE_WAVETABLE_MAX_MIP_LEVELS, 2));
+
+		WavetableSound odd(createWavetableData(1000, { { { 1, 1.0f } } }));
+
+		expectEquals(odd.getNumMipLevels(), 1, "non power of two");
+		expectEquals(odd.getMipLevelFade(16.0).upperLevel, 0);
+	}
+
+	void expectFade(const WavetableSound& sound, double delta, int lowerLevel, int upperLevel, float upperGain)
+	{
+		const auto fade = sound.getMipLevelFade(delta);
+		const String m = "delta " + String(delta);
+
+		expectEquals(fade.lowerLevel, lowerLevel, m);
+		expectEquals(fade.upperLevel, upperLevel, m);
+		expectWithinAbsoluteError(fade.upperGain, upperGain, 1e-6f, m);
+	}
+
+	void testMipLevelFade()
+	{
+		beginTest("Testing the mip level crossfade");
+
+		WavetableSound sound(createWavetableData(2048, { { { 1, 1.0f } } }));
+
+		const int lastLevel = sound.getNumMipLevels() - 1;
+
+		expectFade(sound, 0.25, 0, 0, 0.0f);
+		expectFade(sound, 1.0, 0, 0, 0.0f);
+		expectFade(sound, 2.0, 1, 2, 0.0f);
+		expectFade(sound, 3.0, 1, 2, (float)std::log2(3.0) - 1.0f);
+		expectFade(sound, 16.0, 4, 5, 0.0f);
+		expectFade(sound, 100000.0, lastLevel, lastLevel, 0.0f);
+
+		// The fade position must follow the pitch without jumps
+		double lastPosition = 0.0;
+
+		for (double delta = 1.0; delta < 1000.0; delta *= 1.001)
+		{
+			const auto fade = sound.getMipLevelFade(delta);
+			const double position = (double)fade.lowerLevel + (double)fade.upperGain;
+
+			expect(position >= lastPosition && position - lastPosition < 0.01, "jump at delta " + String(delta));
+			lastPosition = position;
+
+			// The upper level must keep the highest harmonic below Nyquist
+			const int highestHarmonic = sound.getMipLevelTableSize(fade.upperLevel) / 2 - 1;
+
+			if (fade.upperLevel != lastLevel)
+				expect(delta * (double)highestHarmonic < (double)sound.getTableSize() / 2.0, "aliasing at delta " + String(delta));
+		}
+	}
+
+	void testBandLimiting()
+	{
+		beginTest("Testing the band-limiting of the mip levels");
+
+		constexpr int tableSize = 2048;
+
+		const HarmonicList low = { { 1, 1.0f }, { 3, 0.3f } };
+		const HarmonicList lowAndHigh = { { 1, 1.0f }, { 3, 0.3f }, { 600, 0.5f } };
+
+		WavetableSound sound(createWavetableData(tableSize, { lowAndHigh, low }));
+
+		expectEquals(sound.getTableSize(), tableSize);
+		expectEquals(sound.getWavetableAmount(), 2);
+
+		HeapBlock<float> expected;
+		expected.calloc(tableSize);
+
+		for (int level = 0; level < sound.getNumMipLevels(); level++)
+		{
+			const int levelSize = sound.getMipLevelTableSize(level);
+
+			expectEquals(levelSize, tableSize >> level);
+			expectEquals(sound.getMipLevelStride(level), levelSize + 1);
+
+			for (int t = 0; t < 2; t++)
+			{
+				const float* table = sound.getMipLevelData(level) + t * sound.getMipLevelStride(level);
+
+				HarmonicList kept;
+
+				// Every level keeps the harmonics below its own Nyquist frequency
+				for (const auto& h : (t == 0 ? lowAndHigh : low))
+				{
+					if (level == 0 || h.first < levelSize / 2)
+						kept.push_back(h);
+				}
+
+				fillWithHarmonics(expected, levelSize, kept);
+
+				// The tables are normalised when they are loaded
+				FloatVectorOperations::multiply(expected, 1.0f / sound.getUnnormalizedGainValue(t), levelSize);
+
+				float maxError = 0.0f;
+
+				for (int i = 0; i < levelSize; i++)
+					maxError = jmax(maxError, std::abs(table[i] - expected[i]));
+
+				expect(maxError < 1e-3f, "Level " + String(level) + ", table " + String(t) + ": error " + String(maxError));
+				expectEquals(table[levelSize], table[0], "wrap sample");
+			}
+		}
+	}
+
+	void testInterpolatedSample()
+	{
+		beginTest("Testing the interpolation of the scaled mip levels");
+
+		constexpr int tableSize = 2048;
+
+		WavetableSound sound(createWavetableData(tableSize, { { { 1, 1.0f } }, { { 2, 1.0f } } }));
+
+		for (double delta : { 1.0, 3.0, 4.0, 11.0, 16.0 })
+		{
+			const auto fade = sound.getMipLevelFade(delta);
+
+			for (int t = 0; t < 2; t++)
+			{
+				float maxError = 0.0f;
+
+				// Read past the table end to check the wrap around of the smaller levels
+				for (double uptime = 0.0; uptime < 3.0 * (double)tableSize; uptime += delta * 0.37)
+				{
+					const float expected = (float)std::sin(2.0 * double_Pi * (double)(t + 1) * uptime / (double)tableSize);
+					maxError = jmax(maxError, std::abs(sound.getInterpolatedSample(t, uptime, fade) - expected));
+				}
+
+				// The linear interpolation of 64 samples per cycle is off by up to 0.0012
+				expect(maxError < 2e-3f, "delta " + String(delta) + ", table " + String(t) + ": error " + String(maxError));
+			}
+		}
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking the mip level creation");
+
+		constexpr int tableSize = 2048;
+		constexpr int numTables = 64;
+
+		std::vector<HarmonicList> tables;
+
+		for (int t = 0; t < numTables; t++)
+			tables.push_back({ { 1, 1.0f }, { 1 + t, 0.5f }, { 5 * (t + 1), 0.25f } });
+
+		auto data = createWavetableData(tableSize, tables);
+
+		const double start = Time::getMillisecondCounterHiRes();
+		WavetableSound sound(data);
+		const double time = Time::getMillisecondCounterHiRes() - start;
+
+		const int64 originalBytes = (int64)sizeof(float) * tableSize * numTables;
+		int64 mipBytes = 0;
+
+		for (int level = 0; level < sound.getNumMipLevels(); level++)
+			mipBytes += (int64)sizeof(float) * sound.getMipLevelStride(level) * numTables;
+
+		String s;
+
+		s << String(numTables) << " tables with " << String(tableSize) << " samples: ";
+		s << String(sound.getNumMipLevels()) << " mip levels in " << String(time, 2) << "ms, ";
+		s << String(mipBytes / 1024) << "kB instead of " << String(originalBytes / 1024) << "kB";
+
+		logMessage(s);
+	}
+
+	/** The scalar loop that read the full size table before the mip levels were added. */
+	static void renderWithoutMipLevels(const WavetableSound& sound, int tableIndex, double delta, float* out, int numSamples)
+	{
+		const float* table = sound.getWaveTableData(tableIndex);
+		const int tableSize = sound.getTableSize();
+		double uptime = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int index = (int)uptime;
+			const int i1 = index % tableSize;
+			int i2 = i1 + 1;
+
+			if (i2 >= tableSize)
+				i2 = 0;
+
+			const float alpha = float(uptime) - (float)index;
+
+			out[i] = (1.0f - alpha) * table[i1] + alpha * table[i2];
+			uptime += delta;
+		}
+	}
+
+	/** The voice loop with the mip level fade. */
+	static void renderWithMipLevels(const WavetableSound& sound, int tableIndex, double delta, float* out, int numSamples)
+	{
+		WavetableSound::MipLevelFade fade;
+		double uptime = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			if (i % 8 == 0)
+				fade = sound.getMipLevelFade(delta);
+
+			out[i] = sound.getInterpolatedSample(tableIndex, uptime, fade);
+			uptime += delta;
+		}
+	}
+
+	void runRenderBenchmark()
+	{
+		beginTest("Benchmarking the render loop");
+
+		constexpr int tableSize = 2048;
+		constexpr int numSamples = 1 << 18;
+
+		WavetableSound sound(createWavetableData(tableSize, { { { 1, 1.0f }, { 7, 0.5f }, { 600, 0.25f } } }));
+
+		HeapBlock<float> before, after;
+		before.calloc(numSamples);
+		after.calloc(numSamples);
+
+		// Without transposition the full size table is used without a crossfade
+		renderWithoutMipLevels(sound, 0, 1.0, before, numSamples);
+		renderWithMipLevels(sound, 0, 1.0, after, numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			if (before[i] != after[i])
+			{
+				expectEquals(after[i], before[i], "sample " + String(i));
+				break;
+			}
+		}
+
+		for (double delta : { 1.0, 2.7 })
+		{
+			double beforeTime = 0.0;
+			double afterTime = 0.0;
+
+			for (int run = 0; run < 5; run++)
+			{
+				double start = Time::getMillisecondCounterHiRes();
+				renderWithoutMipLevels(sound, 0, delta, before, numSamples);
+				beforeTime += Time::getMillisecondCounterHiRes() - start;
+
+				start = Time::getMillisecondCounterHiRes();
+				renderWithMipLevels(sound, 0, delta, after, numSamples);
+				afterTime += Time::getMillisecondCounterHiRes() - start;
+			}
+
+			String s;
+
+			s << String(numSamples) << " samples with delta " << String(delta, 1) << ": ";
+			s << String(beforeTime / 5.0, 2) << "ms before, " << String(afterTime / 5.0, 2) << "ms with the mip levels";
+
+			logMessage(s);
+		}
+	}
+};
+
+static WavetableSynthUnitTests wavetableSynthUnitTests;
+
+#endif
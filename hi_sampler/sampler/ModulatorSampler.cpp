@@ -84,6 +84,9 @@ SET_DOCUMENTATION(ModulatorSampler)
 
     ADD_PARAMETER_DOC(UseStaticMatrix,
         "If this is true, then the routing matrix will not be resized when you load a sample map with another mic position amount.");
+
+	ADD_PARAMETER_DOC_WITH_NAME(InterpolationMode, "Interpolation",
+		"The resampling algorithm of the voices: `0` = linear, `1` = cubic, `2` = windowed sinc. The higher order modes sound cleaner when the samples are pitched but need a bit more CPU.");
     
 	ADD_CHAIN_DOC(SampleStartModulation, "Sample Start", 
 		"Allows modification of the sample start if the sound allows this. The modulation range is depending on the *SampleStartMod* value of each sample.");
@@ -97,6 +100,7 @@ ModulatorSampler::ModulatorSampler(MainController *mc, const String &id, int num
 ModulatorSynth(mc, id, numVoices),
 preloadSize(PRELOAD_SIZE),
 asyncPurger(this),
+noteSoundMapUpdater(*this),
 sampleMap(new SampleMap(this)),
 rrGroupAmount(1),
 bufferSize(4096),
@@ -146,6 +150,7 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 	parameterNames.add("Purged");
 	parameterNames.add("Reversed");
     parameterNames.add("UseStaticMatrix");
+	parameterNames.add("InterpolationMode");
 
 	editorStateIdentifiers.add("SampleStartChainShown");
 	editorStateIdentifiers.add("SettingsShown");
@@ -200,6 +205,41 @@ void ModulatorSampler::refreshRRMap()
 	}
 }
 
+void ModulatorSampler::invalidateNoteSoundMap() noexcept
+{
+	++noteSoundMapVersion;
+	noteSoundMapUpdater.triggerAsyncUpdate();
+}
+
+const NoteSoundMap* ModulatorSampler::getNoteSoundMap() const noexcept
+{
+	if (noteSoundMap == nullptr || builtNoteSoundMapVersion != noteSoundMapVersion.load())
+		return nullptr;
+
+	return noteSoundMap.get();
+}
+
+void ModulatorSampler::refreshNoteSoundMap()
+{
+	const int version = noteSoundMapVersion.load();
+
+	if (noteSoundMap != nullptr && builtNoteSoundMapVersion == version)
+		return;
+
+	ScopedPointer<NoteSoundMap> newMap = new NoteSoundMap();
+
+	{
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::SampleLock);
+		newMap->build(this);
+	}
+
+	{
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::AudioLock, isOnAir());
+		noteSoundMap.swapWith(newMap);
+		builtNoteSoundMapVersion = version;
+	}
+}
+
 void ModulatorSampler::setReversed(bool shouldBeReversed)
 {
     if (reversed != shouldBeReversed)
@@ -321,6 +361,7 @@ void ModulatorSampler::restoreFromValueTree(const ValueTree &v)
 	setVoiceAmount(v.getProperty("VoiceAmount", voiceAmount));
 	
 	loadAttribute(Reversed, "Reversed");
+	loadAttribute(InterpolationMode, "InterpolationMode");
 
 	loadAttribute(SamplerRepeatMode, "SamplerRepeatMode");
 	loadAttribute(Purged, "Purged");
@@ -366,6 +407,7 @@ ValueTree ModulatorSampler::exportAsValueTree() const
 	saveAttribute(Reversed, "Reversed");
 	v.setProperty("NumChannels", numChannels, nullptr);
     saveAttribute(UseStaticMatrix, "UseStaticMatrix");
+	saveAttribute(InterpolationMode, "InterpolationMode");
 
 	ValueTree channels("channels");
 
@@ -430,6 +472,7 @@ float ModulatorSampler::getAttribute(int parameterIndex) const
 	case Purged:			return purged ? 1.0f : 0.0f;
 	case Reversed:			return reversed ? 1.0f : 0.0f;
     case UseStaticMatrix:   return useStaticMatrix ? 1.0f : 0.0f;
+	case InterpolationMode: return (float)interpolationMode;
 	default:				jassertfalse; return -1.0f;
 	}
 }
@@ -460,6 +503,7 @@ void ModulatorSampler::setInternalAttribute(int parameterIndex, float newValue)
 	case CrossfadeGroups:	crossfadeGroups = newValue > 0.5f; refreshCrossfadeTables(); break;
 	case Purged:			purgeAllSamples(newValue > 0.5f); break;
 	case UseStaticMatrix:   setUseStaticMatrix(newValue > 0.5f); break;
+	case InterpolationMode: setInterpolationMode((SampleInterpolator::Mode)jlimit<int>(0, SampleInterpolator::numModes - 1, (int)newValue)); break;
 	default:				jassertfalse; break;
 	}
 }
@@ -505,6 +549,23 @@ void ModulatorSampler::prepareToPlay(double newSampleRate, int samplesPerBlock)
 	if (newSampleRate != -1.0)
 	{
 		StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, samplesPerBlock);
+		initParallelTemporaryVoiceBuffers(samplesPerBlock);
+	}
+}
+
+void ModulatorSampler::initParallelTemporaryVoiceBuffers(int samplesPerBlock)
+{
+	auto pool = getMainController()->getAudioRenderingThreadPool();
+
+	const int numWorkers = pool != nullptr ? pool->getNumWorkerThreads() : 0;
+	const bool shouldBeFloat = temporaryVoiceBuffer.isFloatingPoint();
+
+	for (int i = 0; i < numWorkers; i++)
+	{
+		if (i >= parallelTemporaryVoiceBuffers.size() || parallelTemporaryVoiceBuffers[i]->isFloatingPoint() != shouldBeFloat)
+			parallelTemporaryVoiceBuffers.set(i, new hlac::HiseSampleBuffer(shouldBeFloat, 2, 0), true);
+
+		StreamingSamplerVoice::initTemporaryVoiceBuffer(parallelTemporaryVoiceBuffers[i], samplesPerBlock);
 	}
 }
 
@@ -557,7 +618,12 @@ void ModulatorSampler::deleteSound(int index)
 
 		{
 			LockHelpers::SafeLock sl(getMainController(), LockHelpers::SampleLock);
+
+			// Invalidate the table before the sound is freed and again after it's gone, so that
+			// a rebuild which collected the old sounds can't be marked as up to date
+			invalidateNoteSoundMap();
 			removeSound(index);
+			invalidateNoteSoundMap();
 		}
 
 		if (!delayUpdate)
@@ -586,7 +652,10 @@ void ModulatorSampler::deleteAllSounds()
 
 		if (getNumSounds() != 0)
 		{
+			invalidateNoteSoundMap();
 			clearSounds();
+			invalidateNoteSoundMap();
+
 			getMainController()->getSampleManager().getModulatorSamplerSoundPool()->clearUnreferencedMonoliths();
 		}
 	}
@@ -653,6 +722,7 @@ void ModulatorSampler::refreshMemoryUsage()
 		temporaryVoiceBuffer = hlac::HiseSampleBuffer(temporaryBufferShouldBeFloatingPoint, 2, 0);
 
 		StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, getLargestBlockSize());
+		initParallelTemporaryVoiceBuffers(getLargestBlockSize());
 
 		for (auto i = 0; i < getNumVoices(); i++)
 		{
@@ -693,6 +763,14 @@ void ModulatorSampler::refreshMemoryUsage()
 	getMainController()->getSampleManager().getModulatorSamplerSoundPool()->sendChangeMessage();
 }
 
+void ModulatorSampler::setInterpolationMode(SampleInterpolator::Mode newMode)
+{
+	// Build the lookup tables here so that the first note doesn't have to do it
+	SampleInterpolator::initialise();
+
+	interpolationMode = newMode;
+}
+
 void ModulatorSampler::setVoiceAmount(int newVoiceAmount)
 {
 	if (isInGroup())
@@ -892,6 +970,41 @@ bool ModulatorSampler::soundCanBePlayed(ModulatorSynthSound *sound, int midiChan
 	return true;
 }
 
+int ModulatorSampler::collectSoundsToBeStarted(const HiseEvent& m)
+{
+	auto map = getNoteSoundMap();
+
+	// The lookup table is outdated, so we need to check every sound...
+	if (map == nullptr)
+		return ModulatorSynth::collectSoundsToBeStarted(m);
+
+	jassert(m.isNoteOn());
+
+#if JUCE_DEBUG
+	HiseEventBuffer::CopyHelpers::copyEvents(&eventForSoundCollection, &m, 1);
+#endif
+
+	soundsToBeStarted.clearQuick();
+
+	const int midiChannel = m.getChannel();
+	const int transposedMidiNoteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const float velocity = m.getFloatVelocity();
+
+	if (!isPositiveAndBelow(transposedMidiNoteNumber, 128))
+		return 0;
+
+	for (const auto& e : map->getSoundsForNote(transposedMidiNoteNumber))
+	{
+		if (!crossfadeGroups && e.rrGroup != currentRRGroupIndex)
+			continue;
+
+		if (soundCanBePlayed(e.sound, midiChannel, transposedMidiNoteNumber, velocity))
+			soundsToBeStarted.insertWithoutSearch(e.sound);
+	}
+
+	return soundsToBeStarted.size();
+}
+
 void ModulatorSampler::handleRetriggeredNote(ModulatorSynthVoice *voice)
 {
 	jassert(getMainController()->getKillStateHandler().getCurrentThread() == MainController::KillStateHandler::AudioThread);
@@ -969,7 +1082,7 @@ float* ModulatorSampler::calculateCrossfadeModulationValuesForVoice(int voiceInd
 
 	if (auto compressedValues = modChains[Chains::XFade].getWritePointerForManualExpansion(startSample))
 	{
-		int numSamples_cr = numSamples / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+		int numSamples_cr = numSamples / modChains[Chains::XFade].getControlRateDivisor();
 
 		auto firstValue = compressedValues[0];
 		auto lastValue = compressedValues[numSamples_cr - 1];
@@ -1133,6 +1246,8 @@ void ModulatorSampler::setRRGroupAmount(int newGroupLimit)
 
 	allNotesOff(1, true);
 
+	invalidateNoteSoundMap();
+
 	ModulatorSampler::SoundIterator sIter(this);
 
 	while (auto sound = sIter.getNextSound())
@@ -1166,90 +1281,80 @@ bool ModulatorSampler::preloadAllSamples()
 
 	const bool isReversed = getAttribute(ModulatorSampler::Reversed) > 0.5f;
 
-	ModulatorSampler::SoundIterator sIter(this);
-
-	const int numToLoad = jmax<int>(1, sounds.size() * getNumMicPositions());
-	int currentIndex = 0;
-
-	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
-
 	auto threadPool = getMainController()->getSampleManager().getGlobalSampleThreadPool();
 
-	while (auto sound = sIter.getNextSound())
-	{
-		if (threadPool->threadShouldExit())
-			return false;
+	ParallelSamplePreloader preloader(getMainController()->getSampleManager().getPreloadThreadPool());
 
-		sound->checkFileReference();
+	{
+		ModulatorSampler::SoundIterator sIter(this);
 
-		if (getNumMicPositions() == 1)
+		while (auto sound = sIter.getNextSound())
 		{
-			auto s = sound->getReferenceToSound();
+			if (threadPool->threadShouldExit())
+				return false;
 
-			progress = (double)currentIndex++ / (double)numToLoad;
+			sound->checkFileReference();
 
-			if (!preloadSample(s, preloadSizeToUse))
-				return false;
-		}
-		else
-		{
-			for (int j = 0; j < getNumMicPositions(); j++)
+			if (getNumMicPositions() == 1)
 			{
-				const bool isEnabled = getChannelData(j).enabled;
+				auto s = sound->getReferenceToSound();
 
-				progress = (double)currentIndex++ / (double)numToLoad;
+				jassert(s != nullptr);
 
-				if (auto s = sound->getReferenceToSound(j))
+				if (s != nullptr)
+					preloader.addSound(s);
+			}
+			else
+			{
+				for (int j = 0; j < getNumMicPositions(); j++)
 				{
-					if (isEnabled)
+					const bool isEnabled = getChannelData(j).enabled;
+
+					if (auto s = sound->getReferenceToSound(j))
 					{
-						if (!preloadSample(s, preloadSizeToUse))
-							return false;
+						if (isEnabled)
+							preloader.addSound(s);
+						else
+							s->setPurged(true);
 					}
-					else
-						s->setPurged(true);
 				}
 			}
 		}
-
-		sound->setReversed(isReversed);
 	}
 
-	refreshMemoryUsage();
-	setShouldUpdateUI(true);
-	setHasPendingSampleLoad(false);
-	sendChangeMessage();
-
-	return true;
-}
-
-
-bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse)
-{
-	jassert(s != nullptr);
+	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
 
-	String fileName = s->getFileName(false);
+	String errorMessage;
 
-	try
-	{
-		s->setPreloadSize(s->hasActiveState() ? preloadSizeToUse : 0, true);
-		s->closeFileHandle();
-		return true;
-	}
-	catch (StreamingSamplerSound::LoadingError l)
+	if (!preloader.preload(preloadSizeToUse, threadPool, progress, errorMessage))
 	{
-		String x;
-		x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
-		getMainController()->getDebugLogger().logMessage(x);
+		if (errorMessage.isNotEmpty())
+		{
+			getMainController()->getDebugLogger().logMessage(errorMessage);
 
 #if USE_FRONTEND
-		getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+			getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, errorMessage);
 #else
-		debugError(this, x);
+			debugError(this, errorMessage);
 #endif
+		}
 
 		return false;
 	}
+
+	{
+		ModulatorSampler::SoundIterator sIter(this);
+
+		while (auto sound = sIter.getNextSound())
+			sound->setReversed(isReversed);
+	}
+
+	refreshMemoryUsage();
+	setShouldUpdateUI(true);
+	setHasPendingSampleLoad(false);
+	sendChangeMessage();
+
+	return true;
 }
 
 ModulatorSampler::ScopedUpdateDelayer::ScopedUpdateDelayer(ModulatorSampler* s) :
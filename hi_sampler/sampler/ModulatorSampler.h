@@ -139,6 +139,7 @@ public:
 		Purged, 
 		Reversed,
         UseStaticMatrix,
+		InterpolationMode,
 		numModulatorSamplerParameters
 	};
 
@@ -290,6 +291,9 @@ public:
 	void preStartVoice(int voiceIndex, int noteNumber) override;
 	void soundsChanged() {};
 	bool soundCanBePlayed(ModulatorSynthSound *sound, int midiChannel, int midiNoteNumber, float velocity) override;;
+
+	/** Overwrites the base class method and only checks the sounds that are mapped to the note number. */
+	int collectSoundsToBeStarted(const HiseEvent& m) override;
 	void handleRetriggeredNote(ModulatorSynthVoice *voice) override;
 
 	/** Overwrites the base class method and ignores the note off event if Parameters::OneShot is enabled. */
@@ -327,8 +331,6 @@ public:
 	/** This function will be called on a background thread and preloads all samples. */
 	bool preloadAllSamples();
 
-	bool preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse);
-
 	void saveSampleMap() const;
 
 	void saveSampleMapAsReference() const;
@@ -378,6 +380,19 @@ public:
 	int getRRGroupsForMessage(int noteNumber, int velocity);
 	void refreshRRMap();
 
+	/** Marks the note lookup table as outdated and rebuilds it asynchronously.
+	*
+	*	Call this whenever a sound is added / removed or its key range / RR group changes.
+	*	Until the new table is built, the sampler will scan every sound for new notes.
+	*/
+	void invalidateNoteSoundMap() noexcept;
+
+	/** Rebuilds the note lookup table if it is outdated. Don't call this on the audio thread. */
+	void refreshNoteSoundMap();
+
+	/** Returns the note lookup table or nullptr if it is outdated. */
+	const NoteSoundMap* getNoteSoundMap() const noexcept;
+
     void setReversed(bool shouldBeReversed);
 
 	void purgeAllSamples(bool shouldBePurged)
@@ -524,7 +539,18 @@ public:
 		return saveString;
 	}
 
-	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer() { return &temporaryVoiceBuffer; }
+	/** Returns the temporary buffer for the voice rendering. 
+	*
+	*	If the voices are rendered in parallel, every slot needs its own buffer. 
+	*/
+	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer(int slotIndex=0) 
+	{ 
+		if (slotIndex == 0)
+			return &temporaryVoiceBuffer;
+
+		jassert(isPositiveAndNotGreaterThan(slotIndex, parallelTemporaryVoiceBuffers.size()));
+		return parallelTemporaryVoiceBuffers[slotIndex - 1];
+	}
 
 	bool checkAndLogIsSoftBypassed(DebugLogger::Location location) const;
 
@@ -544,6 +570,11 @@ public:
     
     bool isUsingStaticMatrix() const noexcept { return useStaticMatrix; };
 
+	/** Sets the resampling algorithm for the voices. The new mode will be used by notes that start after this call. */
+	void setInterpolationMode(SampleInterpolator::Mode newMode);
+
+	SampleInterpolator::Mode getInterpolationMode() const noexcept { return interpolationMode; }
+
 	bool shouldDelayUpdate() const noexcept { return delayUpdate; }
 
 private:
@@ -589,10 +620,26 @@ private:
 
 	AsyncPurger asyncPurger;
 
+	struct NoteSoundMapUpdater : public LockfreeAsyncUpdater
+	{
+		NoteSoundMapUpdater(ModulatorSampler& s) :
+			sampler(s)
+		{};
+
+		void handleAsyncUpdate() override { sampler.refreshNoteSoundMap(); }
+
+		ModulatorSampler& sampler;
+	};
+
 	void refreshCrossfadeTables();
 
 	RoundRobinMap roundRobinMap;
 
+	ScopedPointer<NoteSoundMap> noteSoundMap;
+	std::atomic<int> noteSoundMapVersion = { 0 };
+	int builtNoteSoundMapVersion = -1;
+	NoteSoundMapUpdater noteSoundMapUpdater;
+
 	bool reversed = false;
 
 	bool pitchTrackingEnabled;
@@ -618,6 +665,8 @@ private:
 
 	bool useStaticMatrix = false;
 
+	SampleInterpolator::Mode interpolationMode = SampleInterpolator::Linear;
+
 	int64 memoryUsage;
 
 	OwnedArray<SampleLookupTable> crossfadeTables;
@@ -626,6 +675,11 @@ private:
 
 	hlac::HiseSampleBuffer temporaryVoiceBuffer;
 
+	/** Creates a temporary voice buffer for every audio worker thread. */
+	void initParallelTemporaryVoiceBuffers(int samplesPerBlock);
+
+	OwnedArray<hlac::HiseSampleBuffer> parallelTemporaryVoiceBuffers;
+
 	bool delayUpdate = false;
 
 	float groupGainValues[8];
@@ -269,6 +269,8 @@ void SampleMap::parseValueTree(const ValueTree &v)
 
 	sampler->updateRRGroupAmountAfterMapLoad();
 	if(!sampler->isRoundRobinEnabled()) sampler->refreshRRMap();
+
+	sampler->refreshNoteSoundMap();
 	
 	sampler->refreshMemoryUsage();
 	
@@ -385,6 +387,9 @@ void SampleMap::addSampleFromValueTree(ValueTree childWhichHasBeenAdded)
 	{
 		LockHelpers::SafeLock sl(sampler->getMainController(), LockHelpers::SampleLock);
 		sampler->addSound(newSound);
+
+		// After the sound was added, so that a rebuild that missed it isn't marked as up to date
+		sampler->invalidateNoteSoundMap();
 	}
 
 	dynamic_cast<ModulatorSamplerSound*>(newSound)->initPreloadBuffer((int)sampler->getAttribute(ModulatorSampler::PreloadSize));
@@ -774,6 +779,25 @@ int RoundRobinMap::getRRGroupsForMessage(int noteNumber, int velocity)
 	
 }
 
+void NoteSoundMap::build(const ModulatorSampler* sampler)
+{
+	for (auto& e : entries)
+		e.clearQuick();
+
+	ModulatorSampler::SoundIterator sIter(sampler);
+
+	while (auto sound = sIter.getNextSound())
+	{
+		const Entry e = { sound.get(), sound->getRRGroup() };
+
+		for (int i = 0; i < 128; i++)
+		{
+			if (sound->isMappedToNote(i))
+				entries[i].add(e);
+		}
+	}
+}
+
 #if HI_ENABLE_EXPANSION_EDITING
 MonolithExporter::MonolithExporter(SampleMap* sampleMap_) :
 	DialogWindowWithBackgroundThread("Exporting samples as monolith"),
@@ -1014,7 +1038,12 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		ScopedPointer<AudioFormatWriter> writer = hlac.createWriterFor(hlacOutput, sampleRate, isMono ? 1 : 2, 16, empty, 5);
 
-		dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get())->setOptions(options);
+		auto hlacWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get());
+
+		hlacWriter->setOptions(options);
+
+		// The blocks of the samples are queued and encoded by all cores (this thread included)
+		hlacWriter->setNumEncoderThreads(SystemStats::getNumCpus());
 
 		for (int i = 0; i < channelList->size(); i++)
 		{
@@ -473,6 +473,37 @@ private:
 
 };
 
+/** A lookup table that contains the sounds for every MIDI note number.
+*
+*	The ModulatorSampler uses this in collectSoundsToBeStarted() so that a note on message only has to check
+*	the sounds that are mapped to its note number instead of every sound of the sample map.
+*	It will be rebuilt whenever a sound is added / removed or its mapping is changed.
+*/
+class NoteSoundMap
+{
+public:
+
+	struct Entry
+	{
+		ModulatorSamplerSound* sound;
+		int rrGroup;
+	};
+
+	/** Fills the map with the current sounds of the sampler. Don't call this on the audio thread. */
+	void build(const ModulatorSampler* sampler);
+
+	/** Returns all sounds that are mapped to the given note number (in the order of the sample map). */
+	const Array<Entry>& getSoundsForNote(int noteNumber) const noexcept
+	{
+		jassert(isPositiveAndBelow(noteNumber, 128));
+		return entries[noteNumber];
+	}
+
+private:
+
+	Array<Entry> entries[128];
+};
+
 #if HI_ENABLE_EXPANSION_EDITING
 class MonolithExporter : public DialogWindowWithBackgroundThread,
 						 public AudioFormatWriter
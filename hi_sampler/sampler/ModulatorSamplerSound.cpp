@@ -487,12 +487,14 @@ void ModulatorSamplerSound::updateInternalData(const Identifier& id, const var&
 			int low = jmin(midiNotes.findNextSetBit(0), newValue, 127);
 			midiNotes.clear();
 			midiNotes.setRange(low, newValue - low + 1, true);
+			invalidateNoteSoundMap();
 		}
 		else if (id == SampleIds::LoKey)
 		{
 			int high = jmax(midiNotes.getHighestBit(), newValue, 0);
 			midiNotes.clear();
 			midiNotes.setRange(newValue, high - newValue + 1, true);
+			invalidateNoteSoundMap();
 		}
 		else if (id == SampleIds::Normalized)
 		{
@@ -519,6 +521,7 @@ void ModulatorSamplerSound::updateInternalData(const Identifier& id, const var&
 		else if (id == SampleIds::RRGroup)
 		{
 			rrGroup = jmin<int>(maxRRGroup, newValue);
+			invalidateNoteSoundMap();
 		}
 		else if (id == SampleIds::Volume)
 		{
@@ -568,6 +571,15 @@ void ModulatorSamplerSound::updateInternalData(const Identifier& id, const var&
 }
 
 
+void ModulatorSamplerSound::invalidateNoteSoundMap()
+{
+	if (parentMap != nullptr)
+	{
+		if (auto s = parentMap->getSampler())
+			s->invalidateNoteSoundMap();
+	}
+}
+
 void ModulatorSamplerSound::updateAsyncInternalData(const Identifier& id, int newValue)
 {
 	LockHelpers::freeToGo(getMainController());
@@ -668,30 +680,55 @@ void ModulatorSamplerSoundPool::addSound(const PoolEntry& newPoolEntry)
 {
 	jassert(getSampleFromPool(newPoolEntry.r) == nullptr);
 
+	const auto hashCode = newPoolEntry.r.getHashCode();
+
+	// Keep the first entry if there are duplicates (same behaviour as the linear search)
+	if (!poolIndex.contains(hashCode))
+		poolIndex.set(hashCode, pool.size());
+
 	pool.add(newPoolEntry);
 }
 
 void ModulatorSamplerSoundPool::removeFromPool(const PoolReference& ref)
 {
-	for (int i = 0; i < pool.size(); i++)
+	const auto hashCode = ref.getHashCode();
+
+	if (poolIndex.contains(hashCode))
 	{
-		if (pool[i].r == ref)
-		{
-			pool.remove(i);
-			return;
-		}
+		pool.remove(poolIndex[hashCode]);
+		rebuildPoolIndex();
 	}
 }
 
 hise::HlacMonolithInfo* ModulatorSamplerSoundPool::getMonolith(const Identifier& id)
 {
-	for (const auto& m : loadedMonoliths)
+	return monolithIndex[id.toString()];
+}
+
+void ModulatorSamplerSoundPool::rebuildPoolIndex()
+{
+	poolIndex.clear();
+
+	for (int i = 0; i < pool.size(); i++)
 	{
-		if (*m == id)
-			return m;
+		const auto hashCode = pool.getReference(i).r.getHashCode();
+
+		if (!poolIndex.contains(hashCode))
+			poolIndex.set(hashCode, i);
 	}
+}
 
-	return nullptr;
+void ModulatorSamplerSoundPool::rebuildMonolithIndex()
+{
+	monolithIndex.clear();
+
+	for (auto m : loadedMonoliths)
+	{
+		const auto id = m->getSampleMapId().toString();
+
+		if (!monolithIndex.contains(id))
+			monolithIndex.set(id, m);
+	}
 }
 
 HlacMonolithInfo::Ptr ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, const Array<File>& monolithicFiles)
@@ -704,6 +741,11 @@ HlacMonolithInfo::Ptr ModulatorSamplerSoundPool::loadMonolithicData(const ValueT
 
 	MonolithInfoToUse* hmaf = loadedMonoliths.getLast();
 
+	const auto monolithId = hmaf->getSampleMapId().toString();
+
+	if (!monolithIndex.contains(monolithId))
+		monolithIndex.set(monolithId, hmaf);
+
 	try
 	{
 		hmaf->fillMetadataInfo(sampleMap);
@@ -737,11 +779,10 @@ StreamingSamplerSound* ModulatorSamplerSoundPool::getSampleFromPool(PoolReferenc
 	if (!allowDuplicateSamples || !searchPool)
 		return nullptr;
 
-	for (const auto& entry : pool)
-	{
-		if (r == entry.r)
-			return entry.get();
-	}
+	const int index = getSoundIndexFromPool(r.getHashCode());
+
+	if (index != -1)
+		return pool.getReference(index).get();
 
 	return nullptr;
 }
@@ -760,6 +801,8 @@ void ModulatorSamplerSoundPool::clearUnreferencedSamplesInternal()
 	}
 
 	pool.swapWith(currentList);
+	rebuildPoolIndex();
+
 	if (updatePool) sendChangeMessage();
 }
 
@@ -1090,21 +1133,12 @@ bool ModulatorSamplerSoundPool::isFileBeingUsed(int poolIndex)
 	return false;
 }
 
-int ModulatorSamplerSoundPool::getSoundIndexFromPool(int64 hashCode)
+int ModulatorSamplerSoundPool::getSoundIndexFromPool(int64 hashCode) const
 {
-	if (!searchPool) return -1;
+	if (!searchPool || !poolIndex.contains(hashCode))
+		return -1;
 
-	for (int i = 0; i < pool.size(); i++)
-	{
-		StreamingSamplerSound::Ptr s = pool[i].get();
-		
-		if (s == nullptr)
-			return -1;
-
-		if (pool[i].r.getHashCode() == hashCode) return i;
-	}
-
-	return -1;
+	return poolIndex[hashCode];
 }
 
 bool ModulatorSamplerSoundPool::isPoolSearchForced() const
@@ -1122,6 +1156,8 @@ void ModulatorSamplerSoundPool::clearUnreferencedMonoliths()
 		}
 	}
 
+	rebuildMonolithIndex();
+
 	if(updatePool) sendChangeMessage();
 }
 
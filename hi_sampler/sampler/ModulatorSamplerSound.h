@@ -296,6 +296,7 @@ public:
 
 	bool appliesToVelocity(int velocity) override { return velocityRange[velocity]; };
 	bool appliesToNote(int midiNoteNumber) override { return !purged && allFilesExist && midiNotes[midiNoteNumber]; };
+	bool isMappedToNote(int midiNoteNumber) const noexcept { return midiNotes[midiNoteNumber]; };
 	bool appliesToChannel(int /*midiChannel*/) override { return true; };
 	bool appliesToRRGroup(int group) const noexcept{ return rrGroup == group; };
 
@@ -394,6 +395,8 @@ private:
 
 	void loadSampleFromValueTree(const ValueTree& sampleData, HlacMonolithInfo* hmaf);
 
+	void invalidateNoteSoundMap();
+
 	WeakReference<SampleMap> parentMap;
 	ValueTree data;
 	UndoManager *undoManager;
@@ -551,6 +554,9 @@ public:
 
 	StreamingSamplerSound* getSampleFromPool(PoolReference r) const;
 
+	/** Returns the index of the entry with the given PoolReference hash code or -1 if it's not in the pool. */
+	int getSoundIndexFromPool(int64 hashCode) const;
+
 	void addSound(const PoolEntry& newPoolEntry);
 
 	void removeFromPool(const PoolReference& ref);
@@ -597,7 +603,9 @@ private:
 
 	ReferenceCountedArray<MonolithInfoToUse> loadedMonoliths;
 
-	int getSoundIndexFromPool(int64 hashCode);
+	/** Recreates the lookup tables after entries were removed from the pool or the monolith list. */
+	void rebuildPoolIndex();
+	void rebuildMonolithIndex();
 
 	// ================================================================================================================
 
@@ -609,6 +617,12 @@ private:
 
 	Array<PoolEntry> pool;
 
+	/** Maps the hash code of a PoolReference to the (first) index in the pool, so that
+	*	the lookup while loading big sample maps doesn't have to walk over all entries. */
+	HashMap<int64, int> poolIndex;
+
+	HashMap<String, MonolithInfoToUse*> monolithIndex;
+
 	bool isCurrentlyLoading;
 	bool forcePoolSearch;
     bool updatePool;
@@ -75,6 +75,7 @@ void ModulatorSamplerVoice::startNote(int midiNoteNumber,
 
 	wrappedVoice.setPitchFactor(midiNoteNumber, samePitch ? midiNoteNumber : currentlyPlayingSamplerSound->getRootNote(), sound, getOwnerSynth()->getMainController()->getGlobalPitchFactor());
 	wrappedVoice.setSampleStartModValue(sampleStartModulationDelta);
+	wrappedVoice.setInterpolationMode(sampler->getInterpolationMode());
 	wrappedVoice.startNote(midiNoteNumber, velocity, sound, -1);
 
 	voiceUptime = wrappedVoice.voiceUptime;
@@ -119,6 +120,7 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 	
 
 	wrappedVoice.uptimeDelta = uptimeDelta;
+	wrappedVoice.setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer());
 
 	voiceBuffer.clear();
 
@@ -136,25 +138,106 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesInBlock);
 
-	if (auto modValues = getOwnerSynth()->getVoiceGainValues())
+	auto crossfadeValues = getCrossfadeModulationValues(startIndex, samplesInBlock);
+
+	applyEffectsAndGain(startIndex, samplesInBlock, getOwnerSynth()->getVoiceGainValues(), getOwnerSynth()->getConstantGainModValue(), crossfadeValues, getConstantCrossfadeModulationValue());
+}
+
+void ModulatorSamplerVoice::prepareParallelRendering(int startSample, int numSamples, int slotIndex)
+{
+	auto voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
+
+	applyConstantPitchFactor(currentlyPlayingSamplerSound->getPropertyPitch());
+
+	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta, startSample, numSamples);
+
+	// The modulation buffers of the synth will be overwritten by the next voice, so we need to copy them
+	if (voicePitchValues != nullptr)
+	{
+		parallelModulationData.copyFrom(0, startSample, voicePitchValues + startSample, numSamples);
+		wrappedVoice.setPitchValues(parallelModulationData.getReadPointer(0));
+	}
+	else
+	{
+		wrappedVoice.setPitchValues(nullptr);
+	}
+
+	if (auto gainValues = getOwnerSynth()->getVoiceGainValues())
+	{
+		parallelModulationData.copyFrom(1, startSample, gainValues + startSample, numSamples);
+		hasParallelGainValues = true;
+	}
+	else
+	{
+		hasParallelGainValues = false;
+	}
+
+	parallelConstantGainValue = getOwnerSynth()->getConstantGainModValue();
+
+	// The crossfade values are calculated from the shared XFade chain buffer, so they need to be copied too
+	if (auto crossfadeValues = getCrossfadeModulationValues(startSample, numSamples))
+	{
+		parallelModulationData.copyFrom(2, startSample, crossfadeValues + startSample, numSamples);
+		hasParallelCrossfadeValues = true;
+	}
+	else
+	{
+		hasParallelCrossfadeValues = false;
+	}
+
+	parallelConstantCrossfadeValue = getConstantCrossfadeModulationValue();
+
+	wrappedVoice.setPitchCounterForThisBlock(pitchCounter);
+	wrappedVoice.uptimeDelta = uptimeDelta;
+	wrappedVoice.setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer(slotIndex));
+}
+
+void ModulatorSamplerVoice::renderParallel(int startSample, int numSamples)
+{
+	voiceBuffer.clear();
+
+	wrappedVoice.renderNextBlock(voiceBuffer, startSample, numSamples);
+
+	voiceUptime = wrappedVoice.voiceUptime;
+}
+
+void ModulatorSamplerVoice::finishParallelRendering(int startSample, int numSamples)
+{
+	CHECK_AND_LOG_BUFFER_DATA(getOwnerSynth(), DebugLogger::Location::SampleRendering, voiceBuffer.getReadPointer(0, startSample), true, numSamples);
+	CHECK_AND_LOG_BUFFER_DATA(getOwnerSynth(), DebugLogger::Location::SampleRendering, voiceBuffer.getReadPointer(1, startSample), false, numSamples);
+
+	if (!wrappedVoice.isActive)
+	{
+		resetVoice();
+	}
+
+	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startSample, numSamples);
+
+	auto gainValues = hasParallelGainValues ? parallelModulationData.getReadPointer(1) : nullptr;
+	auto crossfadeValues = hasParallelCrossfadeValues ? parallelModulationData.getReadPointer(2) : nullptr;
+
+	applyEffectsAndGain(startSample, numSamples, gainValues, parallelConstantGainValue, crossfadeValues, parallelConstantCrossfadeValue);
+}
+
+void ModulatorSamplerVoice::applyEffectsAndGain(int startIndex, int samplesInBlock, const float* modValues, float constantGainValue, const float* crossFadeValues, float constantCrossfadeValue)
+{
+	if (modValues != nullptr)
 	{
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesInBlock);
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesInBlock);
 	}
 
-	if (auto crossFadeValues = getCrossfadeModulationValues(startSample, numSamples))
+	if (crossFadeValues != nullptr)
 	{
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), crossFadeValues + startIndex, samplesInBlock);
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), crossFadeValues + startIndex, samplesInBlock);
 
-		jassert(getConstantCrossfadeModulationValue() == 1.0f);
+		jassert(constantCrossfadeValue == 1.0f);
 	}
 	
-	float totalGain = getOwnerSynth()->getConstantGainModValue();
-	
-	float thisCrossfadeGain = getConstantCrossfadeModulationValue();
+	float totalGain = constantGainValue;
 
-	totalGain *= thisCrossfadeGain;
+	totalGain *= constantCrossfadeValue;
 
 	totalGain *= currentlyPlayingSamplerSound->getPropertyVolume();
 	totalGain *= currentlyPlayingSamplerSound->getNormalizedPeak();
@@ -171,7 +254,7 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 #if USE_BACKEND
 	if (sampler->isLastStartedVoice(this))
 	{
-		handlePlaybackPosition(sound);
+		handlePlaybackPosition(wrappedVoice.getLoadedSound());
 	}
 #endif
 }
@@ -236,6 +319,8 @@ void ModulatorSamplerVoice::prepareToPlay(double sampleRate, int samplesPerBlock
 	ModulatorSynthVoice::prepareToPlay(sampleRate, samplesPerBlock);
 
 	wrappedVoice.prepareToPlay(sampleRate, samplesPerBlock);
+
+	ProcessorHelpers::increaseBufferIfNeeded(parallelModulationData, samplesPerBlock);
 	
 	
 }
@@ -292,7 +377,8 @@ ModulatorSynthVoice(ownerSynth),
 sampleStartModValue(0.0f),
 velocityXFadeValue(1.0f),
 sampler(dynamic_cast<ModulatorSampler*>(ownerSynth)),
-wrappedVoice(sampler->getBackgroundThreadPool())
+wrappedVoice(sampler->getBackgroundThreadPool()),
+parallelModulationData(3, 0)
 {
 	wrappedVoice.setTemporaryVoiceBuffer(static_cast<ModulatorSampler*>(ownerSynth)->getTemporaryVoiceBuffer());
 	
@@ -372,6 +458,7 @@ void MultiMicModulatorSamplerVoice::startNote(int midiNoteNumber, float velocity
 
 		voiceToUse->setPitchFactor(midiNoteNumber, rootNote, micSound, globalPitchFactor);
 		voiceToUse->setSampleStartModValue(sampleStartModulationDelta);
+		voiceToUse->setInterpolationMode(sampler->getInterpolationMode());
 		voiceToUse->startNote(midiNoteNumber, velocity, micSound, -1);
 
 		voiceUptime = wrappedVoices[i]->voiceUptime;
@@ -61,6 +61,13 @@ public:
 	void calculateBlock(int startSample, int numSamples) override;
 	void resetVoice() override;
 
+	// ================================================================================================================
+
+	bool canRenderInParallel() const noexcept override { return true; }
+	void prepareParallelRendering(int startSample, int numSamples, int slotIndex) override;
+	void renderParallel(int startSample, int numSamples) override;
+	void finishParallelRendering(int startSample, int numSamples) override;
+
 	void handlePlaybackPosition(const StreamingSamplerSound * sound);
 
 	static double limitPitchDataToMaxSamplerPitch(float * pitchData, double uptimeDelta, int startSample, int numSamples);
@@ -105,8 +112,20 @@ protected:
 
 private:
 
+	/** Applies the voice effects, the gain and crossfade modulation and the sample gain to the rendered voice buffer. */
+	void applyEffectsAndGain(int startSample, int numSamples, const float* gainValues, float constantGainValue, const float* crossfadeValues, float constantCrossfadeValue);
+
 	StreamingSamplerVoice wrappedVoice;
 
+	// Channel 0 contains the pitch values, channel 1 the gain values and channel 2 the crossfade values of the current block (only used for parallel rendering)
+	AudioSampleBuffer parallelModulationData;
+
+	bool hasParallelGainValues = false;
+	float parallelConstantGainValue = 1.0f;
+
+	bool hasParallelCrossfadeValues = false;
+	float parallelConstantCrossfadeValue = 1.0f;
+
 	DebugLogger* logger;
 
 	// ================================================================================================================
@@ -134,6 +153,9 @@ public:
 	void calculateBlock(int startSample, int numSamples) override;
 	void prepareToPlay(double sampleRate, int samplesPerBlock);
 
+	/** The multimic voices share the temporary buffer between their mic positions, so they are always rendered serially. */
+	bool canRenderInParallel() const noexcept override { return false; }
+
 	// ================================================================================================================
 
 	void setLoaderBufferSize(int newBufferSize) override;
@@ -0,0 +1,185 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class NoteSoundMapUnitTests : public UnitTest
+{
+public:
+
+	NoteSoundMapUnitTests() :
+		UnitTest("Testing the note sound map of the sampler")
+	{
+
+	}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		TemporaryFile sampleFile(".wav");
+		writeTestSample(sampleFile.getFile());
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		auto sampler = new ModulatorSampler(bp, "Sampler", NUM_POLYPHONIC_VOICES);
+		sampler->addProcessorsWhenEmpty();
+		bp->getMainSynthChain()->getHandler()->add(sampler, nullptr);
+
+		sampler->setAttribute(ModulatorSampler::RRGroupAmount, 2.0f, dontSendNotification);
+		sampler->refreshNoteSoundMap();
+
+		testAddSounds(sampler, sampleFile.getFile());
+		testDeleteSound(sampler);
+		testDeleteAllSounds(sampler, sampleFile.getFile());
+
+		bp = nullptr;
+	}
+
+private:
+
+	void testAddSounds(ModulatorSampler* sampler, const File& sampleFile)
+	{
+		beginTest("Testing the map after adding sounds");
+
+		expectMap(sampler, 0, {}, {});
+
+		addSound(sampler, sampleFile, 60, 62, 1);
+		expectOutdated(sampler);
+		expectMap(sampler, 1, { 60, 61, 62 }, { 1, 1, 1 });
+
+		addSound(sampler, sampleFile, 62, 64, 2);
+		expectOutdated(sampler);
+		expectMap(sampler, 2, { 60, 61, 62, 62, 63, 64 }, { 1, 1, 1, 2, 2, 2 });
+	}
+
+	void testDeleteSound(ModulatorSampler* sampler)
+	{
+		beginTest("Testing the map after deleting a sound");
+
+		sampler->deleteSound(0);
+		expectOutdated(sampler);
+		expectMap(sampler, 1, { 62, 63, 64 }, { 2, 2, 2 });
+	}
+
+	void testDeleteAllSounds(ModulatorSampler* sampler, const File& sampleFile)
+	{
+		beginTest("Testing the map after deleting all sounds");
+
+		addSound(sampler, sampleFile, 10, 10, 1);
+		sampler->refreshNoteSoundMap();
+
+		sampler->deleteAllSounds();
+		expectOutdated(sampler);
+		expectMap(sampler, 0, {}, {});
+	}
+
+	static void writeTestSample(const File& f)
+	{
+		AudioSampleBuffer b(2, 1024);
+		b.clear();
+
+		WavAudioFormat wav;
+		ScopedPointer<FileOutputStream> fos = new FileOutputStream(f);
+		ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(fos, 44100.0, 2, 24, StringPairArray(), 0);
+
+		if (writer != nullptr)
+		{
+			fos.release();
+			writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+		}
+	}
+
+	static void addSound(ModulatorSampler* sampler, const File& sampleFile, int loKey, int hiKey, int rrGroup)
+	{
+		ValueTree s("sample");
+		s.setProperty(SampleIds::FileName, sampleFile.getFullPathName(), nullptr);
+		s.setProperty(SampleIds::Root, loKey, nullptr);
+		s.setProperty(SampleIds::LoKey, loKey, nullptr);
+		s.setProperty(SampleIds::HiKey, hiKey, nullptr);
+		s.setProperty(SampleIds::LoVel, 0, nullptr);
+		s.setProperty(SampleIds::HiVel, 127, nullptr);
+		s.setProperty(SampleIds::RRGroup, rrGroup, nullptr);
+
+		sampler->getSampleMap()->addSampleFromValueTree(s);
+	}
+
+	void expectOutdated(ModulatorSampler* sampler)
+	{
+		expect(sampler->getNoteSoundMap() == nullptr, "The map wasn't invalidated");
+	}
+
+	/** Rebuilds the map and checks that it contains exactly the given (note, rrGroup) entries in this order
+		and that every entry points to a sound that is still in the sampler. */
+	void expectMap(ModulatorSampler* sampler, int numSounds, Array<int> notes, Array<int> rrGroups)
+	{
+		sampler->refreshNoteSoundMap();
+
+		auto map = sampler->getNoteSoundMap();
+
+		expect(map != nullptr, "The map wasn't rebuilt");
+		expectEquals(sampler->getNumSounds(), numSounds, "Number of sounds");
+
+		if (map == nullptr)
+			return;
+
+		int entryIndex = 0;
+
+		for (int i = 0; i < 128; i++)
+		{
+			for (const auto& e : map->getSoundsForNote(i))
+			{
+				expectEquals(i, notes[entryIndex], "Note number");
+				expectEquals(e.rrGroup, rrGroups[entryIndex], "RR group");
+
+				bool found = false;
+
+				for (int s = 0; s < sampler->getNumSounds(); s++)
+					found |= sampler->getSound(s) == e.sound;
+
+				expect(found, "The map contains a deleted sound");
+
+				entryIndex++;
+			}
+		}
+
+		expectEquals(entryIndex, notes.size(), "Number of entries");
+	}
+};
+
+static NoteSoundMapUnitTests noteSoundMapUnitTests;
+
+#endif
@@ -0,0 +1,219 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class SamplerSoundPoolUnitTests : public UnitTest
+{
+public:
+
+	SamplerSoundPoolUnitTests() :
+		UnitTest("Testing sample pool lookup")
+	{
+
+	}
+
+	void runTest() override
+	{
+		createReferences();
+
+		testIndex();
+		testRemove();
+		runBenchmark();
+	}
+
+private:
+
+	static constexpr int NumSamples = 50000;
+
+	/** The linear search is quadratic, so the benchmark uses less samples than the index tests. */
+	static constexpr int NumBenchmarkSamples = 5000;
+
+	/** The lookup that was used before the pool had a hash index. */
+	struct LinearPool
+	{
+		bool contains(const PoolReference& r) const
+		{
+			for (const auto& entry : pool)
+			{
+				if (r == entry.r)
+					return true;
+			}
+
+			return false;
+		}
+
+		void add(const ModulatorSamplerSoundPool::PoolEntry& e)
+		{
+			pool.add(e);
+		}
+
+		Array<ModulatorSamplerSoundPool::PoolEntry> pool;
+	};
+
+	void createReferences()
+	{
+		references.clearQuick();
+		references.ensureStorageAllocated(NumSamples);
+
+		for (int i = 0; i < NumSamples; i++)
+		{
+			String s;
+			s << "{PROJECT_FOLDER}Instrument/Mic" << String(i % 4 + 1) << "/Sample_" << String(i) << ".wav";
+
+			DynamicObject::Ptr obj = new DynamicObject();
+			obj->setProperty("HashCode", s.hashCode64());
+			obj->setProperty("Mode", (int)PoolReference::ProjectPath);
+			obj->setProperty("Reference", s);
+			obj->setProperty("Type", (int)FileHandlerBase::Samples);
+			obj->setProperty("File", "");
+
+			references.add(PoolReference(var(obj.get())));
+		}
+	}
+
+	void testIndex()
+	{
+		beginTest("Testing pool index");
+
+		ModulatorSamplerSoundPool pool(nullptr);
+
+		for (const auto& r : references)
+			pool.addSound({ r, nullptr });
+
+		expectEquals(pool.getNumSoundsInPool(), NumSamples, "Pool size");
+
+		Random random(1234);
+
+		for (int i = 0; i < 1000; i++)
+		{
+			const int index = random.nextInt(NumSamples);
+			expectEquals(pool.getSoundIndexFromPool(references[index].getHashCode()), index, "Index lookup");
+		}
+
+		expectEquals(pool.getSoundIndexFromPool(String("NotInPool").hashCode64()), -1, "Missing entry");
+
+		pool.setDeactivatePoolSearch(true);
+		expectEquals(pool.getSoundIndexFromPool(references[0].getHashCode()), -1, "Deactivated pool search");
+	}
+
+	void testRemove()
+	{
+		beginTest("Testing index after removing entries");
+
+		ModulatorSamplerSoundPool pool(nullptr);
+
+		const int numToUse = 1000;
+
+		for (int i = 0; i < numToUse; i++)
+			pool.addSound({ references[i], nullptr });
+
+		pool.removeFromPool(references[10]);
+		pool.removeFromPool(references[500]);
+
+		expectEquals(pool.getNumSoundsInPool(), numToUse - 2, "Pool size");
+		expectEquals(pool.getSoundIndexFromPool(references[10].getHashCode()), -1, "Removed entry");
+		expectEquals(pool.getSoundIndexFromPool(references[9].getHashCode()), 9, "Entry before removed one");
+		expectEquals(pool.getSoundIndexFromPool(references[11].getHashCode()), 10, "Entry after removed one");
+		expectEquals(pool.getSoundIndexFromPool(references[numToUse - 1].getHashCode()), numToUse - 3, "Last entry");
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking sample map loading with " + String(NumBenchmarkSamples) + " samples");
+
+		// This simulates the lookup pattern of loading a sample map: every sample checks if it's already in the pool
+		// and is added if not. The second pass simulates loading another sample map that uses the same samples.
+
+		double linearTime = 0.0;
+		double indexTime = 0.0;
+
+		LinearPool linearPool;
+		ModulatorSamplerSoundPool pool(nullptr);
+
+		{
+			const double start = Time::getMillisecondCounterHiRes();
+
+			for (int pass = 0; pass < 2; pass++)
+			{
+				for (int i = 0; i < NumBenchmarkSamples; i++)
+				{
+					if (!linearPool.contains(references[i]))
+						linearPool.add({ references[i], nullptr });
+				}
+			}
+
+			linearTime = Time::getMillisecondCounterHiRes() - start;
+		}
+
+		{
+			const double start = Time::getMillisecondCounterHiRes();
+
+			for (int pass = 0; pass < 2; pass++)
+			{
+				for (int i = 0; i < NumBenchmarkSamples; i++)
+				{
+					if (pool.getSoundIndexFromPool(references[i].getHashCode()) == -1)
+						pool.addSound({ references[i], nullptr });
+				}
+			}
+
+			indexTime = Time::getMillisecondCounterHiRes() - start;
+		}
+
+		// The timings depend on the machine, so only the results are checked
+		expectEquals(linearPool.pool.size(), NumBenchmarkSamples, "Linear pool size");
+		expectEquals(pool.getNumSoundsInPool(), NumBenchmarkSamples, "Pool size");
+
+		int numMismatches = 0;
+
+		for (int i = 0; i < NumBenchmarkSamples; i++)
+		{
+			if (pool.getSoundIndexFromPool(references[i].getHashCode()) != i || !(linearPool.pool[i].r == references[i]))
+				numMismatches++;
+		}
+
+		expectEquals(numMismatches, 0, "Lookup results");
+
+		logMessage("Linear search: " + String(linearTime, 1) + "ms, Hash index: " + String(indexTime, 1) + "ms");
+	}
+
+	Array<PoolReference> references;
+};
+
+static SamplerSoundPoolUnitTests samplerSoundPoolUnitTests;
+
+#endif
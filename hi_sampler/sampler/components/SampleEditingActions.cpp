@@ -217,6 +217,7 @@ void SampleEditHandler::SampleEditingActions::checkMicPositionAmountBeforePastin
 		}
 		else if (PresetHandler::showYesNoWindow("Different mic amount detected.", "Do you want to replace all existing samples in this sampler?"))
 		{
+			s->invalidateNoteSoundMap();
 			s->clearSounds();
 
 			s->setNumChannels(numMics);
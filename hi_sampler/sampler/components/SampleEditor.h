@@ -73,6 +73,8 @@ public:
 	{
 		currentWaveForm->setSoundToDisplay(nullptr);
 		updateWaveform();
+
+		currentWaveForm->prefetchPeakCache(sampler);
 	}
 
 	void samplePropertyWasChanged(ModulatorSamplerSound* s, const Identifier& id, const var& newValue) override;
@@ -354,6 +354,9 @@ private:
 		testAhdsrSustain(true);
 		testAhdsrSustain(false);
 
+		testAhdsrSegmentRendering(false);
+		testAhdsrSegmentRendering(true);
+
 		testConstantModulator(false);
 		testConstantModulator(true);
 
@@ -370,12 +373,50 @@ private:
 
 		testGlobalModulators(false);
 		testGlobalModulators(true);
-		
+
+		testGlobalEnvelope();
+		testGlobalEnvelopeWithoutContainerVoice();
+		testGlobalEnvelopeVoiceReuse();
+
 		testGlobalModulatorIntensity(false);
 		testGlobalModulatorIntensity(true);
+
+		testControlRateDivisor(false);
+		testControlRateDivisor(true);
 	
 		testScriptPitchFade(false);
 		testScriptPitchFade(true);
+
+		testParallelCrossfadeGroups();
+	}
+
+	void testControlRateDivisor(bool useGroup)
+	{
+		beginTestWithOptionalGroup("Testing control rate divisor", useGroup);
+
+		// The expansion ramps towards the next control value, so the divisors
+		// are a few samples apart on the slopes, but the timing must be the same.
+		const float errorLevel = -40.0f;
+
+		auto envelopeReference = renderEnvelopeWithControlRate(useGroup, HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR);
+		auto globalReference = renderGlobalLfoWithControlRate(useGroup, HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR);
+
+		for (int divisor : { 1, 4 })
+		{
+			auto envelopeData = renderEnvelopeWithControlRate(useGroup, divisor);
+
+			expectResult(envelopeData.matches(envelopeReference, this, errorLevel), "Envelope with divisor " + String(divisor));
+			expectResult(envelopeData.isWithinErrorRange(attackSamplesForDivisorTest + HISE_EVENT_RASTER, 1.0f), "Attack end with divisor " + String(divisor));
+
+			auto globalData = renderGlobalLfoWithControlRate(useGroup, divisor);
+
+			expectResult(globalData.matches(globalReference, this, errorLevel), "Global receiver with divisor " + String(divisor));
+		}
+
+		// The block-constant mode uses the coarsest rate, but the envelope must still reach its end in time
+		auto constantData = renderEnvelopeWithControlRate(useGroup, 1, true);
+
+		expectResult(constantData.isWithinErrorRange(attackSamplesForDivisorTest + 512, 1.0f), "Attack end in block-constant mode");
 	}
 
 	void testPanModulation(bool useGroup)
@@ -560,6 +601,121 @@ private:
 		bp = nullptr;
 	}
 
+	void testGlobalEnvelope()
+	{
+		beginTest("Testing global envelope");
+
+		// Init
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, false);
+
+		// Setup
+		addGlobalEnvelope(bp);
+
+		// Process
+		auto testData = Helpers::createTestDataWithOneSecondNote(0, noteOffForGlobalEnvelope);
+		Helpers::process(bp, testData, 512);
+
+		auto reference = renderGlobalEnvelopeReference(testData);
+
+		// Tests
+		expectMatchingSamples(testData, reference, 0, "Attack");
+		expectResult(testData.isWithinErrorRange(noteOffForGlobalEnvelope / 2, 1.0f), "Sustain");
+
+		// The own gain envelope is bypassed, so only the receiver keeps the voice alive after the note off
+		expectMatchingSamples(testData, reference, noteOffForGlobalEnvelope, "Release");
+		expect(testData.getSample(noteOffForGlobalEnvelope + globalEnvelopeSamples / 2) > 0.4f, "Voice was killed before the release ended");
+
+		expectResult(testData.isWithinErrorRange(noteOffForGlobalEnvelope + globalEnvelopeSamples + 1024, 0.0f), "Voice is still playing after the release");
+		expectEquals(Helpers::get<NoiseSynth>(bp)->getNumActiveVoices(), 0, "Active voices");
+
+		bp = nullptr;
+	}
+
+	void testGlobalEnvelopeWithoutContainerVoice()
+	{
+		beginTest("Testing global envelope with an event that the container doesn't play");
+
+		// Init
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, false);
+
+		// Setup
+		addGlobalEnvelope(bp);
+
+		// A bypassed container doesn't start any voices
+		Helpers::get<GlobalModulatorContainer>(bp)->setBypassed(true, dontSendNotification);
+
+		// Process
+		auto testData = Helpers::createTestDataWithOneSecondNote(0, noteOffForGlobalEnvelope);
+		Helpers::process(bp, testData, 512);
+
+		// Tests
+		expectResult(testData.isWithinErrorRange(globalEnvelopeSamples / 4, 1.0f), "No attack without container voice");
+		expectResult(testData.isWithinErrorRange(noteOffForGlobalEnvelope / 2, 1.0f), "Sustain");
+		expectResult(testData.isWithinErrorRange(noteOffForGlobalEnvelope + 1024, 0.0f), "No release without container voice");
+
+		bp = nullptr;
+	}
+
+	void testGlobalEnvelopeVoiceReuse()
+	{
+		beginTest("Testing global envelope with reused container voices");
+
+		// Init
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, false);
+
+		// Setup
+		auto sender = addGlobalEnvelope(bp);
+		auto container = Helpers::get<GlobalModulatorContainer>(bp);
+		auto noiseSynth = Helpers::get<NoiseSynth>(bp);
+
+		// The first note has ended before the second note starts
+		const int secondNoteOn = sampleRate / 2;
+		const int secondCheck = 24576;
+
+		Helpers::TestData testData;
+		testData.audioBuffer.setSize(2, sampleRate * 2);
+		testData.audioBuffer.clear();
+		testData.midiBuffer.addEvent(MidiMessage::noteOn(1, 64, 1.0f), 0);
+		testData.midiBuffer.addEvent(MidiMessage::noteOff(1, 64), 8192);
+		testData.midiBuffer.addEvent(MidiMessage::noteOn(1, 64, 1.0f), secondNoteOn);
+		testData.midiBuffer.addEvent(MidiMessage::noteOff(1, 64), noteOffForGlobalEnvelope);
+
+		auto getEventIdOfFirstVoice = [noiseSynth]()
+		{
+			return static_cast<ModulatorSynthVoice*>(noiseSynth->getVoice(0))->getCurrentHiseEvent().getEventId();
+		};
+
+		// Process
+		Helpers::process(bp, testData, 512, 4096);
+
+		const uint16 firstId = getEventIdOfFirstVoice();
+		const int containerVoice = container->getVoiceIndexForEvent(firstId);
+
+		Helpers::resumeProcessing(bp, testData, 512, secondCheck - 4096, 4096);
+
+		const uint16 secondId = getEventIdOfFirstVoice();
+
+		// Tests
+		expect(firstId != secondId, "The second note didn't start");
+		expect(containerVoice != -1, "The container didn't play the first note");
+		expectEquals(container->getVoiceIndexForEvent(secondId), containerVoice, "The container voice wasn't reused");
+		expectEquals(container->getVoiceIndexForEvent(firstId), -1, "The old event is still found");
+
+		expect(container->getEnvelopeValuesForModulator(sender, containerVoice, firstId, 0) == nullptr, "The old event reads the values of the new event");
+		expect(container->getEnvelopeValuesForModulator(sender, containerVoice, secondId, 0) != nullptr, "No values for the new event");
+		expect(!container->isEnvelopePlaying(sender, containerVoice, firstId), "The old event is still playing");
+		expect(container->isEnvelopePlaying(sender, containerVoice, secondId), "The new event isn't playing");
+
+		Helpers::resumeProcessing(bp, testData, 512, -1, secondCheck);
+
+		auto reference = renderGlobalEnvelopeReference(testData);
+
+		expectMatchingSamples(testData, reference, secondNoteOn, "Attack of the second note");
+		expectMatchingSamples(testData, reference, noteOffForGlobalEnvelope, "Release of the second note");
+
+		bp = nullptr;
+	}
+
 	void testSynthGroup()
 	{
 		beginTest("Testing SynthGroup modulators");
@@ -871,6 +1027,34 @@ private:
 		expectResult(testData.isWithinErrorRange(22050, sustainLevel), "Sustain value");
 	}
 
+	void testAhdsrSegmentRendering(bool useGroup)
+	{
+		beginTestWithOptionalGroup("Testing AHDSR segment rendering", useGroup);
+
+		const float intensity = 0.75f;
+		const float sustainLevel = 0.25f;
+
+		auto reference = renderAhdsr(useGroup, true, intensity, sustainLevel);
+		auto testData = renderAhdsr(useGroup, false, intensity, sustainLevel);
+
+		// The reference must go through every state, otherwise the comparison is meaningless
+		expectResult(reference.isWithinErrorRange(22050, 1.0f - intensity + intensity * sustainLevel), "Sustain");
+		expectResult(reference.isWithinErrorRange(roundToInt(sampleRate * 1.5), 0.0f), "Release");
+
+		int numDifferentSamples = 0;
+
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < testData.audioBuffer.getNumSamples(); i++)
+			{
+				if (testData.audioBuffer.getSample(c, i) != reference.audioBuffer.getSample(c, i))
+					numDifferentSamples++;
+			}
+		}
+
+		expectEquals(numDifferentSamples, 0, "Samples that differ from the per-sample rendering");
+	}
+
 	void testLFOSeq(bool useGroup)
 	{
 		beginTestWithOptionalGroup("Testing LFO Seq", useGroup);
@@ -1404,6 +1588,247 @@ private:
 
 	};
 
+	static constexpr int globalEnvelopeSamples = 4096;
+	static constexpr int noteOffForGlobalEnvelope = 30870;
+
+	static float getGlobalEnvelopeMs()
+	{
+		return (float)globalEnvelopeSamples / (float)sampleRate * 1000.0f;
+	}
+
+	/** Bypasses the gain envelope of the noise synth and adds a receiver for a simple envelope in a global container. */
+	SimpleEnvelope* addGlobalEnvelope(BackendProcessor* bp)
+	{
+		Helpers::get<SimpleEnvelope>(bp)->setBypassed(true);
+
+		Helpers::addGlobalContainer(bp, false);
+
+		auto sender = Helpers::addVoiceModulator<GlobalModulatorContainer, SimpleEnvelope>(bp, ModulatorSynth::GainModulation);
+		auto receiver = Helpers::addVoiceModulator<NoiseSynth, GlobalEnvelopeModulator>(bp, ModulatorSynth::GainModulation);
+
+		sender->setAttribute(SimpleEnvelope::Attack, getGlobalEnvelopeMs(), dontSendNotification);
+		sender->setAttribute(SimpleEnvelope::Release, getGlobalEnvelopeMs(), dontSendNotification);
+
+		receiver->connectToGlobalModulator("Container:" + sender->getId());
+
+		expect(receiver->isConnected(), "Connection failed");
+
+		return sender;
+	}
+
+	/** Renders the same envelope directly in the gain chain of the noise synth. */
+	static Helpers::TestData renderGlobalEnvelopeReference(const Helpers::TestData& data)
+	{
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, false);
+
+		Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Attack, getGlobalEnvelopeMs());
+		Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Release, getGlobalEnvelopeMs());
+
+		Helpers::TestData reference;
+		reference.midiBuffer = data.midiBuffer;
+		reference.audioBuffer.setSize(2, data.audioBuffer.getNumSamples());
+		reference.audioBuffer.clear();
+
+		Helpers::process(bp, reference, 512);
+
+		return reference;
+	}
+
+	void expectMatchingSamples(const Helpers::TestData& actual, const Helpers::TestData& expected, int startOffset, const String& message)
+	{
+		for (int i = 1; i < 4; i++)
+		{
+			const int sampleIndex = startOffset + i * globalEnvelopeSamples / 4;
+			expectResult(actual.isWithinErrorRange(sampleIndex, expected.getSample(sampleIndex), 0, -40.0f), message + " at sample " + String(sampleIndex));
+		}
+	}
+
+	static constexpr int attackSamplesForDivisorTest = 2048;
+
+	static void setEnvelopeForDivisorTest(BackendProcessor* bp, float attackMs)
+	{
+		Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Attack, attackMs);
+		Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Release, 50.0f);
+	}
+
+	Helpers::TestData renderEnvelopeWithControlRate(bool useGroup, int divisor, bool constantForBlock=false)
+	{
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, useGroup);
+
+		const float attackMs = (float)attackSamplesForDivisorTest / (float)sampleRate * 1000.0f;
+		setEnvelopeForDivisorTest(bp, attackMs);
+
+		auto chain = Helpers::getMainSynth(bp, useGroup)->getModChainWithBuffer(ModulatorSynth::GainModulation);
+
+		chain->setControlRateDivisor(divisor);
+
+		if (constantForBlock)
+		{
+			chain->setUseConstantValueForBlock(true);
+			expectEquals(chain->getControlRateDivisor(), HISE_EVENT_RASTER, "block-constant divisor");
+
+			// The requested divisor must come back after disabling the mode
+			chain->setUseConstantValueForBlock(false);
+			expectEquals(chain->getControlRateDivisor(), divisor, "restored divisor");
+
+			chain->setUseConstantValueForBlock(true);
+		}
+
+		auto testData = Helpers::createTestDataWithOneSecondNote();
+		Helpers::process(bp, testData, 512);
+
+		bp = nullptr;
+
+		return testData;
+	}
+
+	Helpers::TestData renderGlobalLfoWithControlRate(bool useGroup, int divisor)
+	{
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, useGroup);
+
+		setEnvelopeForDivisorTest(bp, 0.0f);
+
+		Helpers::addGlobalContainer(bp, useGroup);
+
+		auto sender = Helpers::addTimeModulator<GlobalModulatorContainer, LfoModulator>(bp, ModulatorSynth::GainModulation);
+		auto receiver = Helpers::addTimeModulatorToOptionalGroup<GlobalTimeVariantModulator>(bp, ModulatorSynth::GainModulation);
+
+		Helpers::setLfoToDefaultSquare(sender);
+		sender->setAttribute(LfoModulator::WaveFormType, LfoModulator::Sine, dontSendNotification);
+
+		receiver->connectToGlobalModulator("Container:" + sender->getId());
+
+		expect(receiver->isConnected(), "Connection failed");
+
+		// The container stays at its own rate, only the receiver's chain changes
+		Helpers::getMainSynth(bp, useGroup)->getModChainWithBuffer(ModulatorSynth::GainModulation)->setControlRateDivisor(divisor);
+
+		auto testData = Helpers::createTestDataWithOneSecondNote();
+		Helpers::process(bp, testData, 512);
+
+		bp = nullptr;
+
+		return testData;
+	}
+
+	void testParallelCrossfadeGroups()
+	{
+		beginTest("Testing parallel voice rendering with crossfade groups");
+
+		TemporaryFile sampleFile(".wav");
+		writeCrossfadeTestSample(sampleFile.getFile());
+
+		auto serialData = renderCrossfadeGroups(sampleFile.getFile(), false);
+		auto parallelData = renderCrossfadeGroups(sampleFile.getFile(), true);
+
+		expectResult(parallelData.matches(serialData, this, -80.0f), "Parallel output doesn't match the serial output");
+	}
+
+	Helpers::TestData renderAhdsr(bool useGroup, bool renderPerSample, float intensity, float sustainLevel)
+	{
+		ScopedProcessor bp = Helpers::createWithOptionalGroup(NoiseSynth::DC, useGroup);
+
+		Helpers::get<SimpleEnvelope>(bp)->setBypassed(true);
+
+		auto ahdsr = Helpers::addVoiceModulatorToOptionalGroup<AhdsrEnvelope>(bp, ModulatorSynth::GainModulation);
+
+		ahdsr->setUsePerSampleRendering(renderPerSample);
+		ahdsr->setIntensity(intensity);
+
+		// The segments don't line up with the blocks
+		Helpers::setAttribute<AhdsrEnvelope>(bp, AhdsrEnvelope::Attack, 33.0f);
+		Helpers::setAttribute<AhdsrEnvelope>(bp, AhdsrEnvelope::Hold, 17.0f);
+		Helpers::setAttribute<AhdsrEnvelope>(bp, AhdsrEnvelope::Decay, 110.0f);
+		Helpers::setAttribute<AhdsrEnvelope>(bp, AhdsrEnvelope::Sustain, Decibels::gainToDecibels(sustainLevel));
+		Helpers::setAttribute<AhdsrEnvelope>(bp, AhdsrEnvelope::Release, 230.0f);
+
+		auto testData = Helpers::createTestDataWithOneSecondNote();
+
+		Helpers::process(bp, testData, 512);
+
+		bp = nullptr;
+
+		return testData;
+	}
+
+	static constexpr int crossfadeTestSampleLength = 4096;
+
+	static void writeCrossfadeTestSample(const File& f)
+	{
+		AudioSampleBuffer b(2, crossfadeTestSampleLength);
+		Random r(1234);
+
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < crossfadeTestSampleLength; i++)
+				b.setSample(c, i, (r.nextFloat() * 2.0f - 1.0f) * 0.25f);
+		}
+
+		WavAudioFormat wav;
+		ScopedPointer<FileOutputStream> fos = new FileOutputStream(f);
+		ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(fos, (double)sampleRate, 2, 24, StringPairArray(), 0);
+
+		if (writer != nullptr)
+		{
+			fos.release();
+			writer->writeFromAudioSampleBuffer(b, 0, crossfadeTestSampleLength);
+		}
+	}
+
+	Helpers::TestData renderCrossfadeGroups(const File& sampleFile, bool useParallelRendering)
+	{
+		ScopedProcessor bp = new BackendProcessor(nullptr, nullptr);
+
+		expect(bp->getAudioRenderingThreadPool() != nullptr, "No audio worker threads");
+
+		auto sampler = new ModulatorSampler(bp, "Sampler", NUM_POLYPHONIC_VOICES);
+		sampler->addProcessorsWhenEmpty();
+		sampler->setAttribute(ModulatorSynth::Parameters::Gain, 1.0f, dontSendNotification);
+		bp->getMainSynthChain()->getHandler()->add(sampler, nullptr);
+
+		Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Attack, 0.0f);
+		Helpers::setAttribute<SimpleEnvelope>(bp, SimpleEnvelope::Release, 0.0f);
+
+		// The velocity gives every voice a different crossfade value
+		Helpers::addVoiceModulator<ModulatorSampler, VelocityModulator>(bp, ModulatorSampler::CrossFadeModulation);
+
+		sampler->setAttribute(ModulatorSampler::RRGroupAmount, 2.0f, dontSendNotification);
+		sampler->setAttribute(ModulatorSampler::CrossfadeGroups, 1.0f, dontSendNotification);
+
+		for (int group = 1; group <= 2; group++)
+		{
+			ValueTree s("sample");
+			s.setProperty(SampleIds::FileName, sampleFile.getFullPathName(), nullptr);
+			s.setProperty(SampleIds::Root, 64, nullptr);
+			s.setProperty(SampleIds::LoKey, 0, nullptr);
+			s.setProperty(SampleIds::HiKey, 127, nullptr);
+			s.setProperty(SampleIds::LoVel, 0, nullptr);
+			s.setProperty(SampleIds::HiVel, 127, nullptr);
+			s.setProperty(SampleIds::RRGroup, group, nullptr);
+
+			sampler->getSampleMap()->addSampleFromValueTree(s);
+		}
+
+		sampler->refreshNoteSoundMap();
+		sampler->setUseParallelVoiceRendering(useParallelRendering);
+
+		// Four notes with two groups start enough voices for the parallel rendering
+		static_assert(4 * 2 >= ModulatorSynth::MinNumVoicesForParallelRendering, "not enough voices");
+
+		Helpers::TestData d;
+		d.audioBuffer.setSize(2, crossfadeTestSampleLength);
+		d.audioBuffer.clear();
+
+		for (int i = 0; i < 4; i++)
+			d.midiBuffer.addEvent(MidiMessage::noteOn(1, 60 + i, (uint8)(20 + i * 30)), 0);
+
+		Helpers::process(bp, d, 512);
+
+		bp = nullptr;
+
+		return d;
+	}
+
 };
 
 
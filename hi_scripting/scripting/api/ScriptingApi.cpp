@@ -1617,6 +1617,7 @@ struct ScriptingApi::Sampler::Wrapper
     API_VOID_METHOD_WRAPPER_2(Sampler, setAttribute);
     API_METHOD_WRAPPER_1(Sampler, getAttribute);
 	API_VOID_METHOD_WRAPPER_1(Sampler, setUseStaticMatrix);
+	API_VOID_METHOD_WRAPPER_1(Sampler, setUseParallelVoiceRendering);
 };
 
 
@@ -1646,6 +1647,7 @@ sampler(sampler_)
     ADD_API_METHOD_2(setAttribute);
 	ADD_API_METHOD_1(isNoteNumberMapped);
 	ADD_API_METHOD_1(setUseStaticMatrix);
+	ADD_API_METHOD_1(setUseParallelVoiceRendering);
 
 	sampleIds.add(SampleIds::ID);
 	sampleIds.add(SampleIds::FileName);
@@ -2114,6 +2116,19 @@ void ScriptingApi::Sampler::setUseStaticMatrix(bool shouldUseStaticMatrix)
 	s->setUseStaticMatrix(shouldUseStaticMatrix);
 }
 
+void ScriptingApi::Sampler::setUseParallelVoiceRendering(bool shouldRenderInParallel)
+{
+	ModulatorSampler *s = static_cast<ModulatorSampler*>(sampler.get());
+
+	if (s == nullptr)
+	{
+		reportScriptError("setUseParallelVoiceRendering() only works with Samplers.");
+		RETURN_VOID_IF_NO_THROW()
+	}
+
+	s->setUseParallelVoiceRendering(shouldRenderInParallel);
+}
+
 // ====================================================================================================== Synth functions
 
 
@@ -2168,6 +2183,7 @@ struct ScriptingApi::Synth::Wrapper
 	API_METHOD_WRAPPER_1(Synth, isKeyDown);
 	API_VOID_METHOD_WRAPPER_1(Synth, setClockSpeed);
 	API_VOID_METHOD_WRAPPER_1(Synth, setShouldKillRetriggeredNote);
+	API_VOID_METHOD_WRAPPER_1(Synth, setRenderChildSynthsConcurrently);
 };
 
 
@@ -2234,6 +2250,7 @@ ScriptingApi::Synth::Synth(ProcessorWithScriptingContent *p, ModulatorSynth *own
 	ADD_API_METHOD_1(isKeyDown);
 	ADD_API_METHOD_1(setClockSpeed);
 	ADD_API_METHOD_1(setShouldKillRetriggeredNote);
+	ADD_API_METHOD_1(setRenderChildSynthsConcurrently);
 	
 };
 
@@ -3104,6 +3121,18 @@ void ScriptingApi::Synth::setShouldKillRetriggeredNote(bool killNote)
 	}
 }
 
+void ScriptingApi::Synth::setRenderChildSynthsConcurrently(bool shouldRenderConcurrently)
+{
+	if (auto chain = dynamic_cast<ModulatorSynthChain*>(owner))
+	{
+		chain->setRenderChildSynthsConcurrently(shouldRenderConcurrently);
+	}
+	else
+	{
+		reportScriptError("setRenderChildSynthsConcurrently() only works with Containers.");
+	}
+}
+
 var ScriptingApi::Synth::getAllModulators(String regex)
 {
 	Processor::Iterator<Modulator> iter(owner->getMainController()->getMainSynthChain());
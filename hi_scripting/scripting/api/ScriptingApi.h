@@ -478,6 +478,9 @@ public:
 		/** Disables dynamic resizing when a sample map is loaded. */
 		void setUseStaticMatrix(bool shouldUseStaticMatrix);
 
+		/** Renders the voices on multiple threads if there are many voices playing (requires HISE_NUM_AUDIO_WORKER_THREADS). */
+		void setUseParallelVoiceRendering(bool shouldRenderInParallel);
+
 		// ============================================================================================================
 
 		struct Wrapper;
@@ -578,6 +581,9 @@ public:
 		/** If set to true, this will kill retriggered notes (default). */
 		void setShouldKillRetriggeredNote(bool killNote);
 
+		/** Renders the child synths of this container on multiple threads (requires HISE_NUM_AUDIO_WORKER_THREADS). */
+		void setRenderChildSynthsConcurrently(bool shouldRenderConcurrently);
+
 		/** Returns an array of all modulators that match the given regex. */
 		var getAllModulators(String regex);
 
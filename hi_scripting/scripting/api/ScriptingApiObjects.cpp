@@ -1178,6 +1178,8 @@ struct ScriptingObjects::ScriptingSynth::Wrapper
 	API_METHOD_WRAPPER_1(ScriptingSynth, getModulatorChain);
 	API_METHOD_WRAPPER_3(ScriptingSynth, addGlobalModulator);
 	API_METHOD_WRAPPER_3(ScriptingSynth, addStaticGlobalModulator);
+	API_VOID_METHOD_WRAPPER_2(ScriptingSynth, setModulatorChainControlRate);
+	API_VOID_METHOD_WRAPPER_2(ScriptingSynth, setModulatorChainConstantForBlock);
 	API_METHOD_WRAPPER_0(ScriptingSynth, asSampler);
 	API_METHOD_WRAPPER_0(ScriptingSynth, getRoutingMatrix);
 	API_METHOD_WRAPPER_0(ScriptingSynth, getId);
@@ -1217,6 +1219,8 @@ ScriptingObjects::ScriptingSynth::ScriptingSynth(ProcessorWithScriptingContent *
 	ADD_API_METHOD_1(getModulatorChain);
 	ADD_API_METHOD_3(addGlobalModulator);
 	ADD_API_METHOD_3(addStaticGlobalModulator);
+	ADD_API_METHOD_2(setModulatorChainControlRate);
+	ADD_API_METHOD_2(setModulatorChainConstantForBlock);
 	ADD_API_METHOD_0(asSampler);
 	ADD_API_METHOD_0(getRoutingMatrix);
 };
@@ -1409,6 +1413,48 @@ var ScriptingObjects::ScriptingSynth::addStaticGlobalModulator(var chainIndex, v
 	return var();
 }
 
+void ScriptingObjects::ScriptingSynth::setModulatorChainControlRate(var chainIndex, int samplesPerValue)
+{
+	if (auto mb = getModChainWithBuffer(chainIndex))
+	{
+		// The sub blocks are aligned to the event raster, so the control rate can't be coarser than that
+		if (!isPowerOfTwo(samplesPerValue) || !isPositiveAndNotGreaterThan(samplesPerValue, HISE_EVENT_RASTER))
+		{
+			reportScriptError("The control rate must be a power of two between 1 and " + String(HISE_EVENT_RASTER));
+			return;
+		}
+
+		LockHelpers::SafeLock sl(synth->getMainController(), LockHelpers::AudioLock);
+
+		mb->setControlRateDivisor(samplesPerValue);
+	}
+}
+
+void ScriptingObjects::ScriptingSynth::setModulatorChainConstantForBlock(var chainIndex, bool shouldBeConstant)
+{
+	if (auto mb = getModChainWithBuffer(chainIndex))
+	{
+		LockHelpers::SafeLock sl(synth->getMainController(), LockHelpers::AudioLock);
+
+		mb->setUseConstantValueForBlock(shouldBeConstant);
+	}
+}
+
+ModulatorChain::ModChainWithBuffer* ScriptingObjects::ScriptingSynth::getModChainWithBuffer(var chainIndex)
+{
+	if (checkValidObject())
+	{
+		auto mb = dynamic_cast<ModulatorSynth*>(synth.get())->getModChainWithBuffer(chainIndex);
+
+		if (mb == nullptr)
+			reportScriptError("Modulator Chain with index " + chainIndex.toString() + " does not exist");
+
+		return mb;
+	}
+
+	return nullptr;
+}
+
 var ScriptingObjects::ScriptingSynth::asSampler()
 {
 	if (checkValidObject())
@@ -2109,10 +2155,22 @@ ScriptingObjects::GraphicsObject::~GraphicsObject()
 
 struct ScriptedDrawActions
 {
+	/** Returns the other action if it has the same type or nullptr. */
+	template <class T> static const T* as(const DrawActions::ActionBase* other)
+	{
+		return dynamic_cast<const T*>(other);
+	}
+
+	static bool isSameShadow(const DropShadow& s1, const DropShadow& s2)
+	{
+		return s1.colour == s2.colour && s1.radius == s2.radius && s1.offset == s2.offset;
+	}
+
 	struct fillAll : public DrawActions::ActionBase
 	{
 		fillAll(Colour c_) : c(c_) {};
 		void perform(Graphics& g) { g.fillAll(c); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<fillAll>(other); return o != nullptr && o->c == c; }
 		Colour c;
 	};
 
@@ -2120,6 +2178,7 @@ struct ScriptedDrawActions
 	{
 		setColour(Colour c_) : c(c_) {};
 		void perform(Graphics& g) { g.setColour(c); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<setColour>(other); return o != nullptr && o->c == c; }
 		Colour c;
 	};
 
@@ -2127,6 +2186,8 @@ struct ScriptedDrawActions
 	{
 		addTransform(AffineTransform a_) : a(a_) {};
 		void perform(Graphics& g) override { g.addTransform(a); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<addTransform>(other); return o != nullptr && o->a == a; }
+		bool changesCoordinates() const override { return true; }
 		AffineTransform a;
 	};
 
@@ -2134,6 +2195,8 @@ struct ScriptedDrawActions
 	{
 		fillPath(const Path& p_) : p(p_) {};
 		void perform(Graphics& g) override { g.fillPath(p); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<fillPath>(other); return o != nullptr && o->p == p; }
+		Rectangle<float> getDirtyArea() const override { return p.getBounds(); }
 		Path p;
 	};
 
@@ -2145,6 +2208,16 @@ struct ScriptedDrawActions
 			PathStrokeType s(thickness);
 			g.strokePath(p, s);
 		}
+
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawPath>(other); return o != nullptr && o->thickness == thickness && o->p == p; }
+
+		Rectangle<float> getDirtyArea() const override
+		{
+			Path stroked;
+			PathStrokeType(thickness).createStrokedPath(stroked, p);
+			return stroked.getBounds();
+		}
+
 		Path p;
 		float thickness;
 	};
@@ -2153,6 +2226,8 @@ struct ScriptedDrawActions
 	{
 		fillRect(Rectangle<float> area_) : area(area_) {};
 		void perform(Graphics& g) { g.fillRect(area); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<fillRect>(other); return o != nullptr && o->area == area; }
+		Rectangle<float> getDirtyArea() const override { return area; }
 		Rectangle<float> area;
 	};
 
@@ -2160,6 +2235,8 @@ struct ScriptedDrawActions
 	{
 		fillEllipse(Rectangle<float> area_) : area(area_) {};
 		void perform(Graphics& g) { g.fillEllipse(area); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<fillEllipse>(other); return o != nullptr && o->area == area; }
+		Rectangle<float> getDirtyArea() const override { return area; }
 		Rectangle<float> area;
 	};
 
@@ -2167,6 +2244,8 @@ struct ScriptedDrawActions
 	{
 		drawRect(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
 		void perform(Graphics& g) { g.drawRect(area, borderSize); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawRect>(other); return o != nullptr && o->area == area && o->borderSize == borderSize; }
+		Rectangle<float> getDirtyArea() const override { return area; }
 		Rectangle<float> area;
 		float borderSize;
 	};
@@ -2175,6 +2254,8 @@ struct ScriptedDrawActions
 	{
 		drawEllipse(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
 		void perform(Graphics& g) { g.drawEllipse(area, borderSize); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawEllipse>(other); return o != nullptr && o->area == area && o->borderSize == borderSize; }
+		Rectangle<float> getDirtyArea() const override { return area.expanded(borderSize * 0.5f); }
 		Rectangle<float> area;
 		float borderSize;
 	};
@@ -2184,6 +2265,8 @@ struct ScriptedDrawActions
 		fillRoundedRect(Rectangle<float> area_, float cornerSize_) :
 			area(area_), cornerSize(cornerSize_) {};
 		void perform(Graphics& g) { g.fillRoundedRectangle(area, cornerSize); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<fillRoundedRect>(other); return o != nullptr && o->area == area && o->cornerSize == cornerSize; }
+		Rectangle<float> getDirtyArea() const override { return area; }
 		Rectangle<float> area;
 		float cornerSize;
 	};
@@ -2193,6 +2276,14 @@ struct ScriptedDrawActions
 		drawRoundedRectangle(Rectangle<float> area_, float borderSize_, float cornerSize_) :
 			area(area_), borderSize(borderSize_), cornerSize(cornerSize_) {};
 		void perform(Graphics& g) { g.drawRoundedRectangle(area, cornerSize, borderSize); };
+
+		bool isEquivalent(const ActionBase* other) const override 
+		{ 
+			auto o = as<drawRoundedRectangle>(other); 
+			return o != nullptr && o->area == area && o->cornerSize == cornerSize && o->borderSize == borderSize;
+		}
+
+		Rectangle<float> getDirtyArea() const override { return area.expanded(borderSize * 0.5f); }
 		Rectangle<float> area;
 		float cornerSize, borderSize;
 	};
@@ -2212,6 +2303,9 @@ struct ScriptedDrawActions
 			//			g.drawImage(img, ri.getX(), ri.getY(), (int)(r.getWidth() / scaleFactor), (int)(r.getHeight() / scaleFactor), 0, yOffset, (int)img.getWidth(), (int)((double)img.getHeight()));
 		}
 
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawImageWithin>(other); return o != nullptr && o->img == img && o->r == r; }
+		Rectangle<float> getDirtyArea() const override { return r; }
+
 		Image img;
 		Rectangle<float> r;
 	};
@@ -2231,6 +2325,14 @@ struct ScriptedDrawActions
 //			g.drawImage(img, ri.getX(), ri.getY(), (int)(r.getWidth() / scaleFactor), (int)(r.getHeight() / scaleFactor), 0, yOffset, (int)img.getWidth(), (int)((double)img.getHeight()));
 		}
 
+		bool isEquivalent(const ActionBase* other) const override 
+		{ 
+			auto o = as<drawImage>(other); 
+			return o != nullptr && o->img == img && o->r == r && o->scaleFactor == scaleFactor && o->yOffset == yOffset;
+		}
+
+		Rectangle<float> getDirtyArea() const override { return r; }
+
 		Image img;
 		Rectangle<float> r;
 		float scaleFactor;
@@ -2242,6 +2344,8 @@ struct ScriptedDrawActions
 		drawHorizontalLine(int y_, float x1_, float x2_) :
 			y(y_), x1(x1_), x2(x2_) {};
 		void perform(Graphics& g) { g.drawHorizontalLine(y, x1, x2); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawHorizontalLine>(other); return o != nullptr && o->y == y && o->x1 == x1 && o->x2 == x2; }
+		Rectangle<float> getDirtyArea() const override { return { jmin(x1, x2), (float)y, std::abs(x2 - x1), 1.0f }; }
 		int y; float x1; float x2;
 	};
 
@@ -2250,6 +2354,7 @@ struct ScriptedDrawActions
 		setOpacity(float alpha_) :
 			alpha(alpha_) {};
 		void perform(Graphics& g) { g.setOpacity(alpha); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<setOpacity>(other); return o != nullptr && o->alpha == alpha; }
 		float alpha;
 	};
 
@@ -2258,6 +2363,19 @@ struct ScriptedDrawActions
 		drawLine(float x1_, float x2_, float y1_, float y2_, float lineThickness_):
 			x1(x1_), x2(x2_), y1(y1_), y2(y2_), lineThickness(lineThickness_) {};
 		void perform(Graphics& g) { g.drawLine(x1, x2, y1, y2, lineThickness); };
+
+		bool isEquivalent(const ActionBase* other) const override 
+		{ 
+			auto o = as<drawLine>(other); 
+			return o != nullptr && o->x1 == x1 && o->x2 == x2 && o->y1 == y1 && o->y2 == y2 && o->lineThickness == lineThickness;
+		}
+
+		// the argument order is (startX, startY, endX, endY)
+		Rectangle<float> getDirtyArea() const override
+		{
+			return Rectangle<float>(Point<float>(x1, x2), Point<float>(y1, y2)).expanded(lineThickness * 0.5f);
+		}
+
 		float x1, x2, y1, y2, lineThickness;
 	};
 
@@ -2265,6 +2383,7 @@ struct ScriptedDrawActions
 	{
 		setFont(Font f_) : f(f_) {};
 		void perform(Graphics& g) { g.setFont(f); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<setFont>(other); return o != nullptr && o->f == f; }
 		Font f;
 	};
 
@@ -2272,6 +2391,7 @@ struct ScriptedDrawActions
 	{
 		setGradientFill(ColourGradient grad_) : grad(grad_) {};
 		void perform(Graphics& g) { g.setGradientFill(grad); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<setGradientFill>(other); return o != nullptr && o->grad == grad; }
 		ColourGradient grad;
 	};
 
@@ -2279,6 +2399,10 @@ struct ScriptedDrawActions
 	{
 		drawText(const String& text_, Rectangle<float> area_, Justification j_=Justification::centred ) : text(text_), area(area_), j(j_) {};
 		void perform(Graphics& g) override { g.drawText(text, area, j); };
+
+		// The glyphs might exceed the area if the font is bigger, so a changed text causes a full repaint
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawText>(other); return o != nullptr && o->area == area && o->j == j && o->text == text; }
+
 		String text;
 		Rectangle<float> area;
 		Justification j;
@@ -2288,6 +2412,8 @@ struct ScriptedDrawActions
 	{
 		drawDropShadow(Rectangle<int> r_, DropShadow& shadow_) : r(r_), shadow(shadow_) {};
 		void perform(Graphics& g) override { shadow.drawForRectangle(g, r); };
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<drawDropShadow>(other); return o != nullptr && o->r == r && isSameShadow(o->shadow, shadow); }
+		Rectangle<float> getDirtyArea() const override { return r.translated(shadow.offset.x, shadow.offset.y).expanded(shadow.radius).getUnion(r).toFloat(); }
 		Rectangle<int> r;
 		DropShadow shadow;
 	};
@@ -2298,6 +2424,8 @@ struct ScriptedDrawActions
 
 		bool wantsCachedImage() const override { return true; };
 
+		bool isEquivalent(const ActionBase* other) const override { auto o = as<addDropShadowFromAlpha>(other); return o != nullptr && isSameShadow(o->shadow, shadow); }
+
 		void perform(Graphics& g) override
 		{
 			shadow.drawForImage(g, cachedImage);
@@ -2808,6 +2936,11 @@ hise::Modulator* ApiHelpers::ModuleHandler::addAndConnectToGlobalModulator(Chain
 				m = dynamic_cast<GlobalModulator*>(tMod);
 			}
 		}
+		else if (dynamic_cast<EnvelopeModulator*>(globalModulator) != nullptr)
+		{
+			auto eMod = addModule(c, GlobalEnvelopeModulator::getClassType().toString(), modName);
+			m = dynamic_cast<GlobalModulator*>(eMod);
+		}
 		else
 			throw String("Not a global modulator");
 
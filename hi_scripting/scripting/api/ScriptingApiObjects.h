@@ -709,6 +709,12 @@ public:
 		/** Adds and connects a receiving static time variant modulator for the given global modulator. */
 		var addStaticGlobalModulator(var chainIndex, var timeVariantMod, String modName);
 
+		/** Sets the number of samples per calculated value for the given modulation chain (1, 2, 4 or 8). */
+		void setModulatorChainControlRate(var chainIndex, int samplesPerValue);
+
+		/** Only uses one modulation value per sub block for the given modulation chain. */
+		void setModulatorChainConstantForBlock(var chainIndex, bool shouldBeConstant);
+
 		/** Returns a reference as Sampler or undefined if no Sampler. */
 		var asSampler();
 
@@ -721,6 +727,8 @@ public:
 
 	private:
 
+		ModulatorChain::ModChainWithBuffer* getModChainWithBuffer(var chainIndex);
+
 		ApiHelpers::ModuleHandler moduleHandler;
 
 		WeakReference<Processor> synth;
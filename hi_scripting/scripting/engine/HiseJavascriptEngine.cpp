@@ -516,6 +516,53 @@ struct HiseJavascriptEngine::RootObject::Scope
 			: var::undefined();
 	}
 
+	/** Same as findSymbolInParentScopes, but uses the slot cache of the calling expression.
+	*
+	*	The cached slot stores the scope depth in the upper and the property index in the lower 16 bits.
+	*	The scopes above that depth are still searched (they are usually the small function scopes and
+	*	might shadow the name), but the scope at the cached depth only compares the name at the slot.
+	*	The expression can be evaluated from multiple threads, so the slot is only read and written as a whole.
+	*/
+	var* findSymbolPointerInParentScopes(const Identifier& name, std::atomic<int>& cachedSlot) const
+	{
+		const int slot = cachedSlot.load(std::memory_order_relaxed);
+		const int cachedDepth = slot != -1 ? (slot >> 16) : -1;
+
+		int depth = 0;
+
+		for (const Scope* s = this; s != nullptr; s = s->parent, depth++)
+		{
+			if (depth == cachedDepth)
+			{
+				auto& properties = s->scope->getProperties();
+				const int cachedIndex = slot & 0xFFFF;
+
+				if (cachedIndex < properties.size() && properties.begin()[cachedIndex].name == name)
+					return &properties.begin()[cachedIndex].value;
+			}
+
+			int index = -1;
+
+			if (var* v = getPropertyPointer(s->scope, name, index))
+			{
+				if (depth < 0x7FFF && index < 0xFFFF)
+					cachedSlot.store((depth << 16) | index, std::memory_order_relaxed);
+
+				return v;
+			}
+		}
+
+		return nullptr;
+	}
+
+	var findSymbolInParentScopes(const Identifier& name, std::atomic<int>& cachedSlot) const
+	{
+		if (const var* v = findSymbolPointerInParentScopes(name, cachedSlot))
+			return *v;
+
+		return var::undefined();
+	}
+
 
 
 	bool findAndInvokeMethod(const Identifier& function, const var::NativeFunctionArgs& args, var& result) const;
@@ -368,6 +368,13 @@ public:
 		static Identifier getPrototypeIdentifier();
 		static var* getPropertyPointer(DynamicObject* o, const Identifier& i) noexcept;
 
+		/** Same as getPropertyPointer, but checks the slot at cachedIndex first and updates it after a lookup.
+		*
+		*	The result is always the same as with a full search (the name at the slot is compared),
+		*	so the cache index can be shared between different objects.
+		*/
+		static var* getPropertyPointer(DynamicObject* o, const Identifier& i, int& cachedIndex) noexcept;
+
 		bool updateCyclicReferenceList(ThreadData& data, const Identifier &id) override;
 
 		void prepareCycleReferenceCheck() override;
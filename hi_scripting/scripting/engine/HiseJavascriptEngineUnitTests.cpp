@@ -0,0 +1,216 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class HiseJavascriptEngineUnitTests : public UnitTest
+{
+public:
+
+	HiseJavascriptEngineUnitTests() :
+		UnitTest("Testing HiseScript lookups")
+	{
+
+	}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		bp = new BackendProcessor(nullptr, nullptr);
+		jp = new JavascriptMidiProcessor(bp, "scripter");
+
+		testPropertySlotsAfterDelete();
+		testPropertySlotsAfterInsert();
+		testRootSlotsAfterDelete();
+		testShadowedNames();
+		runBenchmark();
+
+		jp = nullptr;
+		bp = nullptr;
+	}
+
+private:
+
+	void execute(HiseJavascriptEngine& engine, const String& code)
+	{
+		auto r = engine.execute(code);
+		expect(r.wasOk(), r.getErrorMessage());
+	}
+
+	var evaluate(HiseJavascriptEngine& engine, const String& code)
+	{
+		Result r = Result::ok();
+		auto v = engine.evaluate(code, &r);
+		expect(r.wasOk(), r.getErrorMessage());
+		return v;
+	}
+
+	void testPropertySlotsAfterDelete()
+	{
+		beginTest("Testing cached property slots after removing a property");
+
+		HiseJavascriptEngine engine(jp);
+
+		execute(engine, "var o = {\"a\": 1, \"b\": 2, \"c\": 3}; var other = {\"c\": 30, \"b\": 20}; function getC(obj) { return obj.c; }");
+
+		expectEquals((int)evaluate(engine, "getC(o)"), 3);
+		expectEquals((int)evaluate(engine, "getC(other)"), 30);
+		expectEquals((int)evaluate(engine, "getC(o)"), 3);
+
+		auto o = evaluate(engine, "o");
+
+		o.getDynamicObject()->removeProperty("a");
+
+		expectEquals((int)evaluate(engine, "getC(o)"), 3, "slot moved after remove");
+
+		o.getDynamicObject()->removeProperty("b");
+
+		expectEquals((int)evaluate(engine, "getC(o)"), 3, "slot moved to 0");
+
+		o.getDynamicObject()->removeProperty("c");
+
+		expect(evaluate(engine, "getC(o)").isUndefined(), "removed property is still found");
+	}
+
+	void testPropertySlotsAfterInsert()
+	{
+		beginTest("Testing cached property slots after adding a property");
+
+		HiseJavascriptEngine engine(jp);
+
+		execute(engine, "var o = {\"x\": 1}; function getY(obj) { return obj.y; }");
+
+		expect(evaluate(engine, "getY(o)").isUndefined(), "missing property is found");
+
+		execute(engine, "o.y = 5;");
+		expectEquals((int)evaluate(engine, "getY(o)"), 5);
+
+		evaluate(engine, "o").getDynamicObject()->removeProperty("x");
+		execute(engine, "o.x = 7;");
+
+		expectEquals((int)evaluate(engine, "getY(o)"), 5, "slot moved after reinsertion");
+		expectEquals((int)evaluate(engine, "o.x"), 7);
+	}
+
+	void testRootSlotsAfterDelete()
+	{
+		beginTest("Testing cached root variable slots after removing a variable");
+
+		HiseJavascriptEngine engine(jp);
+
+		execute(engine, "var first = 1; var second = 2; var value = 3; function readValue() { return value; } function writeValue(v) { value = v; }");
+
+		expectEquals((int)evaluate(engine, "readValue()"), 3);
+
+		engine.getRootObject()->removeProperty("first");
+
+		expectEquals((int)evaluate(engine, "readValue()"), 3, "read after remove");
+
+		execute(engine, "writeValue(9);");
+		engine.getRootObject()->removeProperty("second");
+		execute(engine, "writeValue(10);");
+
+		expectEquals((int)evaluate(engine, "readValue()"), 10, "write after remove");
+		expectEquals((int)engine.getRootObject()->getProperty("value"), 10);
+	}
+
+	void testShadowedNames()
+	{
+		beginTest("Testing cached slots with shadowed names");
+
+		HiseJavascriptEngine engine(jp);
+
+		// The function scope of the caller is a parent scope of readValue(), so the parameter shadows the root variable
+		execute(engine, "var value = 3; function readValue() { return value; } function shadow(value) { return readValue(); }");
+
+		expectEquals((int)evaluate(engine, "readValue()"), 3);
+		expectEquals((int)evaluate(engine, "shadow(42)"), 42);
+		expectEquals((int)evaluate(engine, "readValue()"), 3);
+		expectEquals((int)evaluate(engine, "shadow(43)"), 43);
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking root variable lookups");
+
+		HiseJavascriptEngine engine(jp);
+
+		static constexpr int numVariables = 256;
+
+		String code;
+
+		for (int i = 0; i < numVariables; i++)
+			code << "var v" << String(i) << " = " << String(i) << ";\n";
+
+		code << "var i = 0; var sum = 0;\n";
+		code << "function readFirst() { for (i = 0; i < 100000; i++) sum = v0; }\n";
+		code << "function readLast() { for (i = 0; i < 100000; i++) sum = v" << String(numVariables - 1) << "; }\n";
+
+		execute(engine, code);
+
+		auto measure = [&](const String& call)
+		{
+			const double start = Time::getMillisecondCounterHiRes();
+			evaluate(engine, call);
+			return Time::getMillisecondCounterHiRes() - start;
+		};
+
+		measure("readFirst()");
+		measure("readLast()");
+
+		const double firstTime = measure("readFirst()");
+		const double lastTime = measure("readLast()");
+
+		expectEquals((int)evaluate(engine, "sum"), numVariables - 1);
+
+		String s;
+
+		s << "100000 lookups of the first of " << String(numVariables) << " root variables: " << String(firstTime, 2) << "ms, ";
+		s << "of the last: " << String(lastTime, 2) << "ms";
+
+		logMessage(s);
+	}
+
+	ScopedPointer<BackendProcessor> bp;
+	ScopedPointer<JavascriptMidiProcessor> jp;
+};
+
+static HiseJavascriptEngineUnitTests hiseJavascriptEngineUnitTests;
+
+#endif
@@ -209,6 +209,19 @@ int ApiClass::getConstantIndex(const Identifier &id) const
 	return -1;
 }
 
+int ApiClass::getConstantIndex(const Identifier &id, int& cachedIndex) const
+{
+	if (isPositiveAndBelow(cachedIndex, numConstants) && constantsToUse[cachedIndex].id == id)
+		return cachedIndex;
+
+	const int index = getConstantIndex(id);
+
+	if (index != -1)
+		cachedIndex = index;
+
+	return index;
+}
+
 Identifier ApiClass::getConstantName(int index) const
 {
 	if (index < numConstants)
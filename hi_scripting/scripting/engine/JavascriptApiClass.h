@@ -191,6 +191,9 @@ public:
     /** Return the index for the given name. */
 	int getConstantIndex(const Identifier &id) const;
 
+	/** Return the index for the given name, but checks the slot at cachedIndex first and updates it if the constant was found. */
+	int getConstantIndex(const Identifier &id, int& cachedIndex) const;
+
 	/** Returns the name for the constant as it is used in the scripting context. */
 	Identifier getConstantName(int index) const;
 
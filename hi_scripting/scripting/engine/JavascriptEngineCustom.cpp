@@ -139,7 +139,9 @@ struct HiseJavascriptEngine::RootObject::ConstObjectApiCall : public Expression
 
 	var getResult(const Scope& s) const override
 	{
-		if (!initialised)
+		// The function index is resolved for the first object and only looked up again if the const variable
+		// points to another object (so a call on the same object is just a pointer comparison).
+		if (!initialised || (objectPointer != nullptr && objectPointer->getObject() != object.get()))
 		{
 			initialised = true;
 
@@ -11,21 +11,14 @@ struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 {
 	UnqualifiedName(const CodeLocation& l, const Identifier& n, bool isFunction) noexcept : Expression(l), name(n), allowUnqualifiedDefinition(isFunction) {}
 
-	var getResult(const Scope& s) const override  { return s.findSymbolInParentScopes(name); }
+	var getResult(const Scope& s) const override  { return s.findSymbolInParentScopes(name, cachedSlot); }
 
 	void assign(const Scope& s, const var& newValue) const override
 	{
-		const Scope* currentScope = &s;
-		var* v = getPropertyPointer(currentScope->scope, name);
-
-		while (v == nullptr && currentScope->parent != nullptr)
-		{
-			currentScope = currentScope->parent;
-			v = getPropertyPointer(currentScope->scope, name);
-		}
+		var* v = s.findSymbolPointerInParentScopes(name, cachedSlot);
 
 		if (v == nullptr)
-			v = getPropertyPointer(currentScope->root, name);
+			v = getPropertyPointer(s.root, name);
 
 		if (v != nullptr)
 			*v = newValue;
@@ -33,7 +26,7 @@ struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 		{
 			if (allowUnqualifiedDefinition)
 			{
-				currentScope->root->setProperty(name, newValue);
+				s.root->setProperty(name, newValue);
 			}
 			else
 			{
@@ -48,6 +41,9 @@ struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 
 	JavascriptNamespace* ns = nullptr;
 	Identifier name;
+
+	// the scope depth and slot of the last successful lookup (see Scope::findSymbolPointerInParentScopes)
+	mutable std::atomic<int> cachedSlot { -1 };
 };
 
 
@@ -187,14 +183,24 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 		}
 
 		if (DynamicObject* o = p.getDynamicObject())
-			if (const var* v = getPropertyPointer(o, child))
+		{
+			int index = cachedIndex.load(std::memory_order_relaxed);
+
+			if (const var* v = getPropertyPointer(o, child, index))
+			{
+				cachedIndex.store(index, std::memory_order_relaxed);
 				return *v;
+			}
+		}
 
 		if (ConstScriptingObject* o = dynamic_cast<ConstScriptingObject*>(p.getObject()))
 		{
-			const int constantIndex = o->getConstantIndex(child);
+			int index = cachedConstantIndex.load(std::memory_order_relaxed);
+			const int constantIndex = o->getConstantIndex(child, index);
+
 			if (constantIndex != -1)
 			{
+				cachedConstantIndex.store(constantIndex, std::memory_order_relaxed);
 				return o->getConstantValue(constantIndex);
 			}
 		}
@@ -216,6 +222,11 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 
 	ExpPtr parent;
 	Identifier child;
+
+	// the slots of the last successful lookups. The expression can be evaluated from
+	// multiple threads, so they are copied to a local before the lookup.
+	mutable std::atomic<int> cachedIndex { -1 };
+	mutable std::atomic<int> cachedConstantIndex { -1 };
 };
 
 
@@ -520,6 +531,28 @@ var* HiseJavascriptEngine::RootObject::getPropertyPointer(DynamicObject* o, cons
 	return o->getProperties().getVarPointer(i);
 }
 
+var* HiseJavascriptEngine::RootObject::getPropertyPointer(DynamicObject* o, const Identifier& i, int& cachedIndex) noexcept
+{
+	auto& properties = o->getProperties();
+
+	const int numProperties = properties.size();
+	auto* values = properties.begin();
+
+	if (isPositiveAndBelow(cachedIndex, numProperties) && values[cachedIndex].name == i)
+		return &values[cachedIndex].value;
+
+	for (int index = 0; index < numProperties; index++)
+	{
+		if (values[index].name == i)
+		{
+			cachedIndex = index;
+			return &values[index].value;
+		}
+	}
+
+	return nullptr;
+}
+
 bool HiseJavascriptEngine::RootObject::Scope::findAndInvokeMethod(const Identifier& function, const var::NativeFunctionArgs& args, var& result) const
 {
 	DynamicObject* target = args.thisObject.getDynamicObject();
@@ -560,4 +593,4 @@ bool HiseJavascriptEngine::RootObject::Scope::invokeMidiCallback(const Identifie
 	return false;
 }
 
-} // namespace hise
\ No newline at end of file
+} // namespace hise
\ No newline at end of file
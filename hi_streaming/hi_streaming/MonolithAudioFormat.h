@@ -312,6 +312,12 @@ public:
     {
         return multiChannelSampleInformation[0][sampleIndex].length;
     }
+
+    /** Returns the monolith file that contains the given channel. */
+    File getMonolithFile(int channelIndex) const
+    {
+        return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+    }
     
     double getMonolithSampleRate(int sampleIndex) const
     {
@@ -370,6 +376,9 @@ public:
 		return sampleMapId == id;
 	}
 
+	/** Returns the sample map ID this monolith belongs to. */
+	const Identifier& getSampleMapId() const noexcept { return id; }
+
 	HlacMonolithInfo(const Array<File>& monolithicFiles_)
 	{
 		id = monolithicFiles_.getFirst().getFileNameWithoutExtension().replaceCharacter('_', '/');
@@ -409,6 +418,12 @@ public:
 		return (int64)jmax<int>(0, (int)multiChannelSampleInformation[0][sampleIndex].length);
 	}
 
+	/** Returns the monolith file that contains the given channel. */
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
+
 	double getMonolithSampleRate(int sampleIndex) const
 	{
 		return multiChannelSampleInformation[0][sampleIndex].sampleRate;
@@ -0,0 +1,463 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace SampleInterpolatorKernels
+{
+using SSEFloat = dsp::SIMDRegister<float>;
+
+static constexpr int NumLanes = (int)SSEFloat::SIMDNumElements;
+
+#define ALIGN_TO_REGISTER alignas(SSEFloat::SIMDRegisterSize)
+
+// The 256 bit helpers below use AVX2 integer instructions, so they must be guarded
+// exactly like the register width of the juce_dsp module
+#if JUCE_INTEL && defined(__AVX2__)
+static_assert(NumLanes == 8, "The AVX2 helpers expect 256 bit registers");
+#elif JUCE_INTEL
+static_assert(NumLanes == 4, "The SSE helpers expect 128 bit registers");
+#endif
+
+/** Unaligned loads and stores for the SIMD registers.
+*
+*	The gather functions create the register directly from the scalar values, going through an aligned
+*	array would stall the store forwarding on most CPUs.
+*/
+struct Vec
+{
+	static forcedinline SSEFloat load(const float* p) noexcept
+	{
+#if JUCE_INTEL && defined(__AVX2__)
+		return SSEFloat::fromNative(_mm256_loadu_ps(p));
+#elif JUCE_INTEL
+		return SSEFloat::fromNative(_mm_loadu_ps(p));
+#else
+		ALIGN_TO_REGISTER float d[NumLanes];
+		memcpy(d, p, sizeof(float) * NumLanes);
+		return SSEFloat::fromRawArray(d);
+#endif
+	}
+
+	static forcedinline SSEFloat load(const int16* p) noexcept
+	{
+#if JUCE_INTEL && defined(__AVX2__)
+		return SSEFloat::fromNative(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))));
+#elif JUCE_INTEL
+		const auto i = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+		return SSEFloat::fromNative(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(i, i), 16)));
+#else
+		ALIGN_TO_REGISTER float d[NumLanes];
+
+		for (int i = 0; i < NumLanes; i++)
+			d[i] = (float)p[i];
+
+		return SSEFloat::fromRawArray(d);
+#endif
+	}
+
+	template <typename SignalType> static forcedinline SSEFloat gather(const SignalType* in, const int* pos, int offset) noexcept
+	{
+#if JUCE_INTEL && defined(__AVX2__)
+		return SSEFloat::fromNative(_mm256_setr_ps((float)in[pos[0] + offset], (float)in[pos[1] + offset], (float)in[pos[2] + offset], (float)in[pos[3] + offset],
+												   (float)in[pos[4] + offset], (float)in[pos[5] + offset], (float)in[pos[6] + offset], (float)in[pos[7] + offset]));
+#elif JUCE_INTEL
+		return SSEFloat::fromNative(_mm_setr_ps((float)in[pos[0] + offset], (float)in[pos[1] + offset], (float)in[pos[2] + offset], (float)in[pos[3] + offset]));
+#else
+		ALIGN_TO_REGISTER float d[NumLanes];
+
+		for (int i = 0; i < NumLanes; i++)
+			d[i] = (float)in[pos[i] + offset];
+
+		return SSEFloat::fromRawArray(d);
+#endif
+	}
+
+	/** Returns the inclusive prefix sum of the lanes ([a, a + b, a + b + c, ...]). */
+	static forcedinline SSEFloat prefixSum(SSEFloat x) noexcept
+	{
+#if JUCE_INTEL && defined(__AVX2__)
+		auto v = x.value;
+		v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+		v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+
+		// add the last element of the lower half to the upper half
+		const auto lower = _mm256_permute2f128_ps(v, v, 0x08);
+		v = _mm256_add_ps(v, _mm256_shuffle_ps(lower, lower, 0xFF));
+
+		return SSEFloat::fromNative(v);
+#elif JUCE_INTEL
+		auto v = x.value;
+		v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+		v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+		return SSEFloat::fromNative(v);
+#else
+		ALIGN_TO_REGISTER float d[NumLanes];
+		x.copyToRawArray(d);
+
+		for (int i = 1; i < NumLanes; i++)
+			d[i] += d[i - 1];
+
+		return SSEFloat::fromRawArray(d);
+#endif
+	}
+
+	/** Writes the integer part of the (positive) positions into pos and returns the fractional part. */
+	static forcedinline SSEFloat split(SSEFloat positions, int* pos) noexcept
+	{
+#if JUCE_INTEL && defined(__AVX2__)
+		const auto i = _mm256_cvttps_epi32(positions.value);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pos), i);
+		return positions - SSEFloat::fromNative(_mm256_cvtepi32_ps(i));
+#elif JUCE_INTEL
+		const auto i = _mm_cvttps_epi32(positions.value);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pos), i);
+		return positions - SSEFloat::fromNative(_mm_cvtepi32_ps(i));
+#else
+		ALIGN_TO_REGISTER float d[NumLanes];
+		positions.copyToRawArray(d);
+
+		for (int i = 0; i < NumLanes; i++)
+		{
+			pos[i] = (int)d[i];
+			d[i] -= (float)pos[i];
+		}
+
+		return SSEFloat::fromRawArray(d);
+#endif
+	}
+
+	static forcedinline void store(float* p, SSEFloat v) noexcept
+	{
+#if JUCE_INTEL && defined(__AVX2__)
+		_mm256_storeu_ps(p, v.value);
+#elif JUCE_INTEL
+		_mm_storeu_ps(p, v.value);
+#else
+		ALIGN_TO_REGISTER float d[NumLanes];
+		v.copyToRawArray(d);
+		memcpy(p, d, sizeof(float) * NumLanes);
+#endif
+	}
+};
+
+/** Each kernel supplies a scalar version that works on a window of converted samples (used for the edges)
+*	and a chunk version that calculates NumLanes samples at once.
+*/
+struct LinearKernel
+{
+	static constexpr int NumBefore = 0;
+	static constexpr int NumAfter = 1;
+
+	static forcedinline float processWindow(const float* w, float alpha) noexcept
+	{
+		return w[0] + alpha * (w[1] - w[0]);
+	}
+
+	template <typename SignalType> static forcedinline void processChunk(const SignalType* in, const int* pos, SSEFloat t, float* out) noexcept
+	{
+		const auto a = Vec::gather(in, pos, 0);
+		const auto b = Vec::gather(in, pos, 1);
+
+		Vec::store(out, a + t * (b - a));
+	}
+};
+
+struct CubicKernel
+{
+	static constexpr int NumBefore = 1;
+	static constexpr int NumAfter = 2;
+
+	static forcedinline float processWindow(const float* w, float alpha) noexcept
+	{
+		const float a = w[-1];
+		const float b = w[0];
+		const float c = w[1];
+		const float d = w[2];
+
+		return b + 0.5f * alpha * (c - a + alpha * (2.0f * a - 5.0f * b + 4.0f * c - d + alpha * (3.0f * (b - c) + d - a)));
+	}
+
+	template <typename SignalType> static forcedinline void processChunk(const SignalType* in, const int* pos, SSEFloat t, float* out) noexcept
+	{
+		const auto a = Vec::gather(in, pos, -1);
+		const auto b = Vec::gather(in, pos, 0);
+		const auto c = Vec::gather(in, pos, 1);
+		const auto d = Vec::gather(in, pos, 2);
+
+		const auto c1 = c - a;
+		const auto c2 = a * 2.0f - b * 5.0f + c * 4.0f - d;
+		const auto c3 = (b - c) * 3.0f + d - a;
+
+		Vec::store(out, b + t * 0.5f * (c1 + t * (c2 + t * c3)));
+	}
+};
+
+struct SincKernel
+{
+	static constexpr int NumTaps = 8;
+	static constexpr int NumBefore = NumTaps / 2 - 1;
+	static constexpr int NumAfter = NumTaps / 2;
+	static constexpr int NumPhases = 256;
+
+	static_assert(NumTaps % NumLanes == 0, "The number of taps must be a multiple of the SIMD register size");
+
+	/** The windowed sinc coefficients for NumPhases + 1 fractional positions (the last row is used for interpolating the phases). */
+	struct Table
+	{
+		Table()
+		{
+			for (int p = 0; p <= NumPhases; p++)
+			{
+				const double alpha = (double)p / (double)NumPhases;
+				double sum = 0.0;
+
+				for (int k = 0; k < NumTaps; k++)
+				{
+					const double x = (double)(k - NumBefore) - alpha;
+					const double u = x / (double)(NumTaps / 2);
+
+					const double window = std::abs(u) >= 1.0 ? 0.0 : (0.42 + 0.5 * std::cos(double_Pi * u) + 0.08 * std::cos(2.0 * double_Pi * u));
+					const double sinc = x == 0.0 ? 1.0 : std::sin(double_Pi * x) / (double_Pi * x);
+
+					coefficients[p][k] = (float)(window * sinc);
+					sum += window * sinc;
+				}
+
+				// Normalise every phase so that there is no DC ripple
+				for (int k = 0; k < NumTaps; k++)
+					coefficients[p][k] = (float)((double)coefficients[p][k] / sum);
+			}
+		}
+
+		alignas(32) float coefficients[NumPhases + 1][NumTaps];
+	};
+
+	static const Table& getTable()
+	{
+		static const Table table;
+		return table;
+	}
+
+	/** Calculates the dot product of the interpolated phase coefficients and the NumTaps samples starting at s. */
+	template <typename SignalType> static forcedinline float dot(const Table& table, const SignalType* s, int index, float phaseFraction) noexcept
+	{
+		jassert(isPositiveAndBelow(index, NumPhases + 1));
+
+		// alpha can be rounded up to 1.0f
+		index = jmin<int>(index, NumPhases - 1);
+
+		const auto frac = SSEFloat::expand(phaseFraction);
+
+		auto sum = SSEFloat::expand(0.0f);
+
+		for (int k = 0; k < NumTaps; k += NumLanes)
+		{
+			const auto c0 = SSEFloat::fromRawArray(table.coefficients[index] + k);
+			const auto c1 = SSEFloat::fromRawArray(table.coefficients[index + 1] + k);
+
+			sum += (c0 + frac * (c1 - c0)) * Vec::load(s + k);
+		}
+
+		return sum.sum();
+	}
+
+	static forcedinline float processWindow(const float* w, float alpha) noexcept
+	{
+		const float phase = alpha * (float)NumPhases;
+		const int index = (int)phase;
+
+		return dot(getTable(), w - NumBefore, index, phase - (float)index);
+	}
+
+	template <typename SignalType> static forcedinline void processChunk(const SignalType* in, const int* pos, SSEFloat t, float* out) noexcept
+	{
+		const auto& table = getTable();
+
+		int index[NumLanes];
+		ALIGN_TO_REGISTER float frac[NumLanes];
+
+		Vec::split(t * (float)NumPhases, index).copyToRawArray(frac);
+
+		for (int i = 0; i < NumLanes; i++)
+			out[i] = dot(table, in + pos[i] - NumBefore, index[i], frac[i]);
+	}
+};
+
+/** Converts the window around the position into floats and repeats the first sample if the window starts before minIndex. */
+template <class KernelType, typename SignalType> static forcedinline float processClamped(const SignalType* in, int pos, float alpha, int minIndex) noexcept
+{
+	float w[KernelType::NumBefore + KernelType::NumAfter + 1];
+
+	for (int k = -KernelType::NumBefore; k <= KernelType::NumAfter; k++)
+		w[k + KernelType::NumBefore] = (float)in[jmax<int>(minIndex, pos + k)];
+
+	return KernelType::processWindow(w + KernelType::NumBefore, alpha);
+}
+
+template <class KernelType, typename SignalType> static void render(const SignalType* inL, const SignalType* inR, int numSamplesBefore, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples) noexcept
+{
+	float indexInBufferFloat = (float)indexInBuffer;
+	const float uptimeDeltaFloat = (float)uptimeDelta;
+	const int minIndex = -numSamplesBefore;
+
+	int i = 0;
+
+	// The first windows might start before the available data
+	for (; i < numSamples; i++)
+	{
+		const int pos = (int)indexInBufferFloat;
+
+		if (pos - KernelType::NumBefore >= minIndex)
+			break;
+
+		const float alpha = indexInBufferFloat - (float)pos;
+
+		outL[i] = processClamped<KernelType>(inL, pos, alpha, minIndex);
+
+		if (inR != nullptr)
+			outR[i] = processClamped<KernelType>(inR, pos, alpha, minIndex);
+
+		indexInBufferFloat += pitchData != nullptr ? pitchData[i] : uptimeDeltaFloat;
+	}
+
+	int pos[NumLanes];
+
+	ALIGN_TO_REGISTER static const float laneIndexes[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+	static_assert(NumLanes <= 8, "Too many lanes");
+
+	const auto laneOffsets = SSEFloat::fromRawArray(laneIndexes) * uptimeDeltaFloat;
+
+	for (; i + NumLanes <= numSamples; i += NumLanes)
+	{
+		SSEFloat t;
+
+		if (pitchData != nullptr)
+		{
+			jassert(pitchData[i] <= (float)MAX_SAMPLER_PITCH);
+
+			const auto pitchValues = Vec::load(pitchData + i);
+			const auto sum = Vec::prefixSum(pitchValues);
+
+			t = Vec::split(SSEFloat::expand(indexInBufferFloat) + sum - pitchValues, pos);
+			indexInBufferFloat += sum.get(NumLanes - 1);
+		}
+		else
+		{
+			t = Vec::split(SSEFloat::expand(indexInBufferFloat) + laneOffsets, pos);
+			indexInBufferFloat += uptimeDeltaFloat * (float)NumLanes;
+		}
+
+		KernelType::processChunk(inL, pos, t, outL + i);
+
+		if (inR != nullptr)
+			KernelType::processChunk(inR, pos, t, outR + i);
+	}
+
+	for (; i < numSamples; i++)
+	{
+		const int p = (int)indexInBufferFloat;
+		const float a = indexInBufferFloat - (float)p;
+
+		outL[i] = processClamped<KernelType>(inL, p, a, minIndex);
+
+		if (inR != nullptr)
+			outR[i] = processClamped<KernelType>(inR, p, a, minIndex);
+
+		indexInBufferFloat += pitchData != nullptr ? pitchData[i] : uptimeDeltaFloat;
+	}
+}
+
+#undef ALIGN_TO_REGISTER
+
+static_assert(SincKernel::NumBefore <= SampleInterpolator::MaxNumSamplesBefore &&
+			  CubicKernel::NumBefore <= SampleInterpolator::MaxNumSamplesBefore, "Increase MaxNumSamplesBefore");
+
+} // namespace SampleInterpolatorKernels
+
+int SampleInterpolator::getNumSamplesBefore(Mode m) noexcept
+{
+	using namespace SampleInterpolatorKernels;
+
+	switch (m)
+	{
+	case Cubic: return CubicKernel::NumBefore;
+	case Sinc:	return SincKernel::NumBefore;
+	default:	return LinearKernel::NumBefore;
+	}
+}
+
+int SampleInterpolator::getNumSamplesAfter(Mode m) noexcept
+{
+	using namespace SampleInterpolatorKernels;
+
+	switch (m)
+	{
+	case Cubic: return CubicKernel::NumAfter;
+	case Sinc:	return SincKernel::NumAfter;
+	default:	return LinearKernel::NumAfter;
+	}
+}
+
+void SampleInterpolator::initialise()
+{
+	SampleInterpolatorKernels::SincKernel::getTable();
+}
+
+template <typename SignalType, bool isFloat> void SampleInterpolator::process(Mode m, const SignalType* inL, const SignalType* inR, int numSamplesBefore, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	using namespace SampleInterpolatorKernels;
+
+	jassert(getNumSamplesAfter(m) - 1 <= NumPaddingSamples);
+
+	switch (m)
+	{
+	case Cubic: render<CubicKernel>(inL, inR, numSamplesBefore, pitchData, outL, outR, indexInBuffer, uptimeDelta, numSamples); break;
+	case Sinc:	render<SincKernel>(inL, inR, numSamplesBefore, pitchData, outL, outR, indexInBuffer, uptimeDelta, numSamples); break;
+	default:	render<LinearKernel>(inL, inR, numSamplesBefore, pitchData, outL, outR, indexInBuffer, uptimeDelta, numSamples); break;
+	}
+
+	if (!isFloat)
+	{
+		constexpr float gainFactor = 1.0f / (float)INT16_MAX;
+
+		FloatVectorOperations::multiply(outL, gainFactor, numSamples);
+
+		if (inR != nullptr)
+			FloatVectorOperations::multiply(outR, gainFactor, numSamples);
+	}
+}
+
+template void SampleInterpolator::process<float, true>(Mode, const float*, const float*, int, const float*, float*, float*, double, double, int);
+template void SampleInterpolator::process<int16, false>(Mode, const int16*, const int16*, int, const float*, float*, float*, double, double, int);
+
+} // namespace hise
@@ -0,0 +1,95 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef SAMPLEINTERPOLATOR_H_INCLUDED
+#define SAMPLEINTERPOLATOR_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** The resampling kernels that are used by the StreamingSamplerVoice.
+*
+*	The kernels calculate the read positions for a few samples at once and then interpolate them using
+*	the SIMDRegister class of the JUCE dsp module (so it will use SSE / NEON if available and fall back
+*	to scalar operations otherwise).
+*
+*	The higher order modes need a few samples around the read position. The voice makes sure that there
+*	are enough samples after the read position, but the samples before the start of the voice buffer might
+*	not be available (eg. right after the streaming buffers were swapped). In this case the kernel repeats
+*	the first available sample.
+*/
+class SampleInterpolator
+{
+public:
+
+	/** The interpolation algorithm. */
+	enum Mode
+	{
+		Linear = 0, ///< two point linear interpolation (the default)
+		Cubic, ///< four point Catmull-Rom spline (more CPU than the linear interpolation)
+		Sinc, ///< eight point Blackman windowed sinc (the most expensive mode)
+		numModes
+	};
+
+	/** The amount of samples that the voice buffers need in addition to the linear interpolation. */
+	static constexpr int NumPaddingSamples = 8;
+
+	/** The largest number of samples before the read position that any mode reads. */
+	static constexpr int MaxNumSamplesBefore = 3;
+
+	/** Returns the number of samples before the read position that the given mode reads. */
+	static int getNumSamplesBefore(Mode m) noexcept;
+
+	/** Returns the number of samples after the read position that the given mode reads (1 for linear interpolation). */
+	static int getNumSamplesAfter(Mode m) noexcept;
+
+	/** Calculates the lookup tables. Call this on a non-realtime thread before using the Sinc mode. */
+	static void initialise();
+
+	/** Resamples the given data.
+	*
+	*	@param m			the interpolation algorithm.
+	*	@param inL			the data of the left channel starting at the voice position.
+	*	@param inR			the data of the right channel or nullptr if the data is mono (outR will not be used then).
+	*	@param numSamplesBefore the number of valid samples before inL / inR.
+	*	@param pitchData	the pitch values for every sample (already offset to the start sample) or nullptr for a constant pitch.
+	*	@param outL			the left output pointer (will be overwritten).
+	*	@param outR			the right output pointer (will be overwritten).
+	*	@param indexInBuffer the (fractional) read position of the first sample.
+	*	@param uptimeDelta	the constant pitch factor that is used if pitchData is nullptr.
+	*	@param numSamples	the number of samples to calculate.
+	*/
+	template <typename SignalType, bool isFloat> static void process(Mode m, const SignalType* inL, const SignalType* inR, int numSamplesBefore, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples);
+};
+
+} // namespace hise
+
+#endif  // SAMPLEINTERPOLATOR_H_INCLUDED
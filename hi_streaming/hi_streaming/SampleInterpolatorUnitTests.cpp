@@ -0,0 +1,334 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class SampleInterpolatorUnitTests : public UnitTest
+{
+public:
+
+	SampleInterpolatorUnitTests() :
+		UnitTest("Testing sample interpolation")
+	{
+
+	}
+
+	void runTest() override
+	{
+		SampleInterpolator::initialise();
+
+		testLinearMatchesScalarVersion();
+		testIntegerPositions();
+		testSineAccuracy();
+		testBlockStart();
+		runBenchmark();
+	}
+
+private:
+
+	static constexpr int NumInputSamples = 512 * MAX_SAMPLER_PITCH + SampleInterpolator::NumPaddingSamples + 8;
+	static constexpr int BlockSize = 512;
+
+	/** The scalar linear interpolation that was used before the SIMD kernels. */
+	template <typename SignalType, bool isFloat> static void referenceLinear(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples)
+	{
+		constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+
+		float indexInBufferFloat = (float)indexInBuffer;
+		const float uptimeDeltaFloat = (float)uptimeDelta;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBufferFloat);
+			const float alpha = indexInBufferFloat - (float)pos;
+			const float invAlpha = 1.0f - alpha;
+
+			outL[i] = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha) * gainFactor;
+			outR[i] = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha) * gainFactor;
+
+			indexInBufferFloat += pitchData != nullptr ? pitchData[i] : uptimeDeltaFloat;
+		}
+	}
+
+	/** A linear interpolation with double precision read positions. */
+	template <typename SignalType, bool isFloat> static void exactLinear(const SignalType* in, const float* pitchData, float* out, double indexInBuffer, double uptimeDelta, int numSamples)
+	{
+		constexpr double gainFactor = isFloat ? 1.0 : (1.0 / (double)INT16_MAX);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBuffer);
+			const double alpha = indexInBuffer - (double)pos;
+
+			out[i] = (float)(((double)in[pos] * (1.0 - alpha) + (double)in[pos + 1] * alpha) * gainFactor);
+
+			indexInBuffer += pitchData != nullptr ? (double)pitchData[i] : uptimeDelta;
+		}
+	}
+
+	void fillWithNoise(AudioSampleBuffer& b, HeapBlock<int16>& intData)
+	{
+		Random r(1234);
+
+		b.setSize(2, NumInputSamples);
+		intData.calloc(2 * NumInputSamples);
+
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < NumInputSamples; i++)
+			{
+				const float v = r.nextFloat() * 2.0f - 1.0f;
+
+				b.setSample(c, i, v);
+				intData[c * NumInputSamples + i] = (int16)(v * (float)INT16_MAX);
+			}
+		}
+	}
+
+	void fillPitchData(float* pitchData, float basePitch)
+	{
+		Random r(42);
+
+		for (int i = 0; i < BlockSize; i++)
+			pitchData[i] = basePitch * (0.5f + r.nextFloat());
+	}
+
+	static float getMaxError(const float* a, const float* b, int numSamples)
+	{
+		float maxError = 0.0f;
+
+		for (int i = 0; i < numSamples; i++)
+			maxError = jmax<float>(maxError, std::abs(a[i] - b[i]));
+
+		return maxError;
+	}
+
+	void testLinearMatchesScalarVersion()
+	{
+		beginTest("Testing linear mode against the scalar version");
+
+		AudioSampleBuffer input;
+		HeapBlock<int16> intData;
+		fillWithNoise(input, intData);
+
+		AudioSampleBuffer exact(1, BlockSize);
+		AudioSampleBuffer scalar(2, BlockSize);
+		AudioSampleBuffer actual(2, BlockSize);
+
+		HeapBlock<float> pitchData;
+		pitchData.calloc(BlockSize);
+
+		const double pitchValues[] = { 0.25, 0.5, 1.0, 1.37, 2.0, 7.9 };
+
+		for (auto pitch : pitchValues)
+		{
+			fillPitchData(pitchData, (float)pitch);
+
+			for (int usePitchData = 0; usePitchData < 2; usePitchData++)
+			{
+				const float* pd = usePitchData ? pitchData.get() : nullptr;
+				const double startAlpha = 0.31;
+
+				// The SIMD version accumulates the read position once per register instead of once per sample,
+				// so it's not bit-identical to the scalar version, but it must not drift further from the exact position.
+				exactLinear<float, true>(input.getReadPointer(0), pd, exact.getWritePointer(0), startAlpha, pitch, BlockSize);
+				referenceLinear<float, true>(input.getReadPointer(0), input.getReadPointer(1), pd, scalar.getWritePointer(0), scalar.getWritePointer(1), startAlpha, pitch, BlockSize);
+				SampleInterpolator::process<float, true>(SampleInterpolator::Linear, input.getReadPointer(0), input.getReadPointer(1), 0, pd, actual.getWritePointer(0), actual.getWritePointer(1), startAlpha, pitch, BlockSize);
+
+				const float scalarError = getMaxError(exact.getReadPointer(0), scalar.getReadPointer(0), BlockSize);
+				const float floatError = getMaxError(exact.getReadPointer(0), actual.getReadPointer(0), BlockSize);
+
+				expect(floatError <= jmax<float>(scalarError, 1e-5f), "float mismatch at pitch " + String(pitch) + ": " + String(floatError) + ", scalar: " + String(scalarError));
+
+				const int16* il = intData.get();
+				const int16* ir = intData.get() + NumInputSamples;
+
+				exactLinear<int16, false>(il, pd, exact.getWritePointer(0), startAlpha, pitch, BlockSize);
+				referenceLinear<int16, false>(il, ir, pd, scalar.getWritePointer(0), scalar.getWritePointer(1), startAlpha, pitch, BlockSize);
+				SampleInterpolator::process<int16, false>(SampleInterpolator::Linear, il, ir, 0, pd, actual.getWritePointer(0), actual.getWritePointer(1), startAlpha, pitch, BlockSize);
+
+				const float intScalarError = getMaxError(exact.getReadPointer(0), scalar.getReadPointer(0), BlockSize);
+				const float intError = getMaxError(exact.getReadPointer(0), actual.getReadPointer(0), BlockSize);
+
+				expect(intError <= jmax<float>(intScalarError, 1e-5f), "int16 mismatch at pitch " + String(pitch) + ": " + String(intError) + ", scalar: " + String(intScalarError));
+			}
+		}
+	}
+
+	void testIntegerPositions()
+	{
+		beginTest("Testing integer read positions");
+
+		AudioSampleBuffer input;
+		HeapBlock<int16> intData;
+		fillWithNoise(input, intData);
+
+		AudioSampleBuffer output(2, BlockSize);
+
+		const int offset = 4;
+
+		for (int m = 0; m < SampleInterpolator::numModes; m++)
+		{
+			auto mode = (SampleInterpolator::Mode)m;
+
+			SampleInterpolator::process<float, true>(mode, input.getReadPointer(0, offset), input.getReadPointer(1, offset), offset, nullptr, output.getWritePointer(0), output.getWritePointer(1), 0.0, 1.0, BlockSize);
+
+			for (int c = 0; c < 2; c++)
+				expect(getMaxError(input.getReadPointer(c, offset), output.getReadPointer(c), BlockSize) < 1e-5f, "Mode " + String(m) + " doesn't reproduce the input");
+		}
+	}
+
+	void testSineAccuracy()
+	{
+		beginTest("Testing the accuracy of the interpolation modes");
+
+		const double frequency = 0.05;
+		const double pitch = 0.73;
+		const int offset = 4;
+
+		AudioSampleBuffer input(2, NumInputSamples);
+
+		for (int i = 0; i < NumInputSamples; i++)
+		{
+			const float v = (float)std::sin(2.0 * double_Pi * frequency * (double)(i - offset));
+			input.setSample(0, i, v);
+			input.setSample(1, i, v);
+		}
+
+		AudioSampleBuffer output(2, BlockSize);
+		HeapBlock<float> expected;
+		expected.calloc(BlockSize);
+
+		for (int i = 0; i < BlockSize; i++)
+			expected[i] = (float)std::sin(2.0 * double_Pi * frequency * ((double)i * pitch));
+
+		float errors[SampleInterpolator::numModes];
+
+		for (int m = 0; m < SampleInterpolator::numModes; m++)
+		{
+			SampleInterpolator::process<float, true>((SampleInterpolator::Mode)m, input.getReadPointer(0, offset), input.getReadPointer(1, offset), offset, nullptr, output.getWritePointer(0), output.getWritePointer(1), 0.0, pitch, BlockSize);
+
+			errors[m] = getMaxError(expected, output.getReadPointer(0), BlockSize);
+
+			logMessage("Max error for mode " + String(m) + ": " + String(Decibels::gainToDecibels(errors[m]), 1) + " dB");
+		}
+
+		expect(errors[SampleInterpolator::Cubic] < errors[SampleInterpolator::Linear], "Cubic interpolation must be more accurate than linear");
+		expect(errors[SampleInterpolator::Sinc] < errors[SampleInterpolator::Cubic], "Sinc interpolation must be more accurate than cubic");
+	}
+
+	void testBlockStart()
+	{
+		beginTest("Testing the repetition of the first sample");
+
+		AudioSampleBuffer input(2, NumInputSamples);
+		input.clear();
+		FloatVectorOperations::fill(input.getWritePointer(0), 0.5f, NumInputSamples);
+		FloatVectorOperations::fill(input.getWritePointer(1), -0.5f, NumInputSamples);
+
+		AudioSampleBuffer output(2, BlockSize);
+
+		for (int m = 0; m < SampleInterpolator::numModes; m++)
+		{
+			SampleInterpolator::process<float, true>((SampleInterpolator::Mode)m, input.getReadPointer(0), input.getReadPointer(1), 0, nullptr, output.getWritePointer(0), output.getWritePointer(1), 0.5, 0.9, BlockSize);
+
+			for (int i = 0; i < BlockSize; i++)
+			{
+				expectWithinAbsoluteError(output.getSample(0, i), 0.5f, 1e-5f);
+				expectWithinAbsoluteError(output.getSample(1, i), -0.5f, 1e-5f);
+			}
+		}
+	}
+
+	template <typename SignalType, bool isFloat> double measure(int mode, const SignalType* l, const SignalType* r, const float* pitchData, AudioSampleBuffer& output, double pitch)
+	{
+		const int numRuns = 2000;
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numRuns; i++)
+		{
+			if (mode < 0)
+				referenceLinear<SignalType, isFloat>(l, r, pitchData, output.getWritePointer(0), output.getWritePointer(1), 0.25, pitch, BlockSize);
+			else
+				SampleInterpolator::process<SignalType, isFloat>((SampleInterpolator::Mode)mode, l, r, SampleInterpolator::getNumSamplesBefore(SampleInterpolator::Sinc), pitchData, output.getWritePointer(0), output.getWritePointer(1), 0.25, pitch, BlockSize);
+		}
+
+		auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		return seconds * 1000000000.0 / (double)(numRuns * BlockSize);
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking interpolation modes");
+
+		AudioSampleBuffer input;
+		HeapBlock<int16> intData;
+		fillWithNoise(input, intData);
+
+		AudioSampleBuffer output(2, BlockSize);
+
+		HeapBlock<float> pitchData;
+		pitchData.calloc(BlockSize);
+		fillPitchData(pitchData, 1.0f);
+
+		const int offset = SampleInterpolator::getNumSamplesBefore(SampleInterpolator::Sinc);
+
+		const float* fl = input.getReadPointer(0, offset);
+		const float* fr = input.getReadPointer(1, offset);
+		const int16* il = intData.get() + offset;
+		const int16* ir = intData.get() + NumInputSamples + offset;
+
+		const char* names[] = { "Scalar linear", "Linear", "Cubic", "Sinc" };
+
+		for (int m = -1; m < SampleInterpolator::numModes; m++)
+		{
+			String s;
+
+			s << names[m + 1] << ": ";
+			s << "float " << String(measure<float, true>(m, fl, fr, nullptr, output, 1.37), 2) << "ns, ";
+			s << "float + pitch mod " << String(measure<float, true>(m, fl, fr, pitchData, output, 1.37), 2) << "ns, ";
+			s << "int16 " << String(measure<int16, false>(m, il, ir, nullptr, output, 1.37), 2) << "ns (per stereo sample)";
+
+			logMessage(s);
+		}
+	}
+};
+
+static SampleInterpolatorUnitTests sampleInterpolatorUnitTests;
+
+#endif
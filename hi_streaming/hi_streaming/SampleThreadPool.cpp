@@ -33,8 +33,63 @@
 namespace hise { using namespace juce;
 
 
+class SampleThreadPool::StreamingThread : public Thread
+{
+public:
+
+	StreamingThread(SampleThreadPool& parent_, int index_) :
+		Thread("Sample Streaming Thread " + String(index_ + 1)),
+		parent(parent_),
+		index(index_)
+	{};
+
+	void run() override;
+
+	/** Processes a batch of jobs from the given queue. Returns false if the queue was empty or is processed by another thread. */
+	bool processQueue(int queueIndex);
+
+	std::atomic<bool> idle { true };
+
+	std::atomic<double> diskUsage { 0.0 };
+
+private:
+
+	SampleThreadPool& parent;
+	const int index;
+
+	int64 startTime = 0, endTime = 0;
+};
+
 struct SampleThreadPool::Pimpl
 {
+	/** The maximum number of jobs that are taken from a streaming queue and sorted by their deadline. */
+	static constexpr int MaxJobsPerBatch = 32;
+
+	/** The number of jobs that fit into a streaming queue without allocating. */
+	static constexpr int StreamingQueueSize = 256;
+
+	struct StreamingQueue
+	{
+		StreamingQueue() :
+			jobs(StreamingQueueSize),
+			token(jobs)
+		{};
+
+		/** Adds the job without allocating. Returns false if the queue is full. */
+		bool tryToAdd(Job* j)
+		{
+			// The token is shared by all producers, so it needs to be locked
+			SpinLock::ScopedLockType sl(producerLock);
+			return jobs.try_enqueue(token, WeakReference<Job>(j));
+		}
+
+		moodycamel::ConcurrentQueue<WeakReference<Job>> jobs;
+		moodycamel::ProducerToken token;
+		SpinLock producerLock;
+
+		std::atomic<bool> busy { false };
+	};
+
 	Pimpl() :
 		jobQueue(2048),
 		currentlyExecutedJob(nullptr),
@@ -50,6 +105,35 @@ struct SampleThreadPool::Pimpl
 		}
 	}
 
+	int getQueueIndex(int64 key) const noexcept
+	{
+		// Most keys are hash codes or pointer values, so mix the bits before using the modulo
+		auto x = (uint64)key;
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+
+		return (int)(x % (uint64)streamingQueues.size());
+	}
+
+	void notifyStreamingThread(int queueIndex)
+	{
+		const int numThreads = streamingThreads.size();
+
+		// Wake up the first idle thread, starting with the one that owns the queue.
+		// If every thread is busy, they will pick up the job before going to sleep.
+		for (int i = 0; i < numThreads; i++)
+		{
+			auto t = streamingThreads.getUnchecked((queueIndex + i) % numThreads);
+
+			if (t->idle.load())
+			{
+				t->notify();
+				return;
+			}
+		}
+	}
+
 	Atomic<int> counter;
 
 	std::atomic<double> diskUsage;
@@ -57,22 +141,52 @@ struct SampleThreadPool::Pimpl
 	int64 startTime, endTime;
 
 	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
+	SpinLock producerLock;
 
 	std::atomic<Job*> currentlyExecutedJob;
 
+	OwnedArray<StreamingQueue> streamingQueues;
+
+	OwnedArray<StreamingThread> streamingThreads;
+
+	/** The streaming threads hold a read lock while they process their jobs, so the sample loading thread can
+	*	acquire the write lock to make sure that no reading operation is pending while it executes other jobs.
+	*/
+	ReadWriteLock streamingLock;
+
 	static const String errorMessage;
 };
 
-SampleThreadPool::SampleThreadPool() :
+SampleThreadPool::SampleThreadPool(int numStreamingThreads) :
 	Thread("Sample Loading Thread"),
 	pimpl(new Pimpl())
 {
+	if (numStreamingThreads > 0)
+	{
+		// Use more queues than threads so that jobs with different keys don't block each other
+		const int numQueues = numStreamingThreads * 4;
+
+		for (int i = 0; i < numQueues; i++)
+			pimpl->streamingQueues.add(new Pimpl::StreamingQueue());
+
+		for (int i = 0; i < numStreamingThreads; i++)
+		{
+			pimpl->streamingThreads.add(new StreamingThread(*this, i));
+			pimpl->streamingThreads.getLast()->startThread(9);
+		}
+	}
 
 	startThread(9);
 }
 
 SampleThreadPool::~SampleThreadPool()
 {
+	for (auto t : pimpl->streamingThreads)
+		t->signalThreadShouldExit();
+
+	for (auto t : pimpl->streamingThreads)
+		t->stopThread(300);
+
 	pimpl = nullptr;
 
 	stopThread(300);
@@ -80,7 +194,17 @@ SampleThreadPool::~SampleThreadPool()
 
 double SampleThreadPool::getDiskUsage() const noexcept
 {
-	return pimpl->diskUsage.load();
+	double usage = pimpl->diskUsage.load();
+
+	for (auto t : pimpl->streamingThreads)
+		usage = jmax<double>(usage, t->diskUsage.load());
+
+	return usage;
+}
+
+int SampleThreadPool::getNumStreamingThreads() const noexcept
+{
+	return pimpl->streamingThreads.size();
 }
 
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
@@ -97,21 +221,82 @@ void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 	}
 #endif
 
-
 	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
 
+	if (!pimpl->streamingThreads.isEmpty())
+	{
+		const int64 key = jobToAdd->getStreamingQueueKey();
+
+		if (key != 0)
+		{
+			const int queueIndex = pimpl->getQueueIndex(key);
+
+			if (pimpl->streamingQueues.getUnchecked(queueIndex)->tryToAdd(jobToAdd))
+			{
+				pimpl->notifyStreamingThread(queueIndex);
+				return;
+			}
+
+			// If the streaming queue is full, the job is passed to the sample loading thread. It executes
+			// its jobs with the write lock, so this doesn't interfere with the streaming threads.
+		}
+	}
+
+	bool added;
+
+	{
+		// The job queue only supports a single producer, but jobs can be added from multiple audio worker threads
+		SpinLock::ScopedLockType sl(pimpl->producerLock);
+		added = pimpl->jobQueue.try_enqueue(jobToAdd);
+	}
+
+	if (!added)
+	{
+		// Both queues are full and this might be called from the audio thread, so growing the queue is not an option.
+		// The job is dropped and the voice will play the old content of its buffer until the next request.
+		jassertfalse;
+		jobToAdd->queued.store(false);
+		--pimpl->counter;
+		return;
+	}
 
 	notify();
 }
 
 void SampleThreadPool::run()
 {
+	// The jobs are taken from the queue in batches so that the reads of the whole batch can be
+	// prefetched before the first job is executed (jobs that haven't finished stay at the front).
+	WeakReference<Job> batch[Pimpl::MaxJobsPerBatch];
+	int numJobsInBatch = 0;
+	int batchIndex = 0;
+
 	while (!threadShouldExit())
 	{
-		if (WeakReference<Job>* next = pimpl->jobQueue.peek())
+		if (batchIndex == numJobsInBatch)
 		{
-			Job* j = next->get();
+			for (int i = 0; i < numJobsInBatch; i++)
+				batch[i] = nullptr;
+
+			numJobsInBatch = 0;
+			batchIndex = 0;
+
+			while (numJobsInBatch < Pimpl::MaxJobsPerBatch && pimpl->jobQueue.try_dequeue(batch[numJobsInBatch]))
+				numJobsInBatch++;
+
+			if (pimpl->streamingThreads.isEmpty())
+			{
+				for (int i = 0; i < numJobsInBatch; i++)
+				{
+					if (auto j = batch[i].get())
+						j->prefetch();
+				}
+			}
+		}
+
+		if (batchIndex < numJobsInBatch)
+		{
+			Job* j = batch[batchIndex].get();
 
 #if ENABLE_CPU_MEASUREMENT
 
@@ -127,13 +312,23 @@ void SampleThreadPool::run()
 
 				j->running.store(true);
 				
-				Job::JobStatus status = j->runJob();
+				Job::JobStatus status;
+				
+				if (pimpl->streamingThreads.isEmpty())
+				{
+					status = j->runJob();
+				}
+				else
+				{
+					ScopedWriteLock sl(pimpl->streamingLock);
+					status = j->runJob();
+				}
 
 				j->running.store(false);
 
 				if (status == Job::jobHasFinished)
 				{
-					pimpl->jobQueue.pop();
+					batchIndex++;
 					j->queued.store(false);
 					--pimpl->counter;
 				}
@@ -142,7 +337,7 @@ void SampleThreadPool::run()
 			}
 			else
 			{
-				pimpl->jobQueue.pop();
+				batchIndex++;
 			}
 
 #if ENABLE_CPU_MEASUREMENT
@@ -168,6 +363,118 @@ void SampleThreadPool::run()
 	}
 }
 
+void SampleThreadPool::StreamingThread::run()
+{
+	while (!threadShouldExit())
+	{
+		idle.store(false);
+
+		const int numQueues = parent.pimpl->streamingQueues.size();
+		bool didSomething = false;
+
+		// Start with the queues that this thread owns, then help out with the others
+		for (int i = 0; i < numQueues; i++)
+			didSomething |= processQueue((index + i) % numQueues);
+
+		if (!didSomething)
+		{
+			idle.store(true);
+
+			// Check again after setting the idle flag so that a job that was added in the meantime
+			// doesn't have to wait for the timeout (queues that are busy will be rescanned by their thread).
+			bool queuesAreEmpty = true;
+
+			for (auto q : parent.pimpl->streamingQueues)
+				queuesAreEmpty &= (q->busy.load() || q->jobs.size_approx() == 0);
+
+			if (queuesAreEmpty)
+				wait(500);
+		}
+	}
+}
+
+bool SampleThreadPool::StreamingThread::processQueue(int queueIndex)
+{
+	auto pimpl = parent.pimpl.get();
+	auto q = pimpl->streamingQueues.getUnchecked(queueIndex);
+
+	if (q->busy.exchange(true))
+		return false;
+
+	WeakReference<Job> batch[Pimpl::MaxJobsPerBatch];
+	Job* jobs[Pimpl::MaxJobsPerBatch];
+
+	const int numDequeued = (int)q->jobs.try_dequeue_bulk(batch, Pimpl::MaxJobsPerBatch);
+	int numJobs = 0;
+
+	for (int i = 0; i < numDequeued; i++)
+	{
+		if (auto j = batch[i].get())
+			jobs[numJobs++] = j;
+	}
+
+	if (numJobs == 0)
+	{
+		q->busy.store(false);
+		return numDequeued != 0;
+	}
+
+	std::sort(jobs, jobs + numJobs, [](const Job* first, const Job* second)
+	{
+		return first->getDeadline() < second->getDeadline();
+	});
+
+#if ENABLE_CPU_MEASUREMENT
+	const int64 lastEndTime = endTime;
+	startTime = Time::getHighResolutionTicks();
+#endif
+
+	{
+		ScopedReadLock sl(pimpl->streamingLock);
+
+		for (int i = 0; i < numJobs; i++)
+			jobs[i]->prefetch();
+
+		for (int i = 0; i < numJobs; i++)
+		{
+			Job* j = jobs[i];
+
+			j->currentThread.store(this);
+
+			j->running.store(true);
+
+			const Job::JobStatus status = j->runJob();
+
+			j->running.store(false);
+
+			if (status == Job::jobHasFinished)
+			{
+				j->queued.store(false);
+				--pimpl->counter;
+			}
+			else if (!q->tryToAdd(j))
+			{
+				// This is not the audio thread, so the queue is allowed to grow here
+				SpinLock::ScopedLockType sl(q->producerLock);
+				q->jobs.enqueue(q->token, WeakReference<Job>(j));
+			}
+		}
+	}
+
+#if ENABLE_CPU_MEASUREMENT
+	endTime = Time::getHighResolutionTicks();
+
+	const int64 idleTime = lastEndTime != 0 ? startTime - lastEndTime : 0;
+	const int64 busyTime = endTime - startTime;
+
+	diskUsage.store((double)busyTime / (double)jmax<int64>(1, idleTime + busyTime));
+#endif
+
+	q->busy.store(false);
+
+	return true;
+}
+
 const String SampleThreadPool::Pimpl::errorMessage("HDD overflow");
 
-} // namespace hise
\ No newline at end of file
+} // namespace hise
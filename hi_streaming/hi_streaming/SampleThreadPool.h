@@ -35,11 +35,30 @@
 
 namespace hise { using namespace juce;
 
+/** Set this to the number of additional threads that are used for streaming.
+*
+*	If this is zero, every job will be executed by the sample loading thread (like it used to be).
+*	Otherwise, jobs that return a streaming queue key are distributed across this many worker threads.
+*/
+#ifndef HISE_NUM_STREAMING_THREADS
+#define HISE_NUM_STREAMING_THREADS 0
+#endif
+
+/** The background thread pool that handles the sample streaming and all loading tasks.
+*
+*	It runs every job on the sample loading thread, except for jobs that return a streaming queue key
+*	if there are streaming threads available. These jobs will be sorted into multiple queues (one per
+*	monolith file or sample file) that can be processed by any streaming thread in parallel, but a single
+*	queue is never processed by two threads at the same time (so readers can be shared within a queue).
+*
+*	Within a queue, the job with the earliest deadline gets executed first, so voices that are about to
+*	run out of buffered samples are served before the others.
+*/
 class SampleThreadPool : public Thread
 {
 public:
 
-	SampleThreadPool();
+	SampleThreadPool(int numStreamingThreads=HISE_NUM_STREAMING_THREADS);
 
 	~SampleThreadPool();
 	
@@ -52,8 +71,12 @@ public:
 			name(name_),
 			queued(false),
 			running(false),
-			shouldStop(false)
-		{};
+			shouldStop(false),
+			deadline(0)
+		{
+			// Create the shared pointer for the weak references here so that adding the job doesn't allocate
+			masterReference.getSharedPointer(this);
+		};
         
         virtual ~Job() { masterReference.clear(); }
 
@@ -65,6 +88,28 @@ public:
 
 		virtual JobStatus runJob() = 0;
 
+		/** Override this and return a non-zero key if the job can be executed by a streaming thread.
+		*
+		*	All jobs with the same key will be put into the same queue, so use a key that identifies the
+		*	file resource the job is reading from. The default returns zero, which means that the job will
+		*	always be executed by the sample loading thread.
+		*/
+		virtual int64 getStreamingQueueKey() const { return 0; }
+
+		/** Override this and tell the OS which data will be read by this job.
+		*
+		*	The streaming threads (or the sample loading thread if there are no streaming threads) call this for
+		*	every job of a batch before executing them, so the reads of all jobs can be in flight at the same time.
+		*	This must not block.
+		*/
+		virtual void prefetch() {}
+
+		/** Returns the time (in high resolution ticks) when the job must be finished. */
+		int64 getDeadline() const noexcept { return deadline.load(); }
+
+		/** Sets the deadline for the job. Jobs with an earlier deadline will be executed first. */
+		void setDeadline(int64 newDeadline) noexcept { deadline.store(newDeadline); }
+
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
 
 		void signalJobShouldExit() { shouldStop.store(true); }
@@ -90,6 +135,8 @@ public:
 
 		std::atomic<bool> shouldStop;
 
+		std::atomic<int64> deadline;
+
 		std::atomic<Thread*> currentThread;
 
 		const String name;
@@ -99,12 +146,19 @@ public:
 
 	void addJob(Job* jobToAdd, bool unused);
 
+	/** Returns the number of streaming threads (excluding the sample loading thread). */
+	int getNumStreamingThreads() const noexcept;
+
 	void run() override;
 
 	struct Pimpl;
 
 	ScopedPointer<Pimpl> pimpl;
 
+private:
+
+	class StreamingThread;
+
 };
 
 typedef SampleThreadPool::Job SampleThreadPoolJob;
@@ -62,6 +62,180 @@ bool StreamingHelpers::preloadSample(StreamingSamplerSound * s, const int preloa
 	}
 }
 
+class ParallelSamplePreloader::Job : public ThreadPoolJob
+{
+public:
+
+	Job(ParallelSamplePreloader& parent_) :
+		ThreadPoolJob("Sample Preloader"),
+		parent(parent_)
+	{}
+
+	JobStatus runJob() override
+	{
+		while (!shouldExit() && parent.preloadNextGroup())
+			;
+
+		return jobHasFinished;
+	}
+
+private:
+
+	ParallelSamplePreloader& parent;
+};
+
+ParallelSamplePreloader::ParallelSamplePreloader(ThreadPool* poolToUse) :
+	pool(poolToUse)
+{
+}
+
+ParallelSamplePreloader::~ParallelSamplePreloader()
+{
+}
+
+void ParallelSamplePreloader::addSound(StreamingSamplerSound* s)
+{
+	jassert(s != nullptr);
+
+	const auto key = s->getStreamingQueueKey();
+
+	if (!groupIndexes.contains(key))
+	{
+		groupIndexes.set(key, groups.size());
+		groups.add(new Array<StreamingSamplerSound*>());
+	}
+
+	groups[groupIndexes[key]]->add(s);
+}
+
+bool ParallelSamplePreloader::preload(int preloadSize, Thread* threadToCheck, double& progress, String& errorMessage)
+{
+	struct OffsetSorter
+	{
+		static int compareElements(StreamingSamplerSound* first, StreamingSamplerSound* second)
+		{
+			const auto o1 = first->getMonolithOffset();
+			const auto o2 = second->getMonolithOffset();
+
+			if (o1 != o2)
+				return o1 < o2 ? -1 : 1;
+
+			// Use the address for sounds with the same offset so that duplicates are next to each other
+			return first < second ? -1 : (first > second ? 1 : 0);
+		}
+	};
+
+	OffsetSorter sorter;
+
+	numSounds = 0;
+
+	for (auto g : groups)
+	{
+		g->sort(sorter);
+
+		// A sound might have been added more than once if it's shared between multiple samples
+		for (int i = g->size() - 1; i > 0; i--)
+		{
+			if (g->getUnchecked(i) == g->getUnchecked(i - 1))
+				g->remove(i);
+		}
+
+		numSounds += g->size();
+	}
+
+	currentPreloadSize = preloadSize;
+	currentThreadToCheck = threadToCheck;
+	callingThread = Thread::getCurrentThreadId();
+	currentProgress = &progress;
+
+	nextGroup.store(0);
+	numPreloaded.store(0);
+	cancelled.store(false);
+
+	OwnedArray<Job> jobs;
+
+	if (pool != nullptr)
+	{
+		for (int i = 0; i < jmin(pool->getNumThreads(), groups.size() - 1); i++)
+		{
+			jobs.add(new Job(*this));
+			pool->addJob(jobs.getLast(), false);
+		}
+	}
+
+	while (preloadNextGroup())
+		;
+
+	// The jobs might still load their last group
+	for (auto j : jobs)
+	{
+		while (!pool->waitForJobToFinish(j, 10))
+		{
+			updateProgress();
+
+			if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+				cancelled.store(true);
+		}
+	}
+
+	jobs.clear();
+
+	currentProgress = nullptr;
+	currentThreadToCheck = nullptr;
+
+	if (firstError.isNotEmpty())
+	{
+		errorMessage = firstError;
+		return false;
+	}
+
+	return !shouldCancel();
+}
+
+bool ParallelSamplePreloader::preloadNextGroup()
+{
+	const int groupIndex = nextGroup.fetch_add(1);
+
+	if (groupIndex >= groups.size())
+		return false;
+
+	for (auto s : *groups[groupIndex])
+	{
+		if (shouldCancel())
+			return false;
+
+		String errorMessage;
+
+		if (!StreamingHelpers::preloadSample(s, currentPreloadSize, errorMessage))
+		{
+			ScopedLock sl(errorLock);
+
+			if (firstError.isEmpty())
+				firstError = errorMessage;
+
+			cancelled.store(true);
+			return false;
+		}
+
+		++numPreloaded;
+		updateProgress();
+	}
+
+	return true;
+}
+
+bool ParallelSamplePreloader::shouldCancel() const
+{
+	return cancelled.load() || (currentThreadToCheck != nullptr && currentThreadToCheck->threadShouldExit());
+}
+
+void ParallelSamplePreloader::updateProgress()
+{
+	// Only the calling thread writes the progress value
+	if (currentProgress != nullptr && Thread::getCurrentThreadId() == callingThread)
+		*currentProgress = (double)numPreloaded.load() / (double)jmax(1, numSounds);
+}
+
 hise::StreamingHelpers::BasicMappingData StreamingHelpers::getBasicMappingDataFromSample(const ValueTree& sampleData)
 {
 	BasicMappingData data;
@@ -59,6 +59,68 @@ struct StreamingHelpers
 	static BasicMappingData getBasicMappingDataFromSample(const ValueTree& sampleData);
 };
 
+/** Preloads a list of sounds using multiple threads.
+*
+*	The sounds are grouped by their streaming queue key, so all sounds that are read from the same file
+*	(or the same monolith channel file) end up in the same group. The sounds of a group are sorted by their
+*	monolith offset and preloaded one after another by the same thread, so the file access stays sequential 
+*	and a reader is never used by two threads at the same time.
+*
+*	The thread that calls preload() loads groups too and the other groups are loaded by the threads of the
+*	given ThreadPool, so without a pool it behaves like a simple loop.
+*/
+class ParallelSamplePreloader
+{
+public:
+
+	/** Creates a preloader that uses the threads of the given pool (can be nullptr) in addition to the calling thread. */
+	ParallelSamplePreloader(ThreadPool* poolToUse);
+	~ParallelSamplePreloader();
+
+	/** Adds a sound to the list. Sounds that are added more than once will only be preloaded once. */
+	void addSound(StreamingSamplerSound* s);
+
+	/** Preloads all sounds that were added and returns when they are loaded.
+	*
+	*	@param preloadSize		the preload size that will be passed to StreamingSamplerSound::setPreloadSize().
+	*	@param threadToCheck	the preloading will be cancelled if threadShouldExit() of this thread returns true.
+	*	@param progress			this will be set to the preloading progress (only the calling thread writes to it).
+	*	@param errorMessage		if a sound couldn't be loaded, this will contain the error message.
+	*	@returns false if the preloading was cancelled or a sound couldn't be loaded.
+	*/
+	bool preload(int preloadSize, Thread* threadToCheck, double& progress, String& errorMessage);
+
+private:
+
+	class Job;
+
+	/** Preloads the next group that wasn't picked up by another thread. Returns false if there was no group left. */
+	bool preloadNextGroup();
+
+	bool shouldCancel() const;
+	void updateProgress();
+
+	ThreadPool* pool;
+
+	OwnedArray<Array<StreamingSamplerSound*>> groups;
+	HashMap<int64, int> groupIndexes;
+	int numSounds = 0;
+
+	int currentPreloadSize = 0;
+	Thread* currentThreadToCheck = nullptr;
+	Thread::ThreadID callingThread = nullptr;
+	double* currentProgress = nullptr;
+
+	std::atomic<int> nextGroup = { 0 };
+	std::atomic<int> numPreloaded = { 0 };
+	std::atomic<bool> cancelled = { false };
+
+	CriticalSection errorLock;
+	String firstError;
+
+	JUCE_DECLARE_NON_COPYABLE(ParallelSamplePreloader);
+};
+
 
 
 
@@ -95,7 +157,8 @@ public:
 
 private:
 
-	int numOpenFileHandles = 0;
+	// The sounds might be preloaded by multiple threads (see ParallelSamplePreloader)
+	std::atomic<int> numOpenFileHandles = { 0 };
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingSamplerSoundPool);
 };
@@ -151,6 +214,19 @@ struct StereoChannelData
 // which is not the smartest thing to do, but it comes to good use for debugging.
 #define USE_BACKGROUND_THREAD 1
 
+// If this is enabled, the thread that executes the streaming jobs tells the OS which parts of the memory mapped HLAC
+// files are read next before it executes a batch of jobs (madvise() on macOS / Linux, PrefetchVirtualMemory() on Windows 8+).
+// Samples that are read through a buffered file stream (eg. WAV / AIFF) are not affected and rely on the OS read-ahead.
+#ifndef USE_STREAMING_PREFETCH
+#define USE_STREAMING_PREFETCH 1
+#endif
+
+// The maximum number of threads that preload the samples when the preload size changes or a sample map is loaded
+// (including the sample loading thread). Set this to 1 to preload everything on the sample loading thread.
+#ifndef HISE_NUM_PRELOAD_THREADS
+#define HISE_NUM_PRELOAD_THREADS 4
+#endif
+
 // If the streaming background thread is blocked, it will kill the voice to exit gracefully.
 #define KILL_VOICES_WHEN_STREAMING_IS_BLOCKED 1
 
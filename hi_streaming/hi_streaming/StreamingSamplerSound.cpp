@@ -625,6 +625,21 @@ void StreamingSamplerSound::fillSampleBuffer(hlac::HiseSampleBuffer &sampleBuffe
 	}
 };
 
+void StreamingSamplerSound::prefetch(int samplesToRead, int uptime) const
+{
+	if (!fileReader.isUsed())
+		return;
+
+	const int startInFile = uptime + (int)sampleStart;
+	const int numSamples = jmin<int>(samplesToRead, (int)sampleEnd - startInFile);
+
+	// The preload buffer is already in memory
+	if (numSamples <= 0 || startInFile + numSamples < internalPreloadSize)
+		return;
+
+	fileReader.prefetch(startInFile + (int)monolithOffset, numSamples);
+}
+
 void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime, int offsetInBuffer/*=0*/) const
 {
 	jassert(uptime + samplesToCopy <= sampleEnd);
@@ -712,6 +727,7 @@ void StreamingSamplerSound::FileReader::setFile(const String &fileName)
 		fileFormatSupportsMemoryReading = fileExtension.contains("wav") || fileExtension.contains("aif");// || fileExtension.contains("hlac");
 
 		hashCode = loadedFile.hashCode64();
+		streamingQueueKey = hashCode != 0 ? hashCode : 1;
 	}
 	else
 	{
@@ -802,6 +818,10 @@ void StreamingSamplerSound::FileReader::openFileHandles(NotificationType notifyP
 
 		ScopedWriteLock sl(fileAccessLock);
 
+		// Another streaming thread might have opened the file while we were waiting for the lock
+		if (fileHandlesOpen)
+			return;
+
 		fileHandlesOpen = true;
 
 		memoryReader = nullptr;
@@ -944,6 +964,18 @@ void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buf
 }
 
 
+void StreamingSamplerSound::FileReader::prefetch(int readerPosition, int numSamples)
+{
+	// The file handles will be opened by the read operation
+	if (!fileHandlesOpen)
+		return;
+
+	ScopedReadLock sl(fileAccessLock);
+
+	if (auto hlacReader = dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get()))
+		hlacReader->prefetch(readerPosition, numSamples);
+}
+
 float StreamingSamplerSound::FileReader::calculatePeakValue()
 {
 #if USE_FRONTEND
@@ -995,6 +1027,8 @@ void StreamingSamplerSound::FileReader::setMonolithicInfo(MonolithInfoToUse* inf
 	hashCode = monolithicName.hashCode64();
 
 	monolithicChannelIndex = channelIndex;
+
+	streamingQueueKey = (int64)reinterpret_cast<pointer_sized_int>(info) + (int64)channelIndex;
 }
 
 } // namespace hise
\ No newline at end of file
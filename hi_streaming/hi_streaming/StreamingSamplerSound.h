@@ -210,8 +210,12 @@ public:
 
 	int64 getMonolithOffset() const { return fileReader.getMonolithOffset(); }
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
+	File getMonolithFile() const { return fileReader.getMonolithFile(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
+	/** Returns the key for the streaming queue that is used by SampleLoaders that play this sound. */
+	int64 getStreamingQueueKey() const noexcept { return fileReader.getStreamingQueueKey(); }
+
 	// ==============================================================================================================================================
 
 	String getFileName(bool getFullPath = false) const;
@@ -301,6 +305,13 @@ private:
 		void checkFileReference();
 		int64 getHashCode() { return hashCode; };
 
+		/** Returns a key that identifies the reader resource of this file.
+		*
+		*	All samples of a monolith channel file share the same reader, so they return the same key
+		*	and will be streamed from the same queue.
+		*/
+		int64 getStreamingQueueKey() const noexcept { return streamingQueueKey; }
+
 		/** Refreshes the information about the file (if it is missing, if it supports memory-mapping). */
 		void refreshFileInformation();
 
@@ -312,6 +323,9 @@ private:
 		/** Encapsulates all reading operations. It will use the best available reader type and opens the file handle if it is not open yet. */
 		void readFromDisk(hlac::HiseSampleBuffer &buffer, int startSample, int numSamples, int readerPosition, bool useMemoryMappedReader);
 
+		/** Tells the OS that the given range will be read soon. This only has an effect for memory mapped HLAC files. */
+		void prefetch(int readerPosition, int numSamples);
+
 		/** Call this method if you want to close the file handle. If voices are playing, it won't close it. */
 		void closeFileHandles(NotificationType notifyPool = sendNotification);
 
@@ -354,6 +368,16 @@ private:
 			return 0;
 		}
 
+		File getMonolithFile() const
+		{
+			if (monolithicInfo != nullptr)
+			{
+				return monolithicInfo->getMonolithFile(monolithicChannelIndex);
+			}
+
+			return File();
+		}
+
 		int64 getSampleLength() const
 		{
 			return sampleLength;
@@ -404,6 +428,8 @@ private:
 
 		int64 hashCode;
 
+		int64 streamingQueueKey = 1;
+
 		StreamingSamplerSound *sound;
 
 		ScopedPointer<MemoryMappedAudioFormatReader> memoryReader;
@@ -432,6 +458,12 @@ private:
 	*/
 	void fillSampleBuffer(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime) const;
 
+	/** Prefetches the samples that will be read by the next fillSampleBuffer() call with the same arguments.
+	*
+	*	This ignores loops (the loop area is most likely still in memory anyway).
+	*/
+	void prefetch(int samplesToRead, int uptime) const;
+
 	// used to wrap the read process for looping
 	void fillInternal(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime, int offsetInBuffer = 0) const;
 
@@ -122,6 +122,10 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 
 	entireSampleIsLoaded = s->isEntireSampleLoaded();
 
+	// We don't know how long the preload buffer will last, so the first read is the most urgent one
+	lastSwapTicks = Time::getHighResolutionTicks();
+	setDeadline(lastSwapTicks);
+
 	if (!entireSampleIsLoaded)
 	{
 		// The other buffer will be filled on the next free thread pool slot
@@ -198,13 +202,17 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 		const int indexBeforeWrap = jmax<int>(0, (int)(readIndexDouble));
 		const int numSamplesInFirstBuffer = localReadBuffer->getNumSamples() - indexBeforeWrap;
 
+		// Copy a few samples before the read position too so that the higher order interpolation modes have their history
+		const int numSamplesBefore = jmin<int>(indexBeforeWrap, SampleInterpolator::MaxNumSamplesBefore);
+		const int copyStart = indexBeforeWrap - numSamplesBefore;
+
 		voiceBuffer.setUseOneMap(localReadBuffer->useOneMap);
 
 		jassert(numSamplesInFirstBuffer >= 0);
 
 		// Reset the offset so that the first one will go through
 		auto existingOffset = localReadBuffer->getNormaliseMap(0).getOffset();
-		auto offsetInBuffer = indexBeforeWrap % COMPRESSION_BLOCK_SIZE;
+		auto offsetInBuffer = copyStart % COMPRESSION_BLOCK_SIZE;
 
 		voiceBuffer.clearNormalisation({});
 
@@ -213,13 +221,13 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 		if(!localReadBuffer->useOneMap)
 			voiceBuffer.getNormaliseMap(1).setOffset(localReadBuffer->getNormaliseMap(1).getOffset());
 
-		if (numSamplesInFirstBuffer > 0)
+		if (numSamplesInFirstBuffer + numSamplesBefore > 0)
 		{
-			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, 0, indexBeforeWrap, numSamplesInFirstBuffer);
+			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, 0, copyStart, numSamplesInFirstBuffer + numSamplesBefore);
 		}
 
-		const int offset = numSamplesInFirstBuffer;
-		const int numSamplesAvailableInSecondBuffer = localWriteBuffer->getNumSamples() - offset;
+		const int offset = numSamplesInFirstBuffer + numSamplesBefore;
+		const int numSamplesAvailableInSecondBuffer = localWriteBuffer->getNumSamples() - numSamplesInFirstBuffer;
 
 		if ((numSamplesAvailableInSecondBuffer > 0) && (numSamplesAvailableInSecondBuffer <= localWriteBuffer->getNumSamples()))
 		{
@@ -249,7 +257,7 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 		StereoChannelData returnData;
 
 		returnData.b = &voiceBuffer;
-		returnData.offsetInBuffer = 0;
+		returnData.offsetInBuffer = numSamplesBefore;
 
 
 		
@@ -307,6 +315,11 @@ bool SampleLoader::advanceReadIndex(double uptime)
 			positionInSampleFile += getNumSamplesForStreamingBuffers();
 			readIndexDouble = uptime - lastSwapPosition;
 
+			// The new read buffer will be consumed about as fast as the last one
+			const int64 now = Time::getHighResolutionTicks();
+			setDeadline(now + (now - lastSwapTicks));
+			lastSwapTicks = now;
+
 			swapBuffers();
 			const bool queueIsFree = requestNewData();
 
@@ -389,6 +402,28 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 	return SampleThreadPoolJob::JobStatus::jobHasFinished;
 }
 
+int64 SampleLoader::getStreamingQueueKey() const
+{
+	if (auto s = sound.get())
+		return s->getStreamingQueueKey();
+
+	return 1;
+}
+
+void SampleLoader::prefetch()
+{
+#if USE_STREAMING_PREFETCH
+	if (cancelled || writeBufferIsBeingFilled)
+		return;
+
+	if (auto localSound = sound.get())
+	{
+		if (localSound->hasEnoughSamplesForBlock(positionInSampleFile))
+			localSound->prefetch(getNumSamplesForStreamingBuffers(), positionInSampleFile);
+	}
+#endif
+}
+
 size_t SampleLoader::getActualStreamingBufferSize() const
 {
 	return b1.getNumSamples() * 2 * 2;
@@ -574,108 +609,6 @@ struct Helpers
 #endif
 
 
-template <typename SignalType, bool isFloat> void interpolateMonoSamples(const SignalType* inL, const SignalType* unusedIn, const float* pitchData, float* outL, float* unusedOut, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
-{
-	ignoreUnused(unusedIn, unusedOut);
-
-	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
-
-	if (pitchData != nullptr)
-	{
-		pitchData += startSample;
-
-		float indexInBufferFloat = (float)indexInBuffer;
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-
-			outL[i] = l * gainFactor;
-
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
-
-			indexInBufferFloat += pitchData[i];
-		}
-	}
-	else
-	{
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
-
-		while (numSamples > 0)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-
-			*outL++ = l * gainFactor;
-
-			indexInBufferFloat += uptimeDeltaFloat;
-
-			numSamples--;
-		}
-	}
-}
-
-template <typename SignalType, bool isFloat> void interpolateStereoSamples(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
-{
-	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
-
-	if (pitchData != nullptr)
-	{
-		pitchData += startSample;
-
-		float indexInBufferFloat = (float)indexInBuffer;
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			outL[i] = l * gainFactor;
-			outR[i] = r * gainFactor;
-
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
-
-			indexInBufferFloat += pitchData[i];
-		}
-	}
-	else
-	{
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
-
-		while (numSamples > 0)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			*outL++ = l * gainFactor;
-			*outR++ = r * gainFactor;
-
-			indexInBufferFloat += uptimeDeltaFloat;
-
-			numSamples--;
-		}
-	}
-}
-
-
-
 void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int startSample, int numSamples)
 {
 	const StreamingSamplerSound *sound = loader.getLoadedSound();
@@ -695,8 +628,14 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 		jassert(tempVoiceBuffer != nullptr);
 
+		// The higher order interpolation modes need a few more samples after the last read position
+		const int numExtraSamples = SampleInterpolator::getNumSamplesAfter(interpolationMode) - 1;
+
 		// Copy the not resampled values into the voice buffer.
-		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha);
+		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha + (double)numExtraSamples);
+
+		const int numSamplesBefore = jmin<int>(data.offsetInBuffer, SampleInterpolator::getNumSamplesBefore(interpolationMode));
+		const float* pitchDataForBlock = pitchData != nullptr ? pitchData + startSample : nullptr;
 
 		float* outL = outputBuffer.getWritePointer(0, startSample);
 		float* outR = outputBuffer.getWritePointer(1, startSample);
@@ -715,7 +654,7 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 			const float* const inL = static_cast<const float*>(data.b->getReadPointer(0, data.offsetInBuffer));
 			const float* const inR = static_cast<const float*>(data.b->getReadPointer(1, data.offsetInBuffer));
 
-			interpolateStereoSamples<float, true>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples);
+			SampleInterpolator::process<float, true>(interpolationMode, inL, inR, numSamplesBefore, pitchDataForBlock, outL, outR, indexInBuffer, uptimeDelta, numSamples);
 		}
 		else
 		{
@@ -726,7 +665,7 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 			if (useNormalisation)
 			{
-				const int numSamplesThisTime = (int)(ceil)((pitchCounter + startAlpha)) + 1;
+				const int numSamplesThisTime = numSamplesBefore + (int)(ceil)((pitchCounter + startAlpha)) + 1 + numExtraSamples;
 
 				float* inL_f = (float*)alloca(sizeof(float) * numSamplesThisTime);
 				float* d[2] = { inL_f, nullptr };
@@ -737,22 +676,22 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 					d[1] = inR_f;
 
-					data.b->convertToFloatWithNormalisation(d, data.b->getNumChannels(), data.offsetInBuffer, numSamplesThisTime);
+					data.b->convertToFloatWithNormalisation(d, data.b->getNumChannels(), data.offsetInBuffer - numSamplesBefore, numSamplesThisTime);
 
-					interpolateStereoSamples<float, true>(inL_f, inR_f, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples);
+					SampleInterpolator::process<float, true>(interpolationMode, inL_f + numSamplesBefore, inR_f + numSamplesBefore, numSamplesBefore, pitchDataForBlock, outL, outR, indexInBuffer, uptimeDelta, numSamples);
 				}
 				else
 				{
-					data.b->convertToFloatWithNormalisation(d, 1, data.offsetInBuffer, numSamplesThisTime);
+					data.b->convertToFloatWithNormalisation(d, 1, data.offsetInBuffer - numSamplesBefore, numSamplesThisTime);
 
-					interpolateMonoSamples<float, true>(inL_f, nullptr, pitchData, outL, nullptr, startSample, indexInBuffer, uptimeDelta, numSamples);
+					SampleInterpolator::process<float, true>(interpolationMode, inL_f + numSamplesBefore, nullptr, numSamplesBefore, pitchDataForBlock, outL, nullptr, indexInBuffer, uptimeDelta, numSamples);
 
 					memcpy(outR, outL, sizeof(float) * numSamples);
 				}
 			}
 			else
 			{
-				interpolateStereoSamples<int16, false>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples);
+				SampleInterpolator::process<int16, false>(interpolationMode, inL, inR, numSamplesBefore, pitchDataForBlock, outL, outR, indexInBuffer, uptimeDelta, numSamples);
 			}
 		}
 
@@ -857,9 +796,11 @@ void StreamingSamplerVoice::initTemporaryVoiceBuffer(hlac::HiseSampleBuffer* buf
 	// The channel amount must be set correctly in the constructor
 	jassert(bufferToUse->getNumChannels() > 0);
 
-	if (bufferToUse->getNumSamples() < samplesPerBlock*MAX_SAMPLER_PITCH)
+	const int numSamplesToUse = samplesPerBlock * MAX_SAMPLER_PITCH + SampleInterpolator::NumPaddingSamples + SampleInterpolator::MaxNumSamplesBefore;
+
+	if (bufferToUse->getNumSamples() < numSamplesToUse)
 	{
-		bufferToUse->setSize(bufferToUse->getNumChannels(), samplesPerBlock*MAX_SAMPLER_PITCH);
+		bufferToUse->setSize(bufferToUse->getNumChannels(), numSamplesToUse);
 		bufferToUse->clear();
 	}
 }
@@ -901,4 +842,10 @@ SampleThreadPool::Job::JobStatus SampleLoader::Unmapper::runJob()
 	return SampleThreadPoolJob::jobHasFinished;
 }
 
+int64 SampleLoader::Unmapper::getStreamingQueueKey() const
+{
+	// Use the same queue as the loader so the file handle isn't closed while it's reading
+	return sound != nullptr ? sound->getStreamingQueueKey() : 1;
+}
+
 } // namespace hise
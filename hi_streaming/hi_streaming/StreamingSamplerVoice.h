@@ -69,6 +69,12 @@ public:
 	*/
 	JobStatus runJob() override;
 
+	/** Returns the key of the loaded sound so that all voices that read from the same file use the same streaming queue. */
+	int64 getStreamingQueueKey() const override;
+
+	/** Tells the OS which part of the sample will be read by the next runJob() call. */
+	void prefetch() override;
+
 	size_t getActualStreamingBufferSize() const;
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
@@ -103,6 +109,8 @@ public:
 
 		JobStatus runJob() override;
 
+		int64 getStreamingQueueKey() const override;
+
 	private:
 
 		StreamingSamplerSound *sound;
@@ -185,6 +193,9 @@ private:
 	Atomic<float> diskUsage;
 	double lastCallToRequestData;
 
+	// the time of the last buffer swap (used to calculate the deadline for the streaming thread)
+	int64 lastSwapTicks = 0;
+
 	// just a pointer to the used pool
 	SampleThreadPool *backgroundPool;
 
@@ -285,6 +296,11 @@ public:
 	/** Set this to false if you're using HLAC compressed monoliths. */
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Sets the interpolation algorithm that is used for resampling. Call this before startNote(). */
+	void setInterpolationMode(SampleInterpolator::Mode newMode) noexcept { interpolationMode = newMode; }
+
+	SampleInterpolator::Mode getInterpolationMode() const noexcept { return interpolationMode; }
+
 private:
 
 	double pitchCounter = 0.0;
@@ -305,6 +321,8 @@ private:
 
 	int sampleStartModValue;
 
+	SampleInterpolator::Mode interpolationMode = SampleInterpolator::Linear;
+
 	DebugLogger* logger = nullptr;
 
 	SampleLoader loader;
@@ -0,0 +1,522 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace PeakCacheHelpers
+{
+	static constexpr int FileIdentifier = 0x434b5048; // "HPKC"
+	static constexpr int FileVersion = 1;
+
+	static int16 toInt16(float value)
+	{
+		return (int16)roundToInt(jlimit<float>(-1.0f, 1.0f, value) * 32767.0f);
+	}
+
+	static float toFloat(int16 value)
+	{
+		return (float)value / 32767.0f;
+	}
+
+	static File getDefaultCacheDirectory()
+	{
+#if JUCE_MAC
+		auto appDataDirectory = File::getSpecialLocation(File::userApplicationDataDirectory).getChildFile("Application Support/HISE");
+#else
+		auto appDataDirectory = File::getSpecialLocation(File::userApplicationDataDirectory).getChildFile("HISE");
+#endif
+
+		return appDataDirectory.getChildFile("PeakCache");
+	}
+}
+
+PeakPyramid::PeakPyramid(int numChannels_, int64 numSamples_) :
+	numChannels(numChannels_),
+	numSamples(numSamples_),
+	numLevels(1)
+{
+	while (getBlockSize(numLevels - 1) < numSamples)
+		numLevels++;
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		for (int l = 0; l < numLevels; l++)
+		{
+			auto level = new Array<Entry>();
+
+			const int64 blockSize = getBlockSize(l);
+			level->resize((int)((numSamples + blockSize - 1) / blockSize));
+
+			levels.add(level);
+		}
+	}
+}
+
+PeakPyramid::Ptr PeakPyramid::createFromReader(AudioFormatReader& reader, const std::function<bool()>& shouldAbort)
+{
+	const int numChannels = jlimit<int>(1, 2, (int)reader.numChannels);
+	const int64 numSamples = reader.lengthInSamples;
+
+	Ptr p = new PeakPyramid(numChannels, numSamples);
+
+	// A multiple of the block size, so that only the last chunk contains a partial block
+	const int chunkSize = HISE_PEAK_CACHE_BASE_BLOCK_SIZE * 256;
+
+	AudioSampleBuffer chunk(numChannels, chunkSize);
+
+	for (int64 offset = 0; offset < numSamples; offset += chunkSize)
+	{
+		if (shouldAbort && shouldAbort())
+			return nullptr;
+
+		const int numThisTime = (int)jmin<int64>(chunkSize, numSamples - offset);
+
+		reader.read(&chunk, 0, numThisTime, offset, true, numChannels > 1);
+
+		for (int c = 0; c < numChannels; c++)
+			p->addToFirstLevel(c, offset, chunk.getReadPointer(c), numThisTime);
+	}
+
+	p->buildUpperLevels();
+
+	return p;
+}
+
+PeakPyramid::Ptr PeakPyramid::createFromData(const float* const* data, int numChannels, int numSamples)
+{
+	Ptr p = new PeakPyramid(numChannels, numSamples);
+
+	for (int c = 0; c < numChannels; c++)
+		p->addToFirstLevel(c, 0, data[c], numSamples);
+
+	p->buildUpperLevels();
+
+	return p;
+}
+
+PeakPyramid::Ptr PeakPyramid::createFromStream(InputStream& input)
+{
+	if (input.readInt() != PeakCacheHelpers::FileIdentifier || input.readInt() != PeakCacheHelpers::FileVersion)
+		return nullptr;
+
+	if (input.readInt() != HISE_PEAK_CACHE_BASE_BLOCK_SIZE)
+		return nullptr;
+
+	const int numChannels = input.readInt();
+	const int64 numSamples = input.readInt64();
+
+	if (numChannels < 1 || numChannels > 2 || numSamples < 0)
+		return nullptr;
+
+	// Check the sample count against the stored entries before allocating the levels for it.
+	// Every channel stores its entry count and 6 bytes per entry.
+	const int64 numFirstLevelEntries = numSamples / HISE_PEAK_CACHE_BASE_BLOCK_SIZE + (numSamples % HISE_PEAK_CACHE_BASE_BLOCK_SIZE != 0 ? 1 : 0);
+
+	if ((int64)numChannels * ((int64)sizeof(int) + numFirstLevelEntries * 6) > input.getNumBytesRemaining())
+		return nullptr;
+
+	Ptr p = new PeakPyramid(numChannels, numSamples);
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		auto& firstLevel = p->getLevel(c, 0);
+
+		if (input.readInt() != firstLevel.size() || input.getNumBytesRemaining() < (int64)firstLevel.size() * 6)
+			return nullptr;
+
+		for (auto& e : firstLevel)
+		{
+			e.minValue = input.readShort();
+			e.maxValue = input.readShort();
+			e.rms = input.readShort();
+		}
+	}
+
+	p->buildUpperLevels();
+
+	return p;
+}
+
+void PeakPyramid::writeToStream(OutputStream& output) const
+{
+	output.writeInt(PeakCacheHelpers::FileIdentifier);
+	output.writeInt(PeakCacheHelpers::FileVersion);
+	output.writeInt(HISE_PEAK_CACHE_BASE_BLOCK_SIZE);
+	output.writeInt(numChannels);
+	output.writeInt64(numSamples);
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		const auto& firstLevel = getLevel(c, 0);
+
+		output.writeInt(firstLevel.size());
+
+		for (const auto& e : firstLevel)
+		{
+			output.writeShort(e.minValue);
+			output.writeShort(e.maxValue);
+			output.writeShort(e.rms);
+		}
+	}
+}
+
+int PeakPyramid::getLevelForSamplesPerPixel(double samplesPerPixel) const
+{
+	int levelIndex = 0;
+
+	while (levelIndex < numLevels - 1 && (double)getBlockSize(levelIndex + 1) <= samplesPerPixel)
+		levelIndex++;
+
+	return levelIndex;
+}
+
+PeakPyramid::Peak PeakPyramid::getPeak(int channelIndex, int levelIndex, Range<int64> sampleRange) const
+{
+	Peak p;
+
+	if (!isPositiveAndBelow(channelIndex, numChannels) || !isPositiveAndBelow(levelIndex, numLevels))
+		return p;
+
+	const auto& level = getLevel(channelIndex, levelIndex);
+	const int64 blockSize = getBlockSize(levelIndex);
+
+	if (level.isEmpty())
+		return p;
+
+	const int start = (int)jlimit<int64>(0, level.size() - 1, sampleRange.getStart() / blockSize);
+	const int end = (int)jlimit<int64>(start + 1, level.size(), (sampleRange.getEnd() + blockSize - 1) / blockSize);
+
+	int16 minValue = level.getReference(start).minValue;
+	int16 maxValue = level.getReference(start).maxValue;
+	float sumOfSquares = 0.0f;
+
+	for (int i = start; i < end; i++)
+	{
+		const auto& e = level.getReference(i);
+
+		minValue = jmin(minValue, e.minValue);
+		maxValue = jmax(maxValue, e.maxValue);
+
+		const float rms = PeakCacheHelpers::toFloat(e.rms);
+		sumOfSquares += rms * rms;
+	}
+
+	p.minValue = PeakCacheHelpers::toFloat(minValue);
+	p.maxValue = PeakCacheHelpers::toFloat(maxValue);
+	p.rms = std::sqrt(sumOfSquares / (float)(end - start));
+
+	return p;
+}
+
+PeakPyramid::Peak PeakPyramid::getTotalPeak(int channelIndex) const
+{
+	return getPeak(channelIndex, numLevels - 1, { 0, numSamples });
+}
+
+void PeakPyramid::addToFirstLevel(int channelIndex, int64 offset, const float* data, int numSamplesInChunk)
+{
+	jassert(offset % HISE_PEAK_CACHE_BASE_BLOCK_SIZE == 0);
+
+	auto& firstLevel = getLevel(channelIndex, 0);
+	int entryIndex = (int)(offset / HISE_PEAK_CACHE_BASE_BLOCK_SIZE);
+
+	for (int i = 0; i < numSamplesInChunk; i += HISE_PEAK_CACHE_BASE_BLOCK_SIZE)
+	{
+		const int numInBlock = jmin<int>(HISE_PEAK_CACHE_BASE_BLOCK_SIZE, numSamplesInChunk - i);
+		const float* d = data + i;
+
+		auto range = FloatVectorOperations::findMinAndMax(d, numInBlock);
+
+		float sumOfSquares = 0.0f;
+
+		for (int j = 0; j < numInBlock; j++)
+			sumOfSquares += d[j] * d[j];
+
+		auto& e = firstLevel.getReference(entryIndex++);
+
+		e.minValue = PeakCacheHelpers::toInt16(range.getStart());
+		e.maxValue = PeakCacheHelpers::toInt16(range.getEnd());
+		e.rms = PeakCacheHelpers::toInt16(std::sqrt(sumOfSquares / (float)numInBlock));
+	}
+}
+
+void PeakPyramid::buildUpperLevels()
+{
+	for (int c = 0; c < numChannels; c++)
+	{
+		for (int l = 1; l < numLevels; l++)
+		{
+			const auto& source = getLevel(c, l - 1);
+			auto& dest = getLevel(c, l);
+
+			for (int i = 0; i < dest.size(); i++)
+			{
+				const auto& a = source.getReference(i * 2);
+				const auto& b = (i * 2 + 1 < source.size()) ? source.getReference(i * 2 + 1) : a;
+
+				const float rmsA = PeakCacheHelpers::toFloat(a.rms);
+				const float rmsB = PeakCacheHelpers::toFloat(b.rms);
+
+				auto& e = dest.getReference(i);
+
+				e.minValue = jmin(a.minValue, b.minValue);
+				e.maxValue = jmax(a.maxValue, b.maxValue);
+				e.rms = PeakCacheHelpers::toInt16(std::sqrt((rmsA * rmsA + rmsB * rmsB) * 0.5f));
+			}
+		}
+	}
+}
+
+class PeakCache::PrefetchJob : public ThreadPoolJob
+{
+public:
+
+	PrefetchJob(PeakCache& parent_, const Request& r) :
+		ThreadPoolJob("Peak Cache " + r.key),
+		parent(parent_),
+		request(r)
+	{}
+
+	JobStatus runJob() override
+	{
+		if (parent.getCachedPyramid(request.key) != nullptr)
+			return jobHasFinished;
+
+		ScopedPointer<AudioFormatReader> reader = request.createReader();
+
+		if (reader != nullptr)
+			parent.getOrCreatePyramid(request.key, *reader, [this]() { return shouldExit(); });
+
+		return jobHasFinished;
+	}
+
+private:
+
+	PeakCache& parent;
+	Request request;
+};
+
+PeakCache::PeakCache() :
+	PeakCache(PeakCacheHelpers::getDefaultCacheDirectory(), (int64)HISE_PEAK_CACHE_MAX_DISK_SIZE_MB * 1024 * 1024)
+{}
+
+PeakCache::PeakCache(const File& cacheDirectory_, int64 maxDiskSizeInBytes) :
+	cacheDirectory(cacheDirectory_),
+	maxDiskSize(maxDiskSizeInBytes),
+	pool(jlimit<int>(1, 4, SystemStats::getNumCpus() - 1))
+{}
+
+PeakCache::~PeakCache()
+{
+	pool.removeAllJobs(true, 2000);
+}
+
+String PeakCache::getKeyForFile(const File& f)
+{
+	// Hashing the content would mean reading the whole file, which is what we try to avoid here
+	return f.getFullPathName() + ":" + String(f.getSize()) + ":" + String(f.getLastModificationTime().toMilliseconds());
+}
+
+String PeakCache::getKeyForMonolith(const File& monolithFile, int64 offset, int64 length)
+{
+	// Include the monolith metadata so that re-encoding the sample map invalidates the cached samples
+	return getKeyForFile(monolithFile) + ":" + String(offset) + ":" + String(length);
+}
+
+PeakPyramid::Ptr PeakCache::getCachedPyramid(const String& key)
+{
+	if (auto p = getFromMemory(key))
+		return p;
+
+	auto f = getCacheFile(key);
+
+	if (!f.existsAsFile())
+		return nullptr;
+
+	FileInputStream fis(f);
+
+	if (fis.openedOk() && fis.readString() == key)
+	{
+		if (auto p = PeakPyramid::createFromStream(fis))
+		{
+			// The access time is used to find the least recently used files
+			f.setLastAccessTime(Time::getCurrentTime());
+
+			addToMemory(key, p);
+			return p;
+		}
+	}
+
+	// The file is corrupt or was written for another key with the same hash
+	f.deleteFile();
+
+	return nullptr;
+}
+
+PeakPyramid::Ptr PeakCache::getOrCreatePyramid(const String& key, AudioFormatReader& reader, const std::function<bool()>& shouldAbort)
+{
+	if (auto p = getCachedPyramid(key))
+		return p;
+
+	auto p = PeakPyramid::createFromReader(reader, shouldAbort);
+
+	if (p != nullptr)
+	{
+		addToMemory(key, p);
+		writeToDisk(key, p);
+	}
+
+	return p;
+}
+
+void PeakCache::prefetch(const Array<Request>& requests)
+{
+	pool.removeAllJobs(false, 0);
+
+	for (const auto& r : requests)
+		pool.addJob(new PrefetchJob(*this, r), true);
+}
+
+File PeakCache::getCacheFile(const String& key) const
+{
+	return cacheDirectory.getChildFile(String::toHexString(key.hashCode64())).withFileExtension("hpk");
+}
+
+PeakPyramid::Ptr PeakCache::getFromMemory(const String& key)
+{
+	ScopedLock sl(lock);
+
+	const int index = memoryKeys.indexOf(key);
+
+	if (index == -1)
+		return nullptr;
+
+	PeakPyramid::Ptr p = memoryPyramids[index];
+
+	// Move it to the end so that the least recently used pyramid gets removed first
+	memoryKeys.remove(index);
+	memoryPyramids.remove(index);
+	memoryKeys.add(key);
+	memoryPyramids.add(p);
+
+	return p;
+}
+
+void PeakCache::addToMemory(const String& key, PeakPyramid::Ptr p)
+{
+	ScopedLock sl(lock);
+
+	if (memoryKeys.contains(key))
+		return;
+
+	memoryKeys.add(key);
+	memoryPyramids.add(p);
+
+	while (memoryKeys.size() > HISE_PEAK_CACHE_NUM_MEMORY_ENTRIES)
+	{
+		memoryKeys.remove(0);
+		memoryPyramids.remove(0);
+	}
+}
+
+void PeakCache::writeToDisk(const String& key, PeakPyramid::Ptr p)
+{
+	if (!cacheDirectory.isDirectory() && !cacheDirectory.createDirectory())
+		return;
+
+	// Write it into a temporary file first so that other threads never read a half written file
+	TemporaryFile tempFile(getCacheFile(key));
+
+	{
+		FileOutputStream fos(tempFile.getFile());
+
+		if (!fos.openedOk())
+			return;
+
+		fos.writeString(key);
+		p->writeToStream(fos);
+	}
+
+	if (!tempFile.overwriteTargetFileWithTemporary())
+		return;
+
+	ScopedLock sl(diskLock);
+
+	if (diskUsage < 0 || (diskUsage += getCacheFile(key).getSize()) > maxDiskSize)
+		deleteOldFiles();
+}
+
+void PeakCache::deleteOldFiles()
+{
+	ScopedLock sl(diskLock);
+
+	Array<File> files;
+	cacheDirectory.findChildFiles(files, File::findFiles, false, "*.hpk");
+
+	diskUsage = 0;
+
+	for (const auto& f : files)
+		diskUsage += f.getSize();
+
+	if (diskUsage <= maxDiskSize)
+		return;
+
+	struct AccessTimeSorter
+	{
+		static int compareElements(const File& first, const File& second)
+		{
+			const int64 a = first.getLastAccessTime().toMilliseconds();
+			const int64 b = second.getLastAccessTime().toMilliseconds();
+
+			return a < b ? -1 : (a > b ? 1 : 0);
+		}
+	};
+
+	AccessTimeSorter sorter;
+	files.sort(sorter);
+
+	// Go a bit below the limit so that the next writes don't have to scan the directory again
+	const int64 targetSize = maxDiskSize / 4 * 3;
+
+	for (const auto& f : files)
+	{
+		if (diskUsage <= targetSize)
+			break;
+
+		const int64 size = f.getSize();
+
+		if (f.deleteFile())
+			diskUsage -= size;
+	}
+}
+
+} // namespace hise
@@ -0,0 +1,209 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PEAKCACHE_H_INCLUDED
+#define PEAKCACHE_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** The amount of samples that are summarised by one entry of the first pyramid level. */
+#ifndef HISE_PEAK_CACHE_BASE_BLOCK_SIZE
+#define HISE_PEAK_CACHE_BASE_BLOCK_SIZE 256
+#endif
+
+/** The amount of pyramids that are kept in memory. */
+#ifndef HISE_PEAK_CACHE_NUM_MEMORY_ENTRIES
+#define HISE_PEAK_CACHE_NUM_MEMORY_ENTRIES 128
+#endif
+
+/** The maximum size of the cache directory in megabytes. If it gets bigger, the least recently used files are deleted. */
+#ifndef HISE_PEAK_CACHE_MAX_DISK_SIZE_MB
+#define HISE_PEAK_CACHE_MAX_DISK_SIZE_MB 256
+#endif
+
+
+/** A multi-resolution summary of the minimum, maximum and RMS values of an audio sample.
+*
+*	The first level contains one entry for every HISE_PEAK_CACHE_BASE_BLOCK_SIZE samples and every
+*	further level combines two entries of the level below. A waveform view picks the level that matches
+*	its zoom factor, so it only has to look at a few entries per pixel no matter how long the sample is.
+*
+*	The values are stored as 16 bit integers to keep the memory and disk footprint small.
+*/
+class PeakPyramid : public ReferenceCountedObject
+{
+public:
+
+	using Ptr = ReferenceCountedObjectPtr<PeakPyramid>;
+
+	struct Peak
+	{
+		float minValue = 0.0f;
+		float maxValue = 0.0f;
+		float rms = 0.0f;
+	};
+
+	/** Calculates the pyramid by reading the sample in chunks. Returns nullptr if the analysis was aborted. */
+	static Ptr createFromReader(AudioFormatReader& reader, const std::function<bool()>& shouldAbort = {});
+
+	/** Calculates the pyramid from the given channel data. */
+	static Ptr createFromData(const float* const* data, int numChannels, int numSamples);
+
+	/** Restores a pyramid that was written with writeToStream(). Returns nullptr if the data is invalid. */
+	static Ptr createFromStream(InputStream& input);
+
+	/** Writes the first level into the stream (the other levels are recalculated when it is loaded). */
+	void writeToStream(OutputStream& output) const;
+
+	int getNumChannels() const noexcept { return numChannels; }
+	int64 getNumSamples() const noexcept { return numSamples; }
+	int getNumLevels() const noexcept { return numLevels; }
+
+	/** Returns the amount of samples that one entry of the given level covers. */
+	int64 getBlockSize(int levelIndex) const noexcept { return (int64)HISE_PEAK_CACHE_BASE_BLOCK_SIZE << levelIndex; }
+
+	/** Returns the coarsest level with a block size that is not bigger than the given amount of samples per pixel. */
+	int getLevelForSamplesPerPixel(double samplesPerPixel) const;
+
+	/** Combines the entries of the given level that cover the sample range. */
+	Peak getPeak(int channelIndex, int levelIndex, Range<int64> sampleRange) const;
+
+	/** Returns the peak of the whole channel. */
+	Peak getTotalPeak(int channelIndex) const;
+
+private:
+
+	struct Entry
+	{
+		int16 minValue = 0;
+		int16 maxValue = 0;
+		int16 rms = 0;
+	};
+
+	PeakPyramid(int numChannels_, int64 numSamples_);
+
+	/** Adds the entries of a chunk to the first level. The chunk must start at a multiple of the base block size. */
+	void addToFirstLevel(int channelIndex, int64 offset, const float* data, int numSamplesInChunk);
+
+	void buildUpperLevels();
+
+	Array<Entry>& getLevel(int channelIndex, int levelIndex) { return *levels[channelIndex * numLevels + levelIndex]; }
+	const Array<Entry>& getLevel(int channelIndex, int levelIndex) const { return *levels[channelIndex * numLevels + levelIndex]; }
+
+	const int numChannels;
+	const int64 numSamples;
+	int numLevels;
+
+	OwnedArray<Array<Entry>> levels;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakPyramid);
+};
+
+
+/** A cache for PeakPyramid objects that keeps the recently used pyramids in memory and stores them as files on disk.
+*
+*	Use it as SharedResourcePointer and keep it as member of a long-lived object: the cache is destroyed
+*	together with the last pointer, which cancels the prefetching and drops the pyramids in the memory.
+*
+*	The samples are identified by a key that you can create with
+*	getKeyForFile() or getKeyForMonolith(), so the waveform of a sample is only calculated once.
+*	If you know that a lot of samples will be displayed (eg. after loading a sample map), call prefetch()
+*	to calculate the missing pyramids on multiple background threads.
+*/
+class PeakCache
+{
+public:
+
+	/** A sample that should be analysed in the background. */
+	struct Request
+	{
+		String key;
+		std::function<AudioFormatReader*()> createReader;
+	};
+
+	/** Uses the PeakCache folder in the HISE app data directory and the size limit of HISE_PEAK_CACHE_MAX_DISK_SIZE_MB. */
+	PeakCache();
+
+	/** Creates a cache that stores its files in the given directory. */
+	PeakCache(const File& cacheDirectory, int64 maxDiskSizeInBytes);
+
+	~PeakCache();
+
+	/** Creates a key from the path, the size and the modification time of the file. */
+	static String getKeyForFile(const File& f);
+
+	/** Creates a key from the monolith file (like getKeyForFile()) and the position of the sample inside it. */
+	static String getKeyForMonolith(const File& monolithFile, int64 offset, int64 length);
+
+	/** Returns the pyramid from the memory or disk cache or nullptr if it wasn't calculated yet. */
+	PeakPyramid::Ptr getCachedPyramid(const String& key);
+
+	/** Returns the cached pyramid or calculates it from the reader and stores it. Don't call this on the message thread. */
+	PeakPyramid::Ptr getOrCreatePyramid(const String& key, AudioFormatReader& reader, const std::function<bool()>& shouldAbort = {});
+
+	/** Calculates the missing pyramids on multiple background threads. This cancels all pending requests from the last call. */
+	void prefetch(const Array<Request>& requests);
+
+	File getCacheDirectory() const { return cacheDirectory; }
+
+private:
+
+	class PrefetchJob;
+
+	File getCacheFile(const String& key) const;
+
+	PeakPyramid::Ptr getFromMemory(const String& key);
+	void addToMemory(const String& key, PeakPyramid::Ptr p);
+	void writeToDisk(const String& key, PeakPyramid::Ptr p);
+
+	/** Deletes the least recently used files until the directory is smaller than the size limit. */
+	void deleteOldFiles();
+
+	CriticalSection lock;
+
+	CriticalSection diskLock;
+	int64 diskUsage = -1;
+
+	File cacheDirectory;
+	const int64 maxDiskSize;
+
+	StringArray memoryKeys;
+	ReferenceCountedArray<PeakPyramid> memoryPyramids;
+
+	ThreadPool pool;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakCache);
+};
+
+} // namespace hise
+
+#endif  // PEAKCACHE_H_INCLUDED
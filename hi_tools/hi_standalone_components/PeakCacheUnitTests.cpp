@@ -0,0 +1,418 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class PeakCacheUnitTests : public UnitTest
+{
+public:
+
+	PeakCacheUnitTests() :
+		UnitTest("Testing the peak cache")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testNumLevels();
+		testGetPeak();
+		testStreamRoundTrip();
+		testDiskCache();
+		testDeleteOldFiles();
+	}
+
+private:
+
+	/** The error of the 16 bit quantisation of the entries. */
+	static constexpr float maxError = 2.0f / 32767.0f;
+
+	static AudioSampleBuffer createRandomData(Random& r, int numChannels, int numSamples)
+	{
+		AudioSampleBuffer b(numChannels, numSamples);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			for (int i = 0; i < numSamples; i++)
+				b.setSample(c, i, r.nextFloat() * 1.6f - 0.8f);
+		}
+
+		return b;
+	}
+
+	static PeakPyramid::Ptr createPyramid(const AudioSampleBuffer& b)
+	{
+		return PeakPyramid::createFromData(b.getArrayOfReadPointers(), b.getNumChannels(), b.getNumSamples());
+	}
+
+	/** Writes the buffer into a WAV file in memory and returns a reader for it. */
+	static AudioFormatReader* createReader(const AudioSampleBuffer& b)
+	{
+		MemoryBlock mb;
+		WavAudioFormat wav;
+
+		{
+			ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(new MemoryOutputStream(mb, false), 44100.0, b.getNumChannels(), 24, StringPairArray(), 0);
+			writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+		}
+
+		return wav.createReaderFor(new MemoryInputStream(mb, true), true);
+	}
+
+	/** Calculates the range of the blocks that getPeak() combines by looking at every sample. */
+	static Range<float> getExpectedRange(const AudioSampleBuffer& b, int channelIndex, int64 blockSize, Range<int64> sampleRange)
+	{
+		const int start = (int)(sampleRange.getStart() / blockSize * blockSize);
+		const int end = (int)jmin<int64>(b.getNumSamples(), (sampleRange.getEnd() + blockSize - 1) / blockSize * blockSize);
+
+		return FloatVectorOperations::findMinAndMax(b.getReadPointer(channelIndex, start), end - start);
+	}
+
+	static Range<int64> getRandomRange(Random& r, int64 numSamples)
+	{
+		const int64 start = (int64)r.nextInt((int)numSamples);
+		const int64 end = start + 1 + (int64)r.nextInt((int)(numSamples - start));
+
+		return { start, end };
+	}
+
+	void testNumLevels()
+	{
+		beginTest("Testing the number of pyramid levels");
+
+		for (int numSamples : { 1, HISE_PEAK_CACHE_BASE_BLOCK_SIZE, HISE_PEAK_CACHE_BASE_BLOCK_SIZE + 1, 16384, 100000 })
+		{
+			AudioSampleBuffer b(1, numSamples);
+			b.clear();
+
+			auto p = createPyramid(b);
+
+			const int lastLevel = p->getNumLevels() - 1;
+
+			expectEquals(p->getNumSamples(), (int64)numSamples);
+			expectEquals(p->getNumChannels(), 1);
+			expect(p->getBlockSize(lastLevel) >= numSamples, "The last level doesn't cover " + String(numSamples) + " samples");
+			expect(lastLevel == 0 || p->getBlockSize(lastLevel - 1) < numSamples, "Too many levels for " + String(numSamples) + " samples");
+		}
+
+		AudioSampleBuffer b(1, 100000);
+		b.clear();
+
+		auto p = createPyramid(b);
+
+		const int lastLevel = p->getNumLevels() - 1;
+
+		expectEquals(p->getLevelForSamplesPerPixel(1.0), 0);
+		expectEquals(p->getLevelForSamplesPerPixel((double)p->getBlockSize(1) - 1.0), 0);
+		expectEquals(p->getLevelForSamplesPerPixel((double)p->getBlockSize(1)), 1);
+		expectEquals(p->getLevelForSamplesPerPixel((double)p->getBlockSize(3) + 1.0), 3);
+		expectEquals(p->getLevelForSamplesPerPixel(1e12), lastLevel);
+	}
+
+	void testGetPeak()
+	{
+		beginTest("Testing the peaks of the pyramid levels");
+
+		Random r(5678);
+
+		constexpr int numSamples = 100000;
+
+		auto b = createRandomData(r, 2, numSamples);
+		auto p = createPyramid(b);
+
+		for (int level = 0; level < p->getNumLevels(); level++)
+		{
+			for (int i = 0; i < 50; i++)
+			{
+				const auto range = getRandomRange(r, numSamples);
+
+				for (int c = 0; c < 2; c++)
+				{
+					const auto expected = getExpectedRange(b, c, p->getBlockSize(level), range);
+					const auto peak = p->getPeak(c, level, range);
+
+					const String message = "Level " + String(level) + ", channel " + String(c) + ", range " + String(range.getStart()) + " - " + String(range.getEnd());
+
+					expectWithinAbsoluteError(peak.minValue, expected.getStart(), maxError, message);
+					expectWithinAbsoluteError(peak.maxValue, expected.getEnd(), maxError, message);
+				}
+			}
+		}
+
+		for (int c = 0; c < 2; c++)
+		{
+			const auto expected = FloatVectorOperations::findMinAndMax(b.getReadPointer(c), numSamples);
+			const auto total = p->getTotalPeak(c);
+
+			expectWithinAbsoluteError(total.minValue, expected.getStart(), maxError, "Total minimum");
+			expectWithinAbsoluteError(total.maxValue, expected.getEnd(), maxError, "Total maximum");
+		}
+
+		const auto invalid = p->getPeak(2, 0, { 0, numSamples });
+
+		expectEquals(invalid.maxValue, 0.0f, "Invalid channel");
+
+		// One block with a constant value next to a silent block
+		constexpr int blockSize = HISE_PEAK_CACHE_BASE_BLOCK_SIZE;
+
+		AudioSampleBuffer rmsData(1, blockSize * 4);
+		rmsData.clear();
+		FloatVectorOperations::fill(rmsData.getWritePointer(0, blockSize * 2), 0.5f, blockSize);
+
+		auto rmsPyramid = createPyramid(rmsData);
+
+		expectWithinAbsoluteError(rmsPyramid->getPeak(0, 0, { blockSize * 2, blockSize * 3 }).rms, 0.5f, maxError, "RMS of the first level");
+		expectWithinAbsoluteError(rmsPyramid->getPeak(0, 1, { blockSize * 2, blockSize * 3 }).rms, std::sqrt(0.125f), maxError, "RMS of the second level");
+		expectEquals(rmsPyramid->getPeak(0, 0, { 0, blockSize }).rms, 0.0f, "RMS of silence");
+	}
+
+	void testStreamRoundTrip()
+	{
+		beginTest("Testing the stream round trip");
+
+		Random r(91011);
+
+		constexpr int numSamples = 50000;
+
+		auto b = createRandomData(r, 2, numSamples);
+		auto p = createPyramid(b);
+
+		MemoryOutputStream mos;
+		p->writeToStream(mos);
+
+		MemoryInputStream mis(mos.getData(), mos.getDataSize(), false);
+		auto restored = PeakPyramid::createFromStream(mis);
+
+		expect(restored != nullptr, "Can't restore the pyramid");
+
+		if (restored == nullptr)
+			return;
+
+		expectEquals(restored->getNumChannels(), p->getNumChannels());
+		expectEquals(restored->getNumSamples(), p->getNumSamples());
+		expectEquals(restored->getNumLevels(), p->getNumLevels());
+
+		for (int level = 0; level < p->getNumLevels(); level++)
+		{
+			for (int i = 0; i < 20; i++)
+			{
+				const auto range = getRandomRange(r, numSamples);
+
+				for (int c = 0; c < 2; c++)
+				{
+					const auto expected = p->getPeak(c, level, range);
+					const auto actual = restored->getPeak(c, level, range);
+
+					expectEquals(actual.minValue, expected.minValue, "Minimum of level " + String(level));
+					expectEquals(actual.maxValue, expected.maxValue, "Maximum of level " + String(level));
+					expectEquals(actual.rms, expected.rms, "RMS of level " + String(level));
+				}
+			}
+		}
+
+		MemoryInputStream truncated(mos.getData(), mos.getDataSize() - 10, false);
+		expect(PeakPyramid::createFromStream(truncated) == nullptr, "Truncated data was restored");
+
+		MemoryBlock corrupted(mos.getData(), mos.getDataSize());
+		corrupted[0] = (char)(corrupted[0] + 1);
+
+		MemoryInputStream corruptedStream(corrupted, false);
+		expect(PeakPyramid::createFromStream(corruptedStream) == nullptr, "Data with a wrong identifier was restored");
+
+		// The sample count follows the identifier, the version, the block size and the channel amount
+		const int lengthFieldOffset = 4 * (int)sizeof(int);
+
+		for (int64 wrongLength : { (int64)numSamples * 4, (int64)1 << 40, std::numeric_limits<int64>::max() })
+		{
+			MemoryBlock wrongLengthData(mos.getData(), mos.getDataSize());
+
+			const uint64 storedLength = ByteOrder::swapIfBigEndian((uint64)wrongLength);
+			wrongLengthData.copyFrom(&storedLength, lengthFieldOffset, sizeof(uint64));
+
+			MemoryInputStream wrongLengthStream(wrongLengthData, false);
+			expect(PeakPyramid::createFromStream(wrongLengthStream) == nullptr, "Data with a wrong length of " + String(wrongLength) + " was restored");
+		}
+	}
+
+	void testDiskCache()
+	{
+		beginTest("Testing the disk cache");
+
+		auto directory = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("PeakCacheTest", "");
+
+		Random r(1213);
+
+		constexpr int numSamples = 65536;
+
+		auto b = createRandomData(r, 1, numSamples);
+		auto expected = createPyramid(b);
+
+		{
+			PeakCache cache(directory, 64 * 1024 * 1024);
+
+			ScopedPointer<AudioFormatReader> reader = createReader(b);
+			auto p = cache.getOrCreatePyramid("first", *reader);
+
+			expect(p != nullptr, "Can't create the pyramid");
+			expect(cache.getCachedPyramid("first") == p, "The pyramid isn't kept in memory");
+			expect(cache.getCachedPyramid("second") == nullptr, "Found a pyramid for an unknown key");
+			expectEquals(directory.getNumberOfChildFiles(File::findFiles, "*.hpk"), 1, "Number of cache files");
+		}
+
+		{
+			// A new cache has an empty memory, so it has to load the file
+			PeakCache cache(directory, 64 * 1024 * 1024);
+
+			auto p = cache.getCachedPyramid("first");
+
+			expect(p != nullptr, "Can't load the pyramid from the disk");
+
+			if (p != nullptr)
+			{
+				expectEquals(p->getNumSamples(), (int64)numSamples);
+
+				const auto total = p->getTotalPeak(0);
+				const auto expectedTotal = expected->getTotalPeak(0);
+
+				// The reader returns the 24 bit values, so it can be one step off
+				expectWithinAbsoluteError(total.minValue, expectedTotal.minValue, maxError, "Minimum of the loaded pyramid");
+				expectWithinAbsoluteError(total.maxValue, expectedTotal.maxValue, maxError, "Maximum of the loaded pyramid");
+			}
+		}
+
+		directory.deleteRecursively();
+	}
+
+	/** Returns the keys of the cache files, which are stored at the beginning of the file. */
+	static StringArray getKeysInDirectory(const File& directory)
+	{
+		StringArray keys;
+
+		Array<File> files;
+		directory.findChildFiles(files, File::findFiles, false, "*.hpk");
+
+		for (const auto& f : files)
+		{
+			FileInputStream fis(f);
+			keys.add(fis.readString());
+		}
+
+		return keys;
+	}
+
+	void testDeleteOldFiles()
+	{
+		beginTest("Testing the deletion of the least recently used files");
+
+		auto directory = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("PeakCacheTest", "");
+
+		Random r(1415);
+
+		auto b = createRandomData(r, 1, HISE_PEAK_CACHE_BASE_BLOCK_SIZE * 256);
+		auto p = createPyramid(b);
+
+		auto getKey = [](int index) { return "sample" + String(index); };
+
+		// All keys have the same length, so all files have the same size
+		MemoryOutputStream mos;
+		mos.writeString(getKey(0));
+		p->writeToStream(mos);
+
+		const int64 fileSize = (int64)mos.getDataSize();
+
+		// Four files fit into the cache, the fifth one exceeds the limit
+		const int64 maxDiskSize = fileSize * 9 / 2;
+
+		PeakCache cache(directory, maxDiskSize);
+
+		for (int i = 0; i < 4; i++)
+		{
+			ScopedPointer<AudioFormatReader> reader = createReader(b);
+			cache.getOrCreatePyramid(getKey(i), *reader);
+		}
+
+		expectEquals(directory.getNumberOfChildFiles(File::findFiles, "*.hpk"), 4, "Files were deleted below the limit");
+
+		// Make the files with the lower indexes the least recently used ones
+		Array<File> files;
+		directory.findChildFiles(files, File::findFiles, false, "*.hpk");
+
+		const auto now = Time::getCurrentTime();
+
+		for (const auto& f : files)
+		{
+			String key;
+
+			{
+				FileInputStream fis(f);
+				key = fis.readString();
+			}
+
+			const int index = key.getTrailingIntValue();
+
+			f.setLastAccessTime(now - RelativeTime::minutes(10 - index));
+		}
+
+		ScopedPointer<AudioFormatReader> reader = createReader(b);
+		cache.getOrCreatePyramid(getKey(4), *reader);
+
+		auto keys = getKeysInDirectory(directory);
+
+		expect(!keys.contains(getKey(0)), "The oldest file wasn't deleted");
+		expect(!keys.contains(getKey(1)), "The second oldest file wasn't deleted");
+		expect(keys.contains(getKey(2)), "A recently used file was deleted");
+		expect(keys.contains(getKey(3)), "A recently used file was deleted");
+		expect(keys.contains(getKey(4)), "The new file was deleted");
+
+		int64 diskUsage = 0;
+
+		files.clear();
+		directory.findChildFiles(files, File::findFiles, false, "*.hpk");
+
+		for (const auto& f : files)
+			diskUsage += f.getSize();
+
+		expect(diskUsage <= maxDiskSize / 4 * 3, "The cache is still too big after deleting the files");
+
+		directory.deleteRecursively();
+	}
+};
+
+static PeakCacheUnitTests peakCacheUnitTests;
+
+#endif
@@ -580,6 +580,8 @@ void HiseAudioThumbnail::LoadingThread::run()
 	var lb;
 	var rb;
 	ScopedPointer<AudioFormatReader> reader;
+	PeakPyramid::Ptr pyramid;
+	String cacheKey;
 
 	{
 		if (parent.get() == nullptr)
@@ -588,10 +590,12 @@ void HiseAudioThumbnail::LoadingThread::run()
 		ScopedLock sl(parent->lock);
 
 		bounds = parent->getBounds();
+		pyramid = parent->pyramid;
 
 		if (parent->currentReader != nullptr)
 		{
 			reader.swapWith(parent->currentReader);
+			cacheKey = parent->peakCacheKey;
 		}
 		else
 		{
@@ -600,6 +604,27 @@ void HiseAudioThumbnail::LoadingThread::run()
 		}
 	}
 
+	float width = (float)bounds.getWidth();
+
+	if (reader != nullptr && cacheKey.isNotEmpty() && reader->lengthInSamples >= MinNumSamplesForPeakCache && shouldUsePyramid(reader->lengthInSamples, width))
+	{
+		pyramid = peakCache->getOrCreatePyramid(cacheKey, *reader, [this]() { return threadShouldExit(); });
+
+		if (pyramid == nullptr)
+			return;
+
+		reader = nullptr;
+
+		if (parent.get() != nullptr)
+		{
+			ScopedLock sl(parent->lock);
+
+			parent->pyramid = pyramid;
+			parent->lBuffer = var();
+			parent->rBuffer = var();
+		}
+	}
+
 	if (reader != nullptr)
 	{
 		VariantBuffer::Ptr l = new VariantBuffer((int)reader->lengthInSamples);
@@ -643,51 +668,43 @@ void HiseAudioThumbnail::LoadingThread::run()
 	Path lPath;
 	Path rPath;
 
-	float width = (float)bounds.getWidth();
-
-
 	VariantBuffer::Ptr r = rb.getBuffer();
 	VariantBuffer::Ptr l = lb.getBuffer();
 
-	
-	if (l != nullptr && l->size != 0)
+	// Summarise long buffers once so that resizing doesn't have to scan the whole buffer again
+	if (pyramid == nullptr && l != nullptr && shouldUsePyramid(l->size, width))
 	{
-		const float* data = l->buffer.getReadPointer(0);
-		const int numSamples = l->size;
+		const bool useRight = r != nullptr && r->size == l->size;
+		const float* data[2] = { l->buffer.getReadPointer(0), useRight ? r->buffer.getReadPointer(0) : nullptr };
 
-		calculatePath(lPath, width, data, numSamples);
-	}
+		pyramid = PeakPyramid::createFromData(data, useRight ? 2 : 1, l->size);
 
-	if (r != nullptr && r->size != 0)
-	{
-		const float* data = r->buffer.getReadPointer(0);
-		const int numSamples = r->size;
+		if (parent.get() != nullptr)
+		{
+			ScopedLock sl(parent->lock);
 
-		calculatePath(rPath, width, data, numSamples);
+			if (parent->lBuffer.getBuffer() == l.get())
+				parent->pyramid = pyramid;
+		}
 	}
-	
-	const bool isMono = rPath.isEmpty();
 
-	if (isMono)
+	const bool usePyramid = pyramid != nullptr && (l == nullptr || shouldUsePyramid(l->size, width));
+
+	if (usePyramid)
 	{
-		if (l != nullptr && l->size != 0)
-		{
-			const float* data = l->buffer.getReadPointer(0);
-			const int numSamples = l->size;
+		calculatePathFromPyramid(lPath, width, *pyramid, 0);
 
-			scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), (float)bounds.getHeight() }, data, numSamples);
-		}
+		if (pyramid->getNumChannels() > 1)
+			calculatePathFromPyramid(rPath, width, *pyramid, 1);
 	}
 	else
 	{
-		float h = (float)bounds.getHeight() / 2.0f;
-
 		if (l != nullptr && l->size != 0)
 		{
 			const float* data = l->buffer.getReadPointer(0);
 			const int numSamples = l->size;
 
-			scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), h }, data, numSamples);
+			calculatePath(lPath, width, data, numSamples);
 		}
 
 		if (r != nullptr && r->size != 0)
@@ -695,10 +712,40 @@ void HiseAudioThumbnail::LoadingThread::run()
 			const float* data = r->buffer.getReadPointer(0);
 			const int numSamples = r->size;
 
-			scalePathFromLevels(rPath, { 0.0f, h, (float)bounds.getWidth(), h }, data, numSamples);
+			calculatePath(rPath, width, data, numSamples);
 		}
 	}
 
+	auto getLevels = [&](int channelIndex)
+	{
+		if (usePyramid)
+		{
+			auto peak = pyramid->getTotalPeak(channelIndex);
+			return Range<float>(peak.minValue, peak.maxValue);
+		}
+
+		auto b = channelIndex == 0 ? l : r;
+
+		if (b == nullptr || b->size == 0)
+			return Range<float>();
+
+		return FloatVectorOperations::findMinAndMax(b->buffer.getReadPointer(0), b->size);
+	};
+	
+	const bool isMono = rPath.isEmpty();
+
+	if (isMono)
+	{
+		scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), (float)bounds.getHeight() }, getLevels(0));
+	}
+	else
+	{
+		float h = (float)bounds.getHeight() / 2.0f;
+
+		scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), h }, getLevels(0));
+		scalePathFromLevels(rPath, { 0.0f, h, (float)bounds.getWidth(), h }, getLevels(1));
+	}
+
 	{
 		if (parent.get() != nullptr)
 		{
@@ -713,7 +760,7 @@ void HiseAudioThumbnail::LoadingThread::run()
 	}
 }
 
-void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, Rectangle<float> bounds, const float* data, const int numSamples)
+void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, Rectangle<float> bounds, Range<float> levels)
 {
 	if (p.isEmpty())
 		return;
@@ -721,8 +768,6 @@ void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, Rectangle<f
 	if (p.getBounds().getHeight() == 0)
 		return;
 
-	auto levels = FloatVectorOperations::findMinAndMax(data, numSamples);
-
 	if (levels.isEmpty())
 	{
 		p.clear();
@@ -793,6 +838,55 @@ void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, cons
 	}
 }
 
+void HiseAudioThumbnail::LoadingThread::calculatePathFromPyramid(Path &p, float width, const PeakPyramid& pyramid, int channelIndex)
+{
+	const int64 numSamples = pyramid.getNumSamples();
+
+	p.clear();
+
+	if (numSamples == 0)
+		return;
+
+	int64 stride = roundToInt((double)numSamples / (double)jmax<float>(1.0f, width));
+	stride = jmax<int64>(1, stride * 2);
+
+	const int levelIndex = pyramid.getLevelForSamplesPerPixel((double)stride);
+
+	p.startNewSubPath(0.0f, 0.0f);
+
+	for (int64 i = stride; i < numSamples; i += stride)
+	{
+		if (threadShouldExit())
+			return;
+
+		auto peak = pyramid.getPeak(channelIndex, levelIndex, { i, jmin<int64>(i + stride, numSamples) });
+		auto value = jlimit<float>(0.0f, 1.0f, peak.maxValue);
+
+		p.lineTo((float)i, -1.0f * value);
+	}
+
+	for (int64 i = numSamples - 1; i >= 0; i -= stride)
+	{
+		if (threadShouldExit())
+			return;
+
+		auto peak = pyramid.getPeak(channelIndex, levelIndex, { i, jmin<int64>(i + stride, numSamples) });
+		auto value = jlimit<float>(-1.0f, 0.0f, peak.minValue);
+
+		p.lineTo((float)i, -1.0f * value);
+	}
+
+	p.closeSubPath();
+}
+
+bool HiseAudioThumbnail::LoadingThread::shouldUsePyramid(int64 numSamples, float width)
+{
+	if (width <= 0.0f)
+		return false;
+
+	return (double)numSamples / (double)width * 2.0 >= (double)HISE_PEAK_CACHE_BASE_BLOCK_SIZE;
+}
+
 HiseAudioThumbnail::HiseAudioThumbnail() :
 	loadingThread(this)
 {
@@ -820,6 +914,7 @@ void HiseAudioThumbnail::setBuffer(var bufferL, var bufferR /*= var()*/)
 
 	lBuffer = bufferL;
 	rBuffer = bufferR;
+	pyramid = nullptr;
 
 	if (auto l = bufferL.getBuffer())
 	{
@@ -870,7 +965,7 @@ void HiseAudioThumbnail::paint(Graphics& g)
 
 void HiseAudioThumbnail::drawSection(Graphics &g, bool enabled)
 {
-	bool isStereo = rBuffer.isBuffer();
+	bool isStereo = rBuffer.isBuffer() || (pyramid != nullptr && pyramid->getNumChannels() > 1);
 
 	Colour fillColour = findColour(AudioDisplayComponent::ColourIds::fillColour);
 	Colour outlineColour = findColour(AudioDisplayComponent::ColourIds::outlineColour);
@@ -925,9 +1020,15 @@ void HiseAudioThumbnail::drawSection(Graphics &g, bool enabled)
 	}
 }
 
-void HiseAudioThumbnail::setReader(AudioFormatReader* r, int64 actualNumSamples)
+void HiseAudioThumbnail::setReader(AudioFormatReader* r, int64 actualNumSamples, const String& newPeakCacheKey)
 {
-	currentReader = r;
+	{
+		ScopedLock sl(lock);
+
+		currentReader = r;
+		peakCacheKey = newPeakCacheKey;
+		pyramid = nullptr;
+	}
 
 	if (actualNumSamples == -1)
 		actualNumSamples = currentReader->lengthInSamples;
@@ -953,6 +1054,8 @@ void HiseAudioThumbnail::clear()
 	isClear = true;
 
 	currentReader = nullptr;
+	peakCacheKey = String();
+	pyramid = nullptr;
 
 	repaint();
 }
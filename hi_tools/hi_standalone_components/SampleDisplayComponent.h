@@ -51,6 +51,14 @@ class HiseAudioThumbnail: public Component,
 {
 public:
 
+	/** Shorter samples are always read directly.
+	*
+	*	A pyramid can only be drawn if one pixel covers at least one entry of its first level, so for these
+	*	samples it would only be used in views that are narrower than 256 pixels (and reading them is cheap).
+	*	Longer samples use the PeakCache if the view is small enough for the first level (see shouldUsePyramid()).
+	*/
+	static constexpr int64 MinNumSamplesForPeakCache = HISE_PEAK_CACHE_BASE_BLOCK_SIZE * 128;
+
 	static Image createPreview(const AudioSampleBuffer* buffer, int width)
 	{
 		jassert(buffer != nullptr);
@@ -97,7 +105,12 @@ public:
 		return lengthInSeconds;
 	}
 	
-	void setReader(AudioFormatReader* r, int64 actualNumSamples=-1);
+	/** Sets a reader that will be used to create the waveform on a background thread.
+	*
+	*	If you pass in a key for the PeakCache (and the sample is long enough), the waveform will be
+	*	created from the cached peaks instead of reading the whole sample again.
+	*/
+	void setReader(AudioFormatReader* r, int64 actualNumSamples=-1, const String& peakCacheKey=String());
 
 	void clear();
 
@@ -164,16 +177,21 @@ private:
 
 		void run() override;;
 
-		void scalePathFromLevels(Path &lPath, Rectangle<float> bounds, const float* data, const int numSamples);
+		void scalePathFromLevels(Path &lPath, Rectangle<float> bounds, Range<float> levels);
 
 		void calculatePath(Path &p, float width, const float* l_, int numSamples);
 
-	private:
+		void calculatePathFromPyramid(Path &p, float width, const PeakPyramid& pyramid, int channelIndex);
 
-		
+		/** Checks if the waveform would be drawn with less detail than the first level of the pyramid. */
+		static bool shouldUsePyramid(int64 numSamples, float width);
+
+	private:
 
 		WeakReference<HiseAudioThumbnail> parent;
 
+		SharedResourcePointer<PeakCache> peakCache;
+
 	};
 
 	JUCE_DECLARE_WEAK_REFERENCEABLE(HiseAudioThumbnail);
@@ -183,6 +201,8 @@ private:
 	LoadingThread loadingThread;
 
 	ScopedPointer<AudioFormatReader> currentReader;
+	String peakCacheKey;
+	PeakPyramid::Ptr pyramid;
 
 	ScopedPointer<ScrollBar> scrollBar;
 
@@ -54,6 +54,8 @@
 #include "hi_tools/IppFFT.cpp"
 #endif
 
+#include "hi_tools/SimdFFT.cpp"
+
 #include "hi_tools/CustomDataContainers.cpp"
 #include "hi_tools/HiseEventBuffer.cpp"
 
@@ -69,6 +71,7 @@
 #include "hi_tools/VariantBuffer.cpp"
 #include "hi_tools/Tables.cpp"
 
+#include "hi_standalone_components/PeakCache.cpp"
 #include "hi_standalone_components/SampleDisplayComponent.cpp"
 
 #include "hi_standalone_components/VuMeter.cpp"
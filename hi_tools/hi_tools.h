@@ -97,6 +97,8 @@ END_JUCE_MODULE_DECLARATION
 #include "hi_tools/IppFFT.h"
 #endif
 
+#include "hi_tools/SimdFFT.h"
+
 
 #include "hi_tools/Markdown.h"
 
@@ -110,5 +112,6 @@ END_JUCE_MODULE_DECLARATION
 #include "hi_standalone_components/TableEditor.h"
 
 #include "hi_standalone_components/VuMeter.h"
+#include "hi_standalone_components/PeakCache.h"
 #include "hi_standalone_components/SampleDisplayComponent.h"
 
@@ -254,12 +254,25 @@ void HiseEvent::setSongPositionValue(int positionInMidiBeats)
 	value = (positionInMidiBeats >> 7) & 127;
 }
 
-HiseEventBuffer::HiseEventBuffer()
+HiseEventBuffer::HiseEventBuffer():
+	buffer(preallocatedStorage)
 {
 	numUsed = HISE_EVENT_BUFFER_SIZE;
 	clear();
 }
 
+HiseEventBuffer::HiseEventBuffer(const HiseEventBuffer& other):
+	HiseEventBuffer()
+{
+	copyFrom(other);
+}
+
+HiseEventBuffer& HiseEventBuffer::operator=(const HiseEventBuffer& other)
+{
+	copyFrom(other);
+	return *this;
+}
+
 void HiseEventBuffer::clear()
 {
 	if (numUsed != 0)
@@ -272,36 +285,34 @@ void HiseEventBuffer::clear()
 
 void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
 {
-	if (numUsed >= HISE_EVENT_BUFFER_SIZE)
-	{
-		// Buffer full..
-		jassertfalse;
-		return;
-	}
+	if (numUsed >= numAllocated)
+		ensureAllocatedSize(numUsed + 1);
 
-	if (numUsed == 0)
+	const uint16 messageTimestamp = hiseEvent.getTimeStamp();
+
+	// Most events are added in order, so check the end of the buffer first
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= messageTimestamp)
 	{
-		insertEventAtPosition(hiseEvent, 0);
+		buffer[numUsed++] = HiseEvent(hiseEvent);
 		return;
 	}
 
-	jassert(numUsed < HISE_EVENT_BUFFER_SIZE);
+	// Look for the first event with a bigger timestamp so that
+	// events with the same timestamp keep their order
+	int start = 0;
+	int end = numUsed - 1;
 
-    const int numToLookFor = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	for (int i = 0; i < numToLookFor; i++)
+	while (start < end)
 	{
-		const int timestampInBuffer = buffer[i].getTimeStamp();
-		const int messageTimestamp = hiseEvent.getTimeStamp();
+		const int middle = (start + end) / 2;
 
-		if (timestampInBuffer > messageTimestamp)
-		{
-			insertEventAtPosition(hiseEvent, i);
-			return;
-		}
+		if (buffer[middle].getTimeStamp() > messageTimestamp)
+			end = middle;
+		else
+			start = middle + 1;
 	}
 
-	insertEventAtPosition(hiseEvent, numUsed);
+	insertEventAtPosition(hiseEvent, start);
 }
 
 void HiseEventBuffer::addEvent(const MidiMessage& midiMessage, int sampleNumber)
@@ -319,32 +330,17 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 	MidiMessage m;
 	int samplePos;
 
-	int index = 0;
-
 	MidiBuffer::Iterator it(otherBuffer);
 
 	while (it.getNextEvent(m, samplePos))
 	{
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
-
 		HiseEvent e(m);
 
 		if (e.isEmpty()) continue;
 
-		e.swapWith(buffer[index]);
-
-		buffer[index].setTimeStamp(samplePos);
-
-		numUsed++;
-
-		if (numUsed >= HISE_EVENT_BUFFER_SIZE)
-		{
-			// Buffer full..
-			jassertfalse;
-			return;
-		}
+		e.setTimeStamp(samplePos);
 
-		index++;
+		addEvent(e);
 	}
 }
 
@@ -400,7 +396,7 @@ uint16 HiseEventBuffer::getMaxTimeStamp() const
 
 HiseEvent HiseEventBuffer::getEvent(int index) const
 {
-	if (index >= 0 && index < HISE_EVENT_BUFFER_SIZE)
+	if (index >= 0 && index < numAllocated)
 	{
 		return buffer[index];
 	}
@@ -450,8 +446,7 @@ void HiseEventBuffer::moveEventsBelow(HiseEventBuffer& targetBuffer, int highest
 
 	const int numRemaining = numUsed - numCopied;
 
-	for (int i = 0; i < numRemaining; i++)
-		buffer[i] = buffer[i + numCopied];
+	memmove((void*)buffer, (const void*)(buffer + numCopied), sizeof(HiseEvent) * numRemaining);
 
 	HiseEvent::clear(buffer + numRemaining, numCopied);
 
@@ -491,11 +486,15 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 
 void HiseEventBuffer::copyFrom(const HiseEventBuffer& otherBuffer)
 {
-    const int eventsToCopy = jmin<int>(otherBuffer.numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	memcpy(buffer, otherBuffer.buffer, sizeof(HiseEvent) * eventsToCopy);
+	if (&otherBuffer == this)
+		return;
+
+	ensureAllocatedSize(otherBuffer.numUsed);
 
-	jassert(otherBuffer.numUsed < HISE_EVENT_BUFFER_SIZE);
+	memcpy(buffer, otherBuffer.buffer, sizeof(HiseEvent) * otherBuffer.numUsed);
+
+	if (numUsed > otherBuffer.numUsed)
+		HiseEvent::clear(buffer + otherBuffer.numUsed, numUsed - otherBuffer.numUsed);
 
 	numUsed = otherBuffer.numUsed;
 }
@@ -515,7 +514,7 @@ bool HiseEventBuffer::Iterator::getNextEvent(HiseEvent& b, int &samplePosition,
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index <= buffer->numUsed);
 	}
 		
 	if (index < buffer->numUsed)
@@ -546,7 +545,7 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index <= buffer->numUsed);
 	}
 
 	if (index < buffer->numUsed)
@@ -562,34 +561,35 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 
 void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBuffer)
 {
-	if (numUsed == 0)
-	{
-		buffer[0] = HiseEvent(e);
+	jassert(isPositiveAndNotGreaterThan(positionInBuffer, numUsed));
+
+	if (numUsed >= numAllocated)
+		ensureAllocatedSize(numUsed + 1);
+
+	if (numUsed > positionInBuffer)
+		memmove((void*)(buffer + positionInBuffer + 1), (const void*)(buffer + positionInBuffer), sizeof(HiseEvent) * (numUsed - positionInBuffer));
 
-		numUsed = 1;
+	buffer[positionInBuffer] = HiseEvent(e);
+	numUsed++;
+}
 
+void HiseEventBuffer::ensureAllocatedSize(int numToAllocate)
+{
+	if (numToAllocate <= numAllocated)
 		return;
-	}
 
-	if (numUsed > positionInBuffer)
-	{
-		for (int i = jmin<int>(numUsed-1, HISE_EVENT_BUFFER_SIZE-2); i >= positionInBuffer; i--)
-		{
-			jassert(i + 1 < HISE_EVENT_BUFFER_SIZE);
+	// This allocates if it happens in the audio thread, but it's better than dropping
+	// the events. The storage is kept, so a dense event stream only causes this once.
+	const int newSize = jmax<int>(numToAllocate, numAllocated * 2);
 
-			buffer[i + 1] = buffer[i];
-		}
-	}
+	HeapBlock<HiseEvent> newStorage;
+	newStorage.calloc(newSize);
+
+	memcpy((void*)newStorage.get(), (const void*)buffer, sizeof(HiseEvent) * numUsed);
 
-    if(positionInBuffer < HISE_EVENT_BUFFER_SIZE)
-    {
-        buffer[positionInBuffer] = HiseEvent(e);
-        numUsed++;
-    }
-    else
-    {
-        jassertfalse;
-    }
+	overflowStorage.swapWith(newStorage);
+	buffer = overflowStorage.get();
+	numAllocated = newSize;
 }
 
 
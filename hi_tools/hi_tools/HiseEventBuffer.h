@@ -462,10 +462,20 @@ private:
 	bool artificial = false;
 };
 
-#define HISE_EVENT_BUFFER_SIZE 256
+/** The number of events that fit into the preallocated storage of a HiseEventBuffer. */
+#ifndef HISE_EVENT_BUFFER_SIZE
+#define HISE_EVENT_BUFFER_SIZE 512
+#endif
 
 /** The buffer type for the HiseEvent.
 
+	The events are kept sorted by their timestamp (events with the same timestamp stay in the
+	order they were added). Appending an event that is not earlier than the last one is a
+	constant time operation, so the usual case of adding MIDI input or generated notes in
+	order doesn't need to scan the buffer.
+
+	If more than HISE_EVENT_BUFFER_SIZE events are added, the buffer moves its events to a
+	bigger heap storage instead of dropping them.
 */
 class HiseEventBuffer
 {
@@ -576,6 +586,10 @@ public:
 
 	HiseEventBuffer();
 
+	HiseEventBuffer(const HiseEventBuffer& other);
+
+	HiseEventBuffer& operator=(const HiseEventBuffer& other);
+
 	bool operator==(const HiseEventBuffer& other)
 	{
 		if (other.getNumUsed() != numUsed) return false;
@@ -609,6 +623,9 @@ public:
 	/** Returns the number of events in this buffer. */
 	int getNumUsed() const { return numUsed; }
 
+	/** Returns the number of events that can be stored without reallocating. */
+	int getNumAllocated() const noexcept { return numAllocated; }
+
 	HiseEvent getEvent(int index) const;
 
 	void subtractFromTimeStamps(int delta);
@@ -698,7 +715,14 @@ private:
 
 	void insertEventAtPosition(const HiseEvent& e, int positionInBuffer);
 
-	HiseEvent buffer[HISE_EVENT_BUFFER_SIZE];
+	/** Moves the events to a bigger heap storage if the preallocated one is too small. */
+	void ensureAllocatedSize(int numToAllocate);
+
+	HiseEvent* buffer;
+	int numAllocated = HISE_EVENT_BUFFER_SIZE;
+
+	HeapBlock<HiseEvent> overflowStorage;
+	HiseEvent preallocatedStorage[HISE_EVENT_BUFFER_SIZE];
 
 	int numUsed = 0;
 };
@@ -0,0 +1,569 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace SimdFFTHelpers
+{
+
+struct ScalarOps
+{
+	using Type = float;
+
+	static constexpr int NumLanes = 1;
+
+	static float load(const float* p) { return *p; }
+	static void store(float* p, float v) { *p = v; }
+	static float expand(float v) { return v; }
+};
+
+struct VectorOps
+{
+	using Type = dsp::SIMDRegister<float>;
+
+	static constexpr int NumLanes = (int)dsp::SIMDRegister<float>::SIMDNumElements;
+
+	static Type load(const float* p) { return Type::fromRawArray(p); }
+	static void store(float* p, Type v) { v.copyToRawArray(p); }
+	static Type expand(float v) { return Type::expand(v); }
+};
+
+/** One radix-4 butterfly for numLanes consecutive values with the stride s.
+*
+*	The input values are x[i + k * quarter] and the output is written to y[o + k * s].
+*/
+template <bool inverse, class Ops> static forcedinline void radix4(const float* xr, const float* xi, float* yr, float* yi, int i, int o, int quarter, int s, const float* w)
+{
+	using T = typename Ops::Type;
+
+	const T ar = Ops::load(xr + i);
+	const T ai = Ops::load(xi + i);
+	const T br = Ops::load(xr + i + quarter);
+	const T bi = Ops::load(xi + i + quarter);
+	const T cr = Ops::load(xr + i + 2 * quarter);
+	const T ci = Ops::load(xi + i + 2 * quarter);
+	const T dr = Ops::load(xr + i + 3 * quarter);
+	const T di = Ops::load(xi + i + 3 * quarter);
+
+	const T apcr = ar + cr;
+	const T apci = ai + ci;
+	const T amcr = ar - cr;
+	const T amci = ai - ci;
+	const T bpdr = br + dr;
+	const T bpdi = bi + di;
+	const T bmdr = br - dr;
+	const T bmdi = bi - di;
+
+	// The inverse transform uses +j instead of -j for the odd outputs
+	const T t1r = inverse ? amcr - bmdi : amcr + bmdi;
+	const T t1i = inverse ? amci + bmdr : amci - bmdr;
+	const T t3r = inverse ? amcr + bmdi : amcr - bmdi;
+	const T t3i = inverse ? amci - bmdr : amci + bmdr;
+	const T t2r = apcr - bpdr;
+	const T t2i = apci - bpdi;
+
+	// the inverse transform uses the conjugated twiddles
+	const T w1r = Ops::expand(w[0]);
+	const T w1i = Ops::expand(inverse ? -w[1] : w[1]);
+	const T w2r = Ops::expand(w[2]);
+	const T w2i = Ops::expand(inverse ? -w[3] : w[3]);
+	const T w3r = Ops::expand(w[4]);
+	const T w3i = Ops::expand(inverse ? -w[5] : w[5]);
+
+	Ops::store(yr + o, apcr + bpdr);
+	Ops::store(yi + o, apci + bpdi);
+	Ops::store(yr + o + s, t1r * w1r - t1i * w1i);
+	Ops::store(yi + o + s, t1r * w1i + t1i * w1r);
+	Ops::store(yr + o + 2 * s, t2r * w2r - t2i * w2i);
+	Ops::store(yi + o + 2 * s, t2r * w2i + t2i * w2r);
+	Ops::store(yr + o + 3 * s, t3r * w3r - t3i * w3i);
+	Ops::store(yi + o + 3 * s, t3r * w3i + t3i * w3r);
+}
+
+template <class Ops> static forcedinline void radix2(const float* xr, const float* xi, float* yr, float* yi, int q, int s)
+{
+	using T = typename Ops::Type;
+
+	const T ar = Ops::load(xr + q);
+	const T ai = Ops::load(xi + q);
+	const T br = Ops::load(xr + q + s);
+	const T bi = Ops::load(xi + q + s);
+
+	Ops::store(yr + q, ar + br);
+	Ops::store(yi + q, ai + bi);
+	Ops::store(yr + q + s, ar - br);
+	Ops::store(yi + q + s, ai - bi);
+}
+
+template <bool inverse> static void radix4Pass(const float* xr, const float* xi, float* yr, float* yi, int n, int s, const float* twiddles)
+{
+	constexpr int NumLanes = VectorOps::NumLanes;
+
+	const int m = n / 4;
+	const int quarter = s * m;
+
+	for (int p = 0; p < m; p++)
+	{
+		const float* w = twiddles + 6 * p;
+		const int i = s * p;
+		const int o = 4 * s * p;
+
+		if (s >= NumLanes)
+		{
+			for (int q = 0; q < s; q += NumLanes)
+				radix4<inverse, VectorOps>(xr, xi, yr, yi, i + q, o + q, quarter, s, w);
+		}
+		else
+		{
+			for (int q = 0; q < s; q++)
+				radix4<inverse, ScalarOps>(xr, xi, yr, yi, i + q, o + q, quarter, s, w);
+		}
+	}
+}
+
+static void radix2Pass(const float* xr, const float* xi, float* yr, float* yi, int s)
+{
+	constexpr int NumLanes = VectorOps::NumLanes;
+
+	if (s >= NumLanes)
+	{
+		for (int q = 0; q < s; q += NumLanes)
+			radix2<VectorOps>(xr, xi, yr, yi, q, s);
+	}
+	else
+	{
+		for (int q = 0; q < s; q++)
+			radix2<ScalarOps>(xr, xi, yr, yi, q, s);
+	}
+}
+
+static int getPaddedSize(int numElements)
+{
+	constexpr int alignment = 64 / (int)sizeof(float);
+	return ((numElements + alignment - 1) / alignment) * alignment;
+}
+
+}
+
+SimdFFT::Plan::Plan(int order)
+{
+	const int N = 1 << order;
+
+	int numTwiddles = 0;
+	int n = N;
+	int s = 1;
+
+	while (n >= 4)
+	{
+		stages.add({ 4, n, s, numTwiddles });
+		numTwiddles += 6 * (n / 4);
+		n /= 4;
+		s *= 4;
+	}
+
+	if (n == 2)
+		stages.add({ 2, n, s, 0 });
+
+	twiddles.calloc(jmax(1, numTwiddles));
+
+	for (const auto& stage : stages)
+	{
+		if (stage.radix != 4)
+			continue;
+
+		auto w = twiddles.get() + stage.twiddleOffset;
+
+		for (int p = 0; p < stage.n / 4; p++)
+		{
+			for (int k = 1; k <= 3; k++)
+			{
+				const double angle = -2.0 * double_Pi * (double)(k * p) / (double)stage.n;
+				w[6 * p + 2 * (k - 1)] = (float)std::cos(angle);
+				w[6 * p + 2 * (k - 1) + 1] = (float)std::sin(angle);
+			}
+		}
+	}
+
+	// The real FFT with the size 2N uses this complex FFT
+	const int realSize = 2 * N;
+
+	realCos.calloc(N);
+	realSin.calloc(N);
+
+	for (int i = 0; i < N; i++)
+	{
+		const double angle = 2.0 * double_Pi * (double)i / (double)realSize;
+		realCos[i] = (float)std::cos(angle);
+		realSin[i] = (float)-std::sin(angle);
+	}
+}
+
+SimdFFT::SimdFFT(DataType typeToUse, int maxPowerOfTwo /*= SIMD_FFT_MAX_POWER_OF_TWO*/, const int flagToUse /*= NoScaling*/) :
+	type(typeToUse),
+	maxOrder(jmax<int>(1, maxPowerOfTwo)),
+	flag(flagToUse)
+{
+	jassert(type == DataType::ComplexFloat || type == DataType::RealFloat);
+
+	for (int i = 0; i < maxOrder; i++)
+		plans.add(new Plan(i));
+
+	const int complexSize = 1 << (maxOrder - 1);
+	const int bufferSize = SimdFFTHelpers::getPaddedSize(complexSize + 1);
+	const int alignmentPadding = SimdFFTHelpers::getPaddedSize(1);
+
+	bufferData.calloc(6 * bufferSize + alignmentPadding);
+
+	auto start = dsp::SIMDRegister<float>::getNextSIMDAlignedPtr(bufferData.get());
+
+	bufferRe = start;
+	bufferIm = start + bufferSize;
+	workRe = start + 2 * bufferSize;
+	workIm = start + 3 * bufferSize;
+	spectrumRe = start + 4 * bufferSize;
+	spectrumIm = start + 5 * bufferSize;
+}
+
+SimdFFT::~SimdFFT()
+{
+	plans.clear();
+}
+
+int SimdFFT::getPowerOfTwo(int size) const
+{
+	jassert(isPowerOfTwo(size));
+
+	const int order = roundToInt(log2((double)size));
+
+	if (order < maxOrder)
+		return order;
+
+	// increase the maxPowerOfTwo in the constructor
+	jassertfalse;
+	return -1;
+}
+
+float SimdFFT::getScaleFactor(bool forward, int size) const
+{
+	if (flag == DivideBySqrtN)
+		return 1.0f / std::sqrt((float)size);
+
+	if ((forward && flag == DivideForwardByN) || (!forward && flag == DivideInverseByN))
+		return 1.0f / (float)size;
+
+	return 1.0f;
+}
+
+template <bool inverse> void SimdFFT::performComplex(int order, float*& re, float*& im) const
+{
+	float* xr = bufferRe;
+	float* xi = bufferIm;
+	float* yr = workRe;
+	float* yi = workIm;
+
+	const auto& plan = *plans[order];
+
+	for (const auto& stage : plan.stages)
+	{
+		if (stage.radix == 4)
+			SimdFFTHelpers::radix4Pass<inverse>(xr, xi, yr, yi, stage.n, stage.stride, plan.twiddles.get() + stage.twiddleOffset);
+		else
+			SimdFFTHelpers::radix2Pass(xr, xi, yr, yi, stage.stride);
+
+		std::swap(xr, yr);
+		std::swap(xi, yi);
+	}
+
+	re = xr;
+	im = xi;
+}
+
+void SimdFFT::realForward(const float* in, int order) const
+{
+	// Calculate the real FFT with N samples as complex FFT of z[k] = x[2k] + i * x[2k+1]
+	const int M = 1 << (order - 1);
+
+	for (int i = 0; i < M; i++)
+	{
+		bufferRe[i] = in[2 * i];
+		bufferIm[i] = in[2 * i + 1];
+	}
+
+	float* zr;
+	float* zi;
+
+	performComplex<false>(order - 1, zr, zi);
+
+	const auto& plan = *plans[order - 1];
+
+	spectrumRe[0] = zr[0] + zi[0];
+	spectrumIm[0] = 0.0f;
+	spectrumRe[M] = zr[0] - zi[0];
+	spectrumIm[M] = 0.0f;
+
+	for (int j = 1; j <= M / 2; j++)
+	{
+		const int k = M - j;
+
+		// the spectrum of the even samples
+		const float er = 0.5f * (zr[j] + zr[k]);
+		const float ei = 0.5f * (zi[j] - zi[k]);
+
+		// the spectrum of the odd samples
+		const float orr = 0.5f * (zi[j] + zi[k]);
+		const float oi = -0.5f * (zr[j] - zr[k]);
+
+		const float wr = plan.realCos[j];
+		const float wi = plan.realSin[j];
+
+		const float tr = orr * wr - oi * wi;
+		const float ti = orr * wi + oi * wr;
+
+		spectrumRe[j] = er + tr;
+		spectrumIm[j] = ei + ti;
+		spectrumRe[k] = er - tr;
+		spectrumIm[k] = ti - ei;
+	}
+
+	const float gain = getScaleFactor(true, 2 * M);
+
+	if (gain != 1.0f)
+	{
+		FloatVectorOperations::multiply(spectrumRe, gain, M + 1);
+		FloatVectorOperations::multiply(spectrumIm, gain, M + 1);
+	}
+}
+
+void SimdFFT::realInverse(float* out, int order) const
+{
+	const int M = 1 << (order - 1);
+	const auto& plan = *plans[order - 1];
+
+	const float x0 = spectrumRe[0];
+	const float xM = spectrumRe[M];
+
+	bufferRe[0] = x0 + xM;
+	bufferIm[0] = x0 - xM;
+
+	for (int j = 1; j <= M / 2; j++)
+	{
+		const int k = M - j;
+
+		const float er = spectrumRe[j] + spectrumRe[k];
+		const float ei = spectrumIm[j] - spectrumIm[k];
+		const float dr = spectrumRe[j] - spectrumRe[k];
+		const float di = spectrumIm[j] + spectrumIm[k];
+
+		// multiply with the conjugated twiddle
+		const float wr = plan.realCos[j];
+		const float wi = -plan.realSin[j];
+
+		const float orr = dr * wr - di * wi;
+		const float oi = dr * wi + di * wr;
+
+		bufferRe[j] = er - oi;
+		bufferIm[j] = ei + orr;
+		bufferRe[k] = er + oi;
+		bufferIm[k] = orr - ei;
+	}
+
+	float* zr;
+	float* zi;
+
+	performComplex<true>(order - 1, zr, zi);
+
+	const float gain = getScaleFactor(false, 2 * M);
+
+	for (int i = 0; i < M; i++)
+	{
+		out[2 * i] = gain * zr[i];
+		out[2 * i + 1] = gain * zi[i];
+	}
+}
+
+void SimdFFT::realFFTInplace(float *data, int size) const
+{
+	realFFT(data, data, size);
+}
+
+void SimdFFT::realFFTInverseInplace(float *data, int size) const
+{
+	realFFTInverse(data, data, size);
+}
+
+void SimdFFT::complexFFTInplace(float *data, int size) const
+{
+	complexFFT(data, data, size);
+}
+
+void SimdFFT::complexFFTInverseInplace(float *data, int size) const
+{
+	complexFFTInverse(data, data, size);
+}
+
+void SimdFFT::realFFT(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		realForward(in, N);
+
+		const int M = size / 2;
+
+		out[0] = spectrumRe[0];
+		out[1] = spectrumRe[M];
+
+		for (int i = 1; i < M; i++)
+		{
+			out[2 * i] = spectrumRe[i];
+			out[2 * i + 1] = spectrumIm[i];
+		}
+	}
+}
+
+void SimdFFT::realFFTInverse(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		const int M = size / 2;
+
+		spectrumRe[0] = in[0];
+		spectrumIm[0] = 0.0f;
+		spectrumRe[M] = in[1];
+		spectrumIm[M] = 0.0f;
+
+		for (int i = 1; i < M; i++)
+		{
+			spectrumRe[i] = in[2 * i];
+			spectrumIm[i] = in[2 * i + 1];
+		}
+
+		realInverse(out, N);
+	}
+}
+
+void SimdFFT::realFFTSplit(const float* in, float* re, float* im, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		realForward(in, N);
+
+		FloatVectorOperations::copy(re, spectrumRe, size / 2 + 1);
+		FloatVectorOperations::copy(im, spectrumIm, size / 2 + 1);
+	}
+}
+
+void SimdFFT::realFFTInverseSplit(const float* re, const float* im, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		FloatVectorOperations::copy(spectrumRe, re, size / 2 + 1);
+		FloatVectorOperations::copy(spectrumIm, im, size / 2 + 1);
+
+		realInverse(out, N);
+	}
+}
+
+void SimdFFT::complexFFT(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N >= 0)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			bufferRe[i] = in[2 * i];
+			bufferIm[i] = in[2 * i + 1];
+		}
+
+		float* re;
+		float* im;
+
+		performComplex<false>(N, re, im);
+
+		const float gain = getScaleFactor(true, size);
+
+		for (int i = 0; i < size; i++)
+		{
+			out[2 * i] = gain * re[i];
+			out[2 * i + 1] = gain * im[i];
+		}
+	}
+}
+
+void SimdFFT::complexFFTInverse(const float* in, float *out, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N >= 0)
+	{
+		for (int i = 0; i < size; i++)
+		{
+			bufferRe[i] = in[2 * i];
+			bufferIm[i] = in[2 * i + 1];
+		}
+
+		float* re;
+		float* im;
+
+		performComplex<true>(N, re, im);
+
+		const float gain = getScaleFactor(false, size);
+
+		for (int i = 0; i < size; i++)
+		{
+			out[2 * i] = gain * re[i];
+			out[2 * i + 1] = gain * im[i];
+		}
+	}
+}
+
+} // namespace hise
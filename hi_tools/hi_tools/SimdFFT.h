@@ -0,0 +1,199 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+#ifndef SIMDFFT_H_INCLUDED
+#define SIMDFFT_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+#define SIMD_FFT_MAX_POWER_OF_TWO 16
+
+
+/** A vectorised FFT that is used when IPP is not available.
+*
+*	It uses a Stockham autosort algorithm with radix-4 passes (and a radix-2 pass for odd orders)
+*	on split complex data. Every pass with a stride that is at least the SIMD register width
+*	runs on dsp::SIMDRegister<float>, so it uses SSE, AVX or NEON depending on the platform.
+*	Real FFTs are calculated as complex FFT with half the size.
+*
+*	It has the same interface and data layout as IppFFT, so it can be used as drop-in replacement
+*	(use the FFTImplementation alias if you don't care about the backend):
+*
+*	SimdFFT fft(SimdFFT::DataType::RealFloat);
+*
+*	fft.realFFTInplace(data, 512);
+*
+*	Only float data and power of two sizes are supported. Like with IppFFT, all buffers are
+*	allocated in the constructor and the biggest size is 2^(maxPowerOfTwo-1).
+*/
+class SimdFFT
+{
+public:
+
+	enum class DataType
+	{
+		ComplexFloat = 0,
+		ComplexDouble,
+		RealFloat,
+		RealDouble
+	};
+
+	/** The scaling flags (they have the same values as the IPP flags). */
+	enum Scaling
+	{
+		DivideForwardByN = 1,
+		DivideInverseByN = 2,
+		DivideBySqrtN = 4,
+		NoScaling = 8
+	};
+
+	/** Below this size the SIMD FFT isn't reliably faster than the scalar Ooura FFT (with SSE it measured
+	*	between 0.6x and 1.3x up to 256 samples), so the callers that have the Ooura routines use them instead.
+	*/
+	static constexpr int MinSizeForVectorisation = 512;
+
+	// =============================================================================================================================
+
+	SimdFFT(DataType typeToUse = DataType::ComplexFloat, int maxPowerOfTwo = SIMD_FFT_MAX_POWER_OF_TWO, const int flagToUse = NoScaling);
+	~SimdFFT();
+
+	// ==================================================================================================================================== float FFTs
+
+	/** Real inplace FFT (size is power of two.)
+	*
+	*	Input: d[] = re[0],re[1],..,re[size-1].
+	*	Output: d[] = re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1].
+	*/
+	void realFFTInplace(float *data, int size) const;
+
+	/** Real inplace inverse FFT (size is power of two.) */
+	void realFFTInverseInplace(float *data, int size) const;
+
+	/** Complex inplace FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFTInplace(float *data, int size) const;
+
+	/** Complex inverse inplace FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFTInverseInplace(float *data, int size) const;
+
+	/** Real FFT (same format as realFFTInplace). */
+	void realFFT(const float *in, float* out, int size) const;
+
+	/** Real inverse FFT (same format as realFFTInverseInplace). */
+	void realFFTInverse(const float *in, float* out, int size) const;
+
+	/** Complex FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFT(const float *in, float* out, int size) const;
+
+	/** Complex inverse FFT (input is a Complex<float> array, size is power of two.) */
+	void complexFFTInverse(const float* in, float *out, int size) const;
+
+	// ==================================================================================================================================== split complex FFTs
+
+	/** Real FFT with split complex output. re and im must have size/2+1 elements (DC to Nyquist). */
+	void realFFTSplit(const float* in, float* re, float* im, int size) const;
+
+	/** Real inverse FFT with split complex input. re and im must have size/2+1 elements (DC to Nyquist). */
+	void realFFTInverseSplit(const float* re, const float* im, float* out, int size) const;
+
+private:
+
+	// =============================================================================================================================
+
+	struct Stage
+	{
+		int radix;
+		int n;
+		int stride;
+		int twiddleOffset;
+	};
+
+	/** The twiddles for a complex FFT with the given order and a real FFT with the double size. */
+	struct Plan
+	{
+		Plan(int order);
+
+		Array<Stage> stages;
+		HeapBlock<float> twiddles;
+
+		/** cos(2*PI*i/N) and -sin(2*PI*i/N) for i < N/2 with N being the real size. */
+		HeapBlock<float> realCos;
+		HeapBlock<float> realSin;
+	};
+
+	// =============================================================================================================================
+
+	/** @internal */
+	int getPowerOfTwo(int size) const;
+
+	/** @internal Runs the complex FFT on bufferRe / bufferIm and sets the pointers to the buffers that contain the result. */
+	template <bool inverse> void performComplex(int order, float*& re, float*& im) const;
+
+	/** @internal Calculates the spectrum of the real input into spectrumRe / spectrumIm. */
+	void realForward(const float* in, int order) const;
+
+	/** @internal Calculates the real signal from spectrumRe / spectrumIm. */
+	void realInverse(float* out, int order) const;
+
+	/** @internal */
+	float getScaleFactor(bool forward, int size) const;
+
+	const DataType type;
+	const int maxOrder;
+	const int flag;
+
+	OwnedArray<Plan> plans;
+
+	HeapBlock<float> bufferData;
+
+	float* bufferRe = nullptr;
+	float* bufferIm = nullptr;
+	float* workRe = nullptr;
+	float* workIm = nullptr;
+
+	// the real post processing writes the spectrum here
+	float* spectrumRe = nullptr;
+	float* spectrumIm = nullptr;
+
+	// =============================================================================================================================
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimdFFT)
+};
+
+#if USE_IPP
+using FFTImplementation = IppFFT;
+#else
+/** The FFT that is used by the analysers and the ICST library if IPP is not available. */
+using FFTImplementation = SimdFFT;
+#endif
+
+} // namespace hise
+
+#endif  // SIMDFFT_H_INCLUDED
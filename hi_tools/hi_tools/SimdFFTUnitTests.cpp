@@ -0,0 +1,303 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class SimdFFTUnitTests : public UnitTest
+{
+public:
+
+	SimdFFTUnitTests() :
+		UnitTest("Testing SIMD FFT")
+	{
+
+	}
+
+	void runTest() override
+	{
+		random = getRandom();
+
+		testComplexFFT();
+		testRealFFT();
+		testSplitFFT();
+		testScaling();
+		runBenchmark();
+	}
+
+private:
+
+	Random random;
+
+	using Spectrum = Array<std::complex<double>>;
+
+	static Spectrum calculateDFT(const Spectrum& input, bool inverse)
+	{
+		const int size = input.size();
+		const double sign = inverse ? 1.0 : -1.0;
+
+		Spectrum output;
+
+		for (int k = 0; k < size; k++)
+		{
+			std::complex<double> sum;
+
+			for (int n = 0; n < size; n++)
+			{
+				const double angle = sign * 2.0 * double_Pi * (double)((k * n) % size) / (double)size;
+				sum += input[n] * std::complex<double>(std::cos(angle), std::sin(angle));
+			}
+
+			output.add(sum);
+		}
+
+		return output;
+	}
+
+	/** The error tolerance grows with the magnitude of the output. */
+	static double getTolerance(int size)
+	{
+		return 1e-5 * std::sqrt((double)size) * std::log2((double)size + 1.0) + 1e-6;
+	}
+
+	void fillWithNoise(float* data, int numSamples)
+	{
+		for (int i = 0; i < numSamples; i++)
+			data[i] = random.nextFloat() * 2.0f - 1.0f;
+	}
+
+	void testComplexFFT()
+	{
+		beginTest("Testing complex FFT against the DFT");
+
+		SimdFFT fft(SimdFFT::DataType::ComplexFloat, 13);
+
+		for (int order = 0; order <= 12; order++)
+		{
+			const int size = 1 << order;
+
+			HeapBlock<float> data(2 * size);
+			HeapBlock<float> output(2 * size);
+			fillWithNoise(data, 2 * size);
+
+			Spectrum input;
+
+			for (int i = 0; i < size; i++)
+				input.add({ data[2 * i], data[2 * i + 1] });
+
+			for (int inverse = 0; inverse < 2; inverse++)
+			{
+				auto expected = calculateDFT(input, inverse == 1);
+
+				if (inverse == 1)
+					fft.complexFFTInverse(data, output, size);
+				else
+					fft.complexFFT(data, output, size);
+
+				double maxError = 0.0;
+
+				for (int i = 0; i < size; i++)
+					maxError = jmax(maxError, std::abs(std::complex<double>(output[2 * i], output[2 * i + 1]) - expected[i]));
+
+				expect(maxError < getTolerance(size), "Size " + String(size) + (inverse == 1 ? " inverse" : "") + ", error: " + String(maxError));
+			}
+
+			fft.complexFFTInplace(data, size);
+			fft.complexFFTInverseInplace(data, size);
+
+			double maxError = 0.0;
+
+			for (int i = 0; i < size; i++)
+				maxError = jmax(maxError, std::abs(std::complex<double>(data[2 * i], data[2 * i + 1]) / (double)size - input[i]));
+
+			expect(maxError < 1e-5, "Roundtrip size " + String(size) + ", error: " + String(maxError));
+		}
+	}
+
+	void testRealFFT()
+	{
+		beginTest("Testing real FFT against the DFT");
+
+		SimdFFT fft(SimdFFT::DataType::RealFloat, 13);
+
+		for (int order = 1; order <= 12; order++)
+		{
+			const int size = 1 << order;
+
+			HeapBlock<float> data(size);
+			HeapBlock<float> output(size);
+			fillWithNoise(data, size);
+
+			Spectrum input;
+
+			for (int i = 0; i < size; i++)
+				input.add(data[i]);
+
+			auto expected = calculateDFT(input, false);
+
+			fft.realFFT(data, output, size);
+
+			double maxError = jmax(std::abs(output[0] - expected[0].real()), std::abs(output[1] - expected[size / 2].real()));
+
+			for (int i = 1; i < size / 2; i++)
+				maxError = jmax(maxError, std::abs(std::complex<double>(output[2 * i], output[2 * i + 1]) - expected[i]));
+
+			expect(maxError < getTolerance(size), "Size " + String(size) + ", error: " + String(maxError));
+
+			fft.realFFTInverseInplace(output, size);
+
+			maxError = 0.0;
+
+			for (int i = 0; i < size; i++)
+				maxError = jmax(maxError, std::abs((double)output[i] / (double)size - (double)data[i]));
+
+			expect(maxError < 1e-5, "Roundtrip size " + String(size) + ", error: " + String(maxError));
+		}
+	}
+
+	void testSplitFFT()
+	{
+		beginTest("Testing split complex real FFT");
+
+		SimdFFT fft(SimdFFT::DataType::RealFloat, 11);
+
+		const int size = 1024;
+
+		HeapBlock<float> data(size);
+		HeapBlock<float> perm(size);
+		HeapBlock<float> re(size / 2 + 1);
+		HeapBlock<float> im(size / 2 + 1);
+		HeapBlock<float> output(size);
+
+		fillWithNoise(data, size);
+
+		fft.realFFT(data, perm, size);
+		fft.realFFTSplit(data, re, im, size);
+
+		expectEquals(re[0], perm[0], "DC");
+		expectEquals(re[size / 2], perm[1], "Nyquist");
+		expectEquals(im[0], 0.0f, "DC imaginary");
+		expectEquals(im[size / 2], 0.0f, "Nyquist imaginary");
+
+		for (int i = 1; i < size / 2; i++)
+		{
+			expectEquals(re[i], perm[2 * i]);
+			expectEquals(im[i], perm[2 * i + 1]);
+		}
+
+		fft.realFFTInverseSplit(re, im, output, size);
+
+		double maxError = 0.0;
+
+		for (int i = 0; i < size; i++)
+			maxError = jmax(maxError, std::abs((double)output[i] / (double)size - (double)data[i]));
+
+		expect(maxError < 1e-5, "Split roundtrip error: " + String(maxError));
+	}
+
+	void testScaling()
+	{
+		beginTest("Testing scaling flags");
+
+		SimdFFT fft(SimdFFT::DataType::RealFloat, 10, SimdFFT::DivideInverseByN);
+
+		const int size = 256;
+
+		HeapBlock<float> data(size);
+		HeapBlock<float> output(size);
+
+		fillWithNoise(data, size);
+
+		fft.realFFT(data, output, size);
+		fft.realFFTInverseInplace(output, size);
+
+		for (int i = 0; i < size; i++)
+			expectWithinAbsoluteError(output[i], data[i], 1e-5f);
+	}
+
+	template <typename F> static double measure(int numRuns, const F& f)
+	{
+		const auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numRuns; i++)
+			f();
+
+		return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000000000.0 / (double)numRuns;
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking against the Ooura FFT");
+
+		SimdFFT fft(SimdFFT::DataType::RealFloat);
+
+		for (int order = 6; order <= 14; order++)
+		{
+			const int size = 1 << order;
+			const int numRuns = (1 << 22) / size;
+
+			HeapBlock<float> input(size);
+			HeapBlock<float> data(size);
+
+			fillWithNoise(input, size);
+
+			auto oouraTime = measure(numRuns, [&]()
+			{
+				FloatVectorOperations::copy(data, input, size);
+				icstdsp::rdft(size, 1, data.get());
+			});
+
+			auto simdTime = measure(numRuns, [&]()
+			{
+				FloatVectorOperations::copy(data, input, size);
+				fft.realFFTInplace(data, size);
+			});
+
+			String s;
+
+			s << "Real FFT with " << String(size) << " samples: ";
+			s << "Ooura " << String(roundToInt(oouraTime)) << "ns, ";
+			s << "SIMD " << String(roundToInt(simdTime)) << "ns (" << String(oouraTime / simdTime, 2) << "x)";
+
+			logMessage(s);
+		}
+	}
+};
+
+static SimdFFTUnitTests simdFFTUnitTests;
+
+#endif
@@ -923,6 +923,9 @@ public:
 
 		testPadding(1);
         testPadding(2);
+
+		testMultithreadedEncoding(1);
+		testMultithreadedEncoding(2);
 	
 		for (int i = 0; i < 5; i++)
 		{
@@ -1033,7 +1036,7 @@ public:
 		return CodecTest::createTestSignal(size, numChannels, CodecTest::SignalType::DecayingSineWithHarmonic, 0.9f);
 	}
 
-	MemoryBlock writeIntoMemory(Array<AudioSampleBuffer>& buffers)
+	MemoryBlock writeIntoMemory(Array<AudioSampleBuffer>& buffers, int numThreads=1)
 	{
 		Random r;
 
@@ -1048,6 +1051,7 @@ public:
 		currentOption.normalisationMode = 2;
 
 		writer->setOptions(currentOption);
+		writer->setNumEncoderThreads(numThreads);
 		
 		expect(writer != nullptr);
 
@@ -1126,6 +1130,77 @@ public:
 		expectEquals<int>(error, 0, "Error after reading");
 	}
 
+	void testMultithreadedEncoding(int numChannels)
+	{
+		beginTest("Testing multithreaded encoding with " + String(numChannels) + " channels");
+
+		Array<AudioSampleBuffer> buffers;
+
+		// AudioSampleBuffers can't be moved by the reallocation of the array
+		buffers.ensureStorageAllocated(12);
+
+		for (int i = 0; i < 12; i++)
+			buffers.add(createTestBuffer(numChannels, 30000 + i * 1000));
+
+		auto serial = writeIntoMemory(buffers, 1);
+		auto parallel = writeIntoMemory(buffers, 4);
+
+		expectEquals<int>((int)parallel.getSize(), (int)serial.getSize(), "Size");
+
+		MemoryInputStream serialInput(serial, false);
+		MemoryInputStream parallelInput(parallel, false);
+
+		HiseLosslessHeader serialHeader(&serialInput);
+		HiseLosslessHeader parallelHeader(&parallelInput);
+
+		expectEquals<int>((int)parallelHeader.getBlockAmount(), (int)serialHeader.getBlockAmount(), "Block amount");
+
+		bool offsetsEqual = true;
+
+		for (uint32 i = 0; i < serialHeader.getBlockAmount(); i++)
+		{
+			const int64 pos = (int64)i * COMPRESSION_BLOCK_SIZE;
+			offsetsEqual &= serialHeader.getOffsetForReadPosition(pos, true) == parallelHeader.getOffsetForReadPosition(pos, true);
+		}
+
+		expect(offsetsEqual, "Block offsets");
+
+		// The checksums are random numbers, so the data may only differ inside valid checksums
+		auto s = static_cast<const uint8*>(serial.getData());
+		auto p = static_cast<const uint8*>(parallel.getData());
+
+		int numInvalidDifferences = 0;
+		const int numBytes = (int)jmin<size_t>(serial.getSize(), parallel.getSize());
+
+		for (int i = 0; i < numBytes; i++)
+		{
+			if (s[i] == p[i])
+				continue;
+
+			bool isInChecksum = false;
+
+			for (int w = jmax<int>(0, i - 3); w <= jmin<int>(i, numBytes - 4); w++)
+			{
+				uint32 c1, c2;
+
+				memcpy(&c1, s + w, sizeof(uint32));
+				memcpy(&c2, p + w, sizeof(uint32));
+
+				isInChecksum |= CompressionHelpers::Misc::validateChecksum(c1) && CompressionHelpers::Misc::validateChecksum(c2);
+			}
+
+			if (!isInChecksum)
+				++numInvalidDifferences;
+		}
+
+		expectEquals<int>(numInvalidDifferences, 0, "Data equal except checksums");
+
+		auto b1 = readIntoAudioBuffer(serial, true);
+		auto b2 = readIntoAudioBuffer(parallel, true);
+
+		expectEquals<int>((int)CompressionHelpers::checkBuffersEqual(b1, b2), 0, "Decoded data equal");
+	}
+
 	int randomizeChannelAmount()
 	{
 		Random r;
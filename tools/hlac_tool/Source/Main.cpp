@@ -38,6 +38,7 @@ void printHelp()
 	Logger::writeToLog("");
 	Logger::writeToLog("modes: 'encode' / 'decode'");
 	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory'");
+	Logger::writeToLog("benchmark: 'benchmark_decode' [INPUT] (uses a synthetic signal if no input file is specified)");
 	Logger::writeToLog("(put '_' before filename to skip samples)");
 	Logger::setCurrentLogger(nullptr);
 }
@@ -97,6 +98,137 @@ void testMemoryMapPerformance(Array<File>& files)
 	}
 }
 
+/** Creates a decaying stereo signal with a few harmonics and a bit of noise (roughly what a sampled instrument looks like). */
+AudioSampleBuffer createBenchmarkSignal(int numSamples)
+{
+	AudioSampleBuffer b(2, numSamples);
+
+	Random r(1234);
+
+	for (int c = 0; c < 2; c++)
+	{
+		auto d = b.getWritePointer(c);
+
+		double uptime = 0.0;
+		const double uptimeDelta = 2.0 * double_Pi * (220.0 + 0.5 * c) / 44100.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const float decay = std::exp(-3.0f * (float)i / (float)numSamples);
+
+			float v = 0.6f * (float)std::sin(uptime);
+			v += 0.2f * (float)std::sin(2.0 * uptime);
+			v += 0.1f * (float)std::sin(3.0 * uptime);
+			v *= decay;
+			v += 0.002f * (r.nextFloat() - 0.5f);
+
+			d[i] = v;
+			uptime += uptimeDelta;
+		}
+	}
+
+	return b;
+}
+
+/** Returns the time in milliseconds that the reader needs to read the whole file (the best of a few runs). */
+double measureReadTime(AudioFormat& format, const MemoryBlock& data, AudioSampleBuffer& destination, int numRuns)
+{
+	double bestTime = std::numeric_limits<double>::max();
+
+	for (int i = 0; i < numRuns; i++)
+	{
+		ScopedPointer<AudioFormatReader> reader = format.createReaderFor(new MemoryInputStream(data, false), true);
+
+		if (reader == nullptr)
+			return -1.0;
+
+		const int numSamples = jmin<int>(destination.getNumSamples(), (int)reader->lengthInSamples);
+
+		const double start = Time::getMillisecondCounterHiRes();
+		reader->read(&destination, 0, numSamples, 0, true, true);
+		const double stop = Time::getMillisecondCounterHiRes();
+
+		bestTime = jmin(bestTime, stop - start);
+	}
+
+	return bestTime;
+}
+
+/** Encodes the file (or a synthetic signal) and compares the decoding speed with reading the same data from a 16 bit WAV file. */
+int benchmarkDecoding(File input)
+{
+	AudioSampleBuffer b;
+
+	if (input.existsAsFile())
+	{
+		double unused;
+
+		try
+		{
+			b = CompressionHelpers::loadFile(input, unused);
+		}
+		catch (String error)
+		{
+			ABORT_WITH_MESSAGE(error);
+		}
+	}
+	else
+	{
+		b = createBenchmarkSignal(44100 * 60);
+	}
+
+	const int numRuns = 10;
+	const double lengthInSeconds = (double)b.getNumSamples() / 44100.0;
+
+	StringPairArray emptyMetadata;
+
+	MemoryBlock wavData;
+
+	{
+		WavAudioFormat wav;
+		ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(new MemoryOutputStream(wavData, false), 44100, b.getNumChannels(), 16, emptyMetadata, 0);
+		writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+	}
+
+	AudioSampleBuffer destination(b.getNumChannels(), CompressionHelpers::getPaddedSampleSize(b.getNumSamples()));
+
+	WavAudioFormat wav;
+	const double pcmTime = measureReadTime(wav, wavData, destination, numRuns);
+
+	Logger::writeToLog("Decoding " + String(lengthInSeconds, 1) + " seconds with " + String(b.getNumChannels()) + " channels (best of " + String(numRuns) + " runs)");
+	Logger::writeToLog("PCM (16 bit WAV):\t" + String(pcmTime, 2) + "ms\t" + String(lengthInSeconds * 1000.0 / pcmTime, 1) + "x realtime");
+
+	HiseLosslessAudioFormat hlac;
+
+	const HlacEncoder::CompressorOptions::Presets presets[2] = { HlacEncoder::CompressorOptions::Presets::Diff, HlacEncoder::CompressorOptions::Presets::WholeBlock };
+	const String names[2] = { "HLAC (Diff)", "HLAC (Block)" };
+
+	for (int i = 0; i < 2; i++)
+	{
+		MemoryBlock hlacData;
+
+		{
+			ScopedPointer<HiseLosslessAudioFormatWriter> writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(hlac.createWriterFor(new MemoryOutputStream(hlacData, false), 44100, b.getNumChannels(), 16, emptyMetadata, 5));
+			auto options = HlacEncoder::CompressorOptions::getPreset(presets[i]);
+			writer->setOptions(options);
+			writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+			writer->flush();
+		}
+
+		const double hlacTime = measureReadTime(hlac, hlacData, destination, numRuns);
+		const double ratio = (double)hlacData.getSize() / (double)wavData.getSize();
+
+		String s;
+		s << names[i] << ":\t" << String(hlacTime, 2) << "ms\t" << String(lengthInSeconds * 1000.0 / hlacTime, 1) << "x realtime, ";
+		s << String(100.0 * pcmTime / hlacTime, 1) << "% of PCM speed, ratio " << String(ratio, 3);
+
+		Logger::writeToLog(s);
+	}
+
+	Logger::setCurrentLogger(nullptr);
+	return 0;
+}
+
 int decode(File input, File output)
 {
 
@@ -214,6 +346,11 @@ int main(int argc, char **argv)
 
 	}
 
+	if (mode == "benchmark_decode")
+	{
+		return benchmarkDecoding(argc > 2 ? File(argv[2]) : File());
+	}
+
 	if (mode == "unit_test")
 	{
 		UnitTestRunner runner;